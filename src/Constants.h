@@ -12,9 +12,16 @@
 // ─── Display ─────────────────────────────────────────────────────────────────
 constexpr int   RENDER_W      = 1280;
 constexpr int   RENDER_H      = 720;
-constexpr int   TARGET_FPS    = 200;
+constexpr int   TARGET_FPS    = 90;    // best FramePacer rung; it drops to 72/60 when hot
 constexpr float ASPECT        = (float)RENDER_W / (float)RENDER_H;
 
+// ─── Simulation ──────────────────────────────────────────────────────────────
+// Gameplay runs in fixed ticks, decoupled from the render rate; a frame runs
+// as many as real time asks for, at most SIM_MAX_TICKS (the old 50 ms clamp).
+constexpr int   SIM_TICK_HZ   = 100;
+constexpr float SIM_DT        = 1.0f / SIM_TICK_HZ;
+constexpr int   SIM_MAX_TICKS = 5;
+
 // ─── Teams ───────────────────────────────────────────────────────────────────
 enum class Team : uint8_t { ATTACK = 0, DEFEND = 1, NONE = 2 };
 constexpr int TEAM_SIZE = 3;
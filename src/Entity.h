@@ -3,6 +3,7 @@
 //  Entity.h  –  All game entities as plain structs (no vtable overhead)
 // ─────────────────────────────────────────────────────────────────────────────
 #include "Constants.h"
+#include "SimMath.h"
 #include <array>
 #include <vector>
 #include <string>
@@ -51,8 +52,12 @@ struct Pawn {
     Vector3     velocity = {0,0,0};
     bool        onGround = false;
     bool        isCrouching = false;
+    float       strideDist  = 0.0f;   // ground covered since the last footstep
+    float       airTime     = 0.0f;   // seconds since the sweep last hit a floor
+    uint16_t    lastButtons = 0;      // previous PlayerCommand's, for press edges
 
     int         hp       = MAX_HP;
+    int         lastAttacker = -1;   // pawn id that last did damage, -1 = none
 
     WeaponState weapon;
     std::array<WeaponState, (int)WeaponID::COUNT> weaponSlots;
@@ -61,6 +66,7 @@ struct Pawn {
     int         fragCount   = 1;
     int         smokeCount  = 1;
     int         stunCount   = 1;
+    int         primedUtility = -1;   // UtilityID held ready to throw, -1 = none
 
     void saveActiveWeaponSlot() {
         // Reloads are intentionally interrupted on weapon switch.
@@ -98,9 +104,9 @@ struct Pawn {
 
     Vector3 lookDir() const {
         return {
-            cosf(xform.pitch) * sinf(xform.yaw),
-            sinf(xform.pitch),
-            cosf(xform.pitch) * cosf(xform.yaw)
+            SimCos(xform.pitch) * SimSin(xform.yaw),
+            SimSin(xform.pitch),
+            SimCos(xform.pitch) * SimCos(xform.yaw)
         };
     }
 
@@ -111,13 +117,13 @@ struct Pawn {
         float ofsZ = 0.7f; // Center is 0.5, plus half a 0.4 box = 0.7
 
         // Apply pitch (around local X axis)
-        float yp = ofsY * cosf(xform.pitch) + ofsZ * sinf(xform.pitch);
-        float zp = -ofsY * sinf(xform.pitch) + ofsZ * cosf(xform.pitch);
+        float yp = ofsY * SimCos(xform.pitch) + ofsZ * SimSin(xform.pitch);
+        float zp = -ofsY * SimSin(xform.pitch) + ofsZ * SimCos(xform.pitch);
         float xp = ofsX;
 
         // Apply yaw (around global Y axis)
-        float xW = xp * cosf(xform.yaw) + zp * sinf(xform.yaw);
-        float zW = -xp * sinf(xform.yaw) + zp * cosf(xform.yaw);
+        float xW = xp * SimCos(xform.yaw) + zp * SimSin(xform.yaw);
+        float zW = -xp * SimSin(xform.yaw) + zp * SimCos(xform.yaw);
         float yW = yp;
 
         Vector3 eye = eyePos();
@@ -133,6 +139,7 @@ struct BulletTracer {
     Vector3 end;
     float   lifeSec = 0.06f;   // fades quickly
     Color   col     = {255,240,180,255};
+    int8_t  shooter = -1;      // pawn index
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -163,6 +170,7 @@ struct SmokeZone {
     Vector3 pos;
     float   radius   = SMOKE_RADIUS;
     float   lifeLeft = SMOKE_DURATION_SEC;
+    int     gridSlot = -1;   // SmokeGrid slot holding its voxels
 };
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -204,3 +212,60 @@ struct MapSolid {
     Color        col;
     bool         isFloor = false;
 };
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  What the renderer draws for a pawn: the simulated Pawn when local, an
+//  interpolated remote state when networked (PawnInterpolator)
+// ─────────────────────────────────────────────────────────────────────────────
+constexpr float POSE_SNAP_DIST = 1.0f;   // metres in one tick that count as a teleport
+
+struct PawnPose {
+    bool    visible = false;
+    Team    team    = Team::NONE;
+    Vector3 pos     = {};
+    float   yaw     = 0.0f;
+    float   pitch   = 0.0f;
+    bool    crouch  = false;
+
+    float height() const { return crouch ? PLAYER_CROUCH_HEIGHT : PLAYER_HEIGHT; }
+
+    static PawnPose Of(const Pawn& p) {
+        return { p.alive, p.team, p.xform.pos, p.xform.yaw, p.xform.pitch, p.isCrouching };
+    }
+
+    // Part way from one tick's pose to the next; deaths and respawns snap.
+    static PawnPose Lerp(const PawnPose& a, const PawnPose& b, float t) {
+        if(a.visible != b.visible ||
+           Vector3DistanceSqr(a.pos, b.pos) > POSE_SNAP_DIST * POSE_SNAP_DIST) return b;
+        PawnPose p = b;
+        p.pos   = Vector3Lerp(a.pos, b.pos, t);
+        p.yaw   = a.yaw + remainderf(b.yaw - a.yaw, 2.0f * PI) * t;
+        p.pitch = Lerp1(a.pitch, b.pitch, t);
+        return p;
+    }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Bot brain (FSM state per bot, updated by BotAI)
+// ─────────────────────────────────────────────────────────────────────────────
+enum class BotFSMState : uint8_t {
+    PATROL,
+    ENGAGE,
+    SEARCH,
+    RETREAT
+};
+
+struct BotBrain {
+    BotFSMState state       = BotFSMState::PATROL;
+    int         waypointIdx = 0;     // current patrol target
+    int         targetID    = -1;    // pawn being engaged
+    Vector3     lastKnown   = {};    // last seen enemy position
+    float       visionTimer = 0.0f;  // countdown to next raycast check
+    float       reactionTimer = 0.0f;// delay before shooting
+    float       retreatTimer = 0.0f; // max time to stay in retreat
+    float       lostSightTimer = 0.0f;
+    float       strafeTimer = 0.0f;  // stagger direction change
+    float       strafeSign  = 1.0f;
+    bool        hasSightLine= false;
+    uint32_t    noiseCursor = 0;     // World::noises already heard
+};
@@ -0,0 +1,24 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  Hash.h  –  64-bit FNV-1a over explicit fields
+//
+//  Callers feed fields one at a time, never whole structs, so padding bytes
+//  and pointers never reach the hash.  Floats are hashed by bit pattern.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <raylib.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+struct Fnv1a {
+    uint64_t value = 0xcbf29ce484222325ull;
+
+    void Bytes(const void* data, size_t size) {
+        const uint8_t* p = (const uint8_t*)data;
+        for(size_t i = 0; i < size; i++) value = (value ^ p[i]) * 0x100000001b3ull;
+    }
+    void U8(uint8_t v)   { Bytes(&v, 1); }
+    void U32(uint32_t v) { Bytes(&v, 4); }
+    void F32(float v)    { uint32_t u; memcpy(&u, &v, 4); U32(u); }
+    void Vec(Vector3 v)  { F32(v.x); F32(v.y); F32(v.z); }
+};
@@ -0,0 +1,66 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  IniFile.h  –  Minimal "[section] key = value" reader
+//
+//  Keys are looked up as "section.key".  ';' and '#' start comment lines;
+//  whitespace around keys and values is trimmed.  No quoting, escapes or
+//  multi-line values.  Writers just fprintf the same shape.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+struct IniFile {
+    std::unordered_map<std::string, std::string> values;
+
+    bool Load(const std::string& path) {
+        values.clear();
+        std::ifstream in(path);
+        if(!in) return false;
+        std::string line, section;
+        while(std::getline(in, line)) {
+            line = Trim(line);
+            if(line.empty() || line[0] == ';' || line[0] == '#') continue;
+            if(line[0] == '[') {
+                size_t close = line.find(']');
+                section = Trim(line.substr(1, close == std::string::npos ? std::string::npos : close - 1));
+                continue;
+            }
+            size_t eq = line.find('=');
+            if(eq == std::string::npos) continue;
+            std::string key = Trim(line.substr(0, eq));
+            values[section.empty() ? key : section + "." + key] = Trim(line.substr(eq + 1));
+        }
+        return true;
+    }
+
+    bool Has(const std::string& key) const { return values.count(key) != 0; }
+
+    std::string Get(const std::string& key, const std::string& def = "") const {
+        auto it = values.find(key);
+        return it == values.end() ? def : it->second;
+    }
+    float GetFloat(const std::string& key, float def) const {
+        auto it = values.find(key);
+        if(it == values.end()) return def;
+        char* end = nullptr;
+        float v = strtof(it->second.c_str(), &end);
+        return end == it->second.c_str() ? def : v;
+    }
+    int GetInt(const std::string& key, int def) const {
+        auto it = values.find(key);
+        if(it == values.end()) return def;
+        char* end = nullptr;
+        long v = strtol(it->second.c_str(), &end, 10);
+        return end == it->second.c_str() ? def : (int)v;
+    }
+    bool GetBool(const std::string& key, bool def) const { return GetInt(key, def ? 1 : 0) != 0; }
+
+    static std::string Trim(const std::string& s) {
+        size_t b = s.find_first_not_of(" \t\r\n");
+        if(b == std::string::npos) return "";
+        size_t e = s.find_last_not_of(" \t\r\n");
+        return s.substr(b, e - b + 1);
+    }
+};
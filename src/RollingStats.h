@@ -0,0 +1,40 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  RollingStats.h  –  Percentiles over the last N samples
+//
+//  A fixed ring; Percentile copies and partially sorts it, so ask once per
+//  overlay refresh, not per sample.  N stays small (a few hundred).
+// ─────────────────────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+template<int N>
+class RollingStats {
+public:
+    void Add(float v) {
+        items[head] = v;
+        head = (head + 1) % N;
+        if(count < N) count++;
+    }
+
+    int   Count() const { return count; }
+    float Last()  const { return count ? items[(head + N - 1) % N] : 0.0f; }
+
+    // p in [0, 1]; 0 when empty.
+    float Percentile(float p) const {
+        if(count == 0) return 0.0f;
+        std::array<float, N> tmp;
+        std::copy(items.begin(), items.begin() + count, tmp.begin());
+        int k = std::clamp((int)lroundf(p * (count - 1)), 0, count - 1);
+        std::nth_element(tmp.begin(), tmp.begin() + k, tmp.begin() + count);
+        return tmp[k];
+    }
+
+    void Clear() { head = count = 0; }
+
+private:
+    std::array<float, N> items{};
+    int head  = 0;
+    int count = 0;
+};
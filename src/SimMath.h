@@ -0,0 +1,95 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  SimMath.h  –  sin / cos / atan2 that give the same bits on every platform
+//
+//  Lockstep peers must step bit-identical Worlds, but libm's sinf, cosf and
+//  atan2f differ in the last bit between glibc versions, between x86 and
+//  ARM, and from Apple's and Microsoft's libraries.  These use only + - * /,
+//  floorf and float compares, which IEEE 754 pins down exactly once fused
+//  multiply-add contraction is off (CMake passes -ffp-contract=off).
+//  Simulation code (movement, aim, spread, bot steering) calls these;
+//  rendering and audio keep libm.
+//
+//  sin/cos: reduce by pi/2 in three float parts (Cody-Waite), then Cephes
+//  minimax polynomials on [-pi/4, pi/4].  Within 2 ulp of sinf/cosf for
+//  |x| < 8192, which covers every angle the simulation makes.  atan2: the
+//  Cephes atanf reduction and polynomial, within 3 ulp of atan2f.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cmath>
+
+namespace simmath {
+
+constexpr float PIO2_1   = 1.5703125f;                   // pi/2 split so k * part is exact
+constexpr float PIO2_2   = 4.837512969970703125e-4f;
+constexpr float PIO2_3   = 7.54978995489188216e-8f;
+constexpr float TWO_O_PI = 0.636619772367581343f;
+constexpr float PI_F     = 3.14159265358979323846f;
+constexpr float PIO2_F   = 1.57079632679489661923f;
+constexpr float PIO4_F   = 0.785398163397448309616f;
+
+// x = k * pi/2 + r, |r| <= pi/4
+inline float Reduce(float x, int& k) {
+    float fk = floorf(x * TWO_O_PI + 0.5f);
+    k = (int)fk;
+    return ((x - fk * PIO2_1) - fk * PIO2_2) - fk * PIO2_3;
+}
+
+inline float SinPoly(float r) {
+    float z = r * r;
+    return r + r * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+}
+
+inline float CosPoly(float r) {
+    float z = r * r;
+    return 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+}
+
+// atan on [0, inf)
+inline float AtanPos(float x) {
+    float base = 0.0f;
+    if(x > 2.414213562373095f) {           // tan(3pi/8)
+        base = PIO2_F;
+        x    = -1.0f / x;
+    } else if(x > 0.4142135623730950f) {   // tan(pi/8)
+        base = PIO4_F;
+        x    = (x - 1.0f) / (x + 1.0f);
+    }
+    float z = x * x;
+    return base + ((((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z
+                    - 3.33329491539e-1f) * z * x + x);
+}
+
+} // namespace simmath
+
+inline float SimSin(float x) {
+    int   k;
+    float r = simmath::Reduce(x, k);
+    switch(k & 3) {
+        case 0:  return  simmath::SinPoly(r);
+        case 1:  return  simmath::CosPoly(r);
+        case 2:  return -simmath::SinPoly(r);
+        default: return -simmath::CosPoly(r);
+    }
+}
+
+inline float SimCos(float x) {
+    int   k;
+    float r = simmath::Reduce(x, k);
+    switch(k & 3) {
+        case 0:  return  simmath::CosPoly(r);
+        case 1:  return -simmath::SinPoly(r);
+        case 2:  return -simmath::CosPoly(r);
+        default: return  simmath::SinPoly(r);
+    }
+}
+
+inline float SimAtan2(float y, float x) {
+    if(x == 0.0f) {
+        if(y > 0.0f) return  simmath::PIO2_F;
+        if(y < 0.0f) return -simmath::PIO2_F;
+        return 0.0f;
+    }
+    float a = simmath::AtanPos(fabsf(y / x));
+    if(x < 0.0f) a = simmath::PI_F - a;
+    return (y < 0.0f) ? -a : a;
+}
@@ -0,0 +1,35 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  SimRandom.h  –  The simulation's own random stream (PCG32)
+//
+//  Every random draw a tick makes (spread, bot aim noise, patrol choices)
+//  comes from World::rng rather than rand(), so matches sharing a process
+//  never share a sequence and a seed repeats a match's draws exactly.
+//  Not for anything outside the simulation.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <cstdint>
+
+struct SimRandom {
+    uint64_t state = 0x853C49E6748FEA9Bull;
+
+    void Seed(uint64_t seed) {
+        state = 0;
+        Next();
+        state += seed;
+        Next();
+    }
+
+    uint32_t Next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ull + 1442695040888963407ull;
+        uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = (uint32_t)(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    // [0, 1)
+    float Float() { return (Next() >> 8) * (1.0f / 16777216.0f); }
+
+    // [0, n); n > 0
+    int Below(int n) { return (int)(((uint64_t)Next() * (uint32_t)n) >> 32); }
+};
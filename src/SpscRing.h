@@ -0,0 +1,50 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  SpscRing.h  –  Bounded lock-free single-producer / single-consumer queue
+//
+//  One thread pushes, one other thread pops; neither ever blocks.  A full
+//  ring rejects the push and the producer decides what to drop.  Head and
+//  tail sit on separate cache lines so the two sides don't false-share, and
+//  each side keeps a private copy of the other's index, re-reading the
+//  shared atomic only when the copy says "full" / "empty".
+// ─────────────────────────────────────────────────────────────────────────────
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+template<class T, uint32_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+    // ── Producer thread only ─────────────────────────────────────────────────
+    bool TryPush(const T& v) {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        if(h - tailCache == N) {
+            tailCache = tail.load(std::memory_order_acquire);
+            if(h - tailCache == N) return false;
+        }
+        items[h & (N - 1)] = v;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ── Consumer thread only ─────────────────────────────────────────────────
+    bool TryPop(T& out) {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        if(t == headCache) {
+            headCache = head.load(std::memory_order_acquire);
+            if(t == headCache) return false;
+        }
+        out = items[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> head{ 0 };   // written by producer
+    uint32_t                          tailCache = 0;
+    alignas(64) std::atomic<uint32_t> tail{ 0 };   // written by consumer
+    uint32_t                          headCache = 0;
+    alignas(64) std::array<T, N>      items{};
+};
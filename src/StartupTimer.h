@@ -0,0 +1,60 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  StartupTimer.h  –  Where the time to the menu and the first match goes
+//
+//  Phase() closes a serial step on the main thread and records its length;
+//  Milestone() records, once, when something finished counting from start
+//  (work on other threads, first frames).  Report() prints everything as
+//  one "STARTUP key=ms ..." line for CI to grep.  The clock starts with
+//  main(), so exec, dynamic linking and static init are not counted.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <raylib.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+constexpr int STARTUP_MAX_ENTRIES = 16;
+
+class StartupTimer {
+public:
+    StartupTimer() : start(Clock::now()), last(start) {}
+
+    double ElapsedMs() const { return Ms(start, Clock::now()); }
+
+    void Phase(const char* name) {
+        Clock::time_point now = Clock::now();
+        Add(name, Ms(last, now));
+        last = now;
+    }
+
+    // True the first time name is seen.
+    bool Milestone(const char* name) {
+        for(int i = 0; i < count; i++)
+            if(!strcmp(entries[i].name, name)) return false;
+        Add(name, ElapsedMs());
+        return true;
+    }
+
+    void Report() const {
+        char line[768];
+        int  n = snprintf(line, sizeof(line), "STARTUP");
+        for(int i = 0; i < count && n < (int)sizeof(line); i++)
+            n += snprintf(line + n, sizeof(line) - n, " %s=%.1f", entries[i].name, entries[i].ms);
+        TraceLog(LOG_INFO, "%s", line);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Entry { const char* name; double ms; };
+
+    Clock::time_point start, last;
+    Entry entries[STARTUP_MAX_ENTRIES] = {};
+    int   count = 0;
+
+    void Add(const char* name, double ms) {
+        if(count < STARTUP_MAX_ENTRIES) entries[count++] = { name, ms };
+    }
+    static double Ms(Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    }
+};
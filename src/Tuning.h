@@ -0,0 +1,135 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  Tuning.h  –  Gameplay numbers that can be changed without a rebuild
+//
+//  A subset of Constants.h (movement, camera, bots, utility) is copied into
+//  one POD TuningValues.  Gameplay code reads fields through Tune(), which
+//  is a plain struct access, and never looks anything up by name.
+//  LoadTuning() fills the struct from TUNING_FILE at startup and again when
+//  F5 is pressed.  Keys that are missing keep their Constants.h default, and
+//  values are clamped to each field's range.
+//
+//  Builds with TUNING_FROZEN=1 (CMake: -DTACTICAL_FREEZE_TUNING=ON) make
+//  Tuning a constexpr copy of the defaults and ignore the file, so the
+//  compiler folds every read back into a constant.
+//
+//  Change values between matches: a command log recorded under one tuning
+//  replays differently under another.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "Constants.h"
+#include "IniFile.h"
+#include <raylib.h>
+#include <algorithm>
+
+constexpr const char* TUNING_FILE = "assets/tuning.ini";
+
+struct TuningValues {
+    // [movement]
+    float playerSpeed, gravity, jumpVelocity, mouseSensitivity;
+    float groundFriction, groundAccel, airAccel, airControlRatio;
+    // [camera]
+    float camFov;
+    // [bots]
+    float botVisionRange, botVisionDot, botReactionMs, botRaycastHz;
+    float botAimNoiseRad, botSpeed, botWaypointReach;
+    // [utility]
+    float fragRadius, fragDamage, fragFuseSec;
+    float smokeDurationSec, smokeRadius, stunDurationSec;
+};
+
+constexpr TuningValues TUNING_DEFAULTS = {
+    PLAYER_SPEED, GRAVITY, JUMP_VELOCITY, MOUSE_SENSITIVITY,
+    GROUND_FRICTION, GROUND_ACCEL, AIR_ACCEL, AIR_CONTROL_RATIO,
+    CAM_FOV,
+    BOT_VISION_RANGE, BOT_VISION_DOT, BOT_REACTION_MS, BOT_RAYCAST_HZ,
+    BOT_AIM_NOISE_RAD, BOT_SPEED, BOT_WAYPOINT_REACH,
+    FRAG_RADIUS, FRAG_DAMAGE, FRAG_FUSE_SEC,
+    SMOKE_DURATION_SEC, SMOKE_RADIUS, STUN_DURATION_SEC,
+};
+
+// ─── Name table (load time only) ────────────────────────────────────────────
+struct TuningField {
+    const char*         key;        // "section.key" in the INI
+    float TuningValues::* member;
+    float               min, max;
+};
+
+constexpr TuningField TUNING_FIELDS[] = {
+    { "movement.player_speed",       &TuningValues::playerSpeed,      0.5f,   20.0f },
+    { "movement.gravity",            &TuningValues::gravity,        -80.0f,   -1.0f },
+    { "movement.jump_velocity",      &TuningValues::jumpVelocity,     0.0f,   30.0f },
+    { "movement.mouse_sensitivity",  &TuningValues::mouseSensitivity, 0.0001f, 0.05f },
+    { "movement.ground_friction",    &TuningValues::groundFriction,   0.0f,   30.0f },
+    { "movement.ground_accel",       &TuningValues::groundAccel,      0.1f,   50.0f },
+    { "movement.air_accel",          &TuningValues::airAccel,         0.0f,   50.0f },
+    { "movement.air_control_ratio",  &TuningValues::airControlRatio,  0.0f,    1.0f },
+    { "camera.fov",                  &TuningValues::camFov,          40.0f,  120.0f },
+    // Streamed maps keep BOT_VISION_RANGE of geometry loaded, so no further
+    { "bots.vision_range",           &TuningValues::botVisionRange,   1.0f, BOT_VISION_RANGE },
+    { "bots.vision_dot",             &TuningValues::botVisionDot,    -1.0f,    1.0f },
+    { "bots.reaction_ms",            &TuningValues::botReactionMs,    0.0f, 2000.0f },
+    { "bots.raycast_hz",             &TuningValues::botRaycastHz,     1.0f,  100.0f },
+    { "bots.aim_noise_rad",          &TuningValues::botAimNoiseRad,   0.0f,    0.5f },
+    { "bots.speed",                  &TuningValues::botSpeed,         0.1f,   20.0f },
+    { "bots.waypoint_reach",         &TuningValues::botWaypointReach, 0.1f,    5.0f },
+    { "utility.frag_radius",         &TuningValues::fragRadius,       0.5f,   15.0f },
+    { "utility.frag_damage",         &TuningValues::fragDamage,       0.0f,  500.0f },
+    { "utility.frag_fuse_sec",       &TuningValues::fragFuseSec,      0.1f,   10.0f },
+    { "utility.smoke_duration_sec",  &TuningValues::smokeDurationSec, 0.5f,   60.0f },
+    { "utility.smoke_radius",        &TuningValues::smokeRadius,      0.5f,    8.0f },
+    { "utility.stun_duration_sec",   &TuningValues::stunDurationSec,  0.1f,   10.0f },
+};
+
+// ─── Storage: live struct or compile-time constant ──────────────────────────
+template<bool Frozen> struct TuningStore;
+
+template<> struct TuningStore<false> {
+    static constexpr bool frozen = false;
+    static inline TuningValues values = TUNING_DEFAULTS;
+};
+
+template<> struct TuningStore<true> {
+    static constexpr bool frozen = true;
+    static constexpr TuningValues values = TUNING_DEFAULTS;
+};
+
+#if defined(TUNING_FROZEN) && TUNING_FROZEN
+using Tuning = TuningStore<true>;
+#else
+using Tuning = TuningStore<false>;
+#endif
+
+inline const TuningValues& Tune() { return Tuning::values; }
+
+// ─── Loading ────────────────────────────────────────────────────────────────
+// Returns how many values changed; -1 if the file could not be read.
+template<bool Frozen = Tuning::frozen>
+int LoadTuning(const char* path) {
+    if constexpr(Frozen) {
+        TraceLog(LOG_INFO, "Tuning: frozen at build time, %s ignored", path);
+        return 0;
+    } else {
+        IniFile ini;
+        if(!ini.Load(path)) {
+            TraceLog(LOG_WARNING, "Tuning: cannot read %s, keeping current values", path);
+            return -1;
+        }
+        for(const auto& kv : ini.values) {
+            bool known = false;
+            for(const TuningField& f : TUNING_FIELDS) known |= kv.first == f.key;
+            if(!known) TraceLog(LOG_WARNING, "Tuning: unknown key %s", kv.first.c_str());
+        }
+        TuningValues next = TUNING_DEFAULTS;   // a deleted line goes back to the default
+        int changed = 0;
+        for(const TuningField& f : TUNING_FIELDS) {
+            float v = std::clamp(ini.GetFloat(f.key, next.*f.member), f.min, f.max);
+            next.*f.member = v;
+            if(v != TuningStore<false>::values.*f.member) {
+                TraceLog(LOG_INFO, "Tuning: %s %g -> %g", f.key, TuningStore<false>::values.*f.member, v);
+                changed++;
+            }
+        }
+        TuningStore<false>::values = next;
+        return changed;
+    }
+}
@@ -4,6 +4,10 @@
 //  No heap allocations in the hot path; sizes are bounded at compile-time.
 // ─────────────────────────────────────────────────────────────────────────────
 #include "Entity.h"
+#include "SimRandom.h"
+#include "audio/SoundEvents.h"
+#include "game/SolidGrid.h"
+#include "utility/SmokeGrid.h"
 #include <array>
 #include <vector>
 
@@ -16,6 +20,8 @@ constexpr int MAX_IMPACTS   = 128;
 constexpr int MAX_SOLIDS    = 256;
 constexpr int MAX_WAYPOINTS = 64;
 
+static_assert(MAX_SMOKES <= SMOKE_GRID_SLOTS, "SmokeGrid has one slot per smoke");
+
 enum class RoundState : uint8_t {
     WAITING,     // pre-round freeze
     ACTIVE,
@@ -26,18 +32,28 @@ enum class RoundState : uint8_t {
 struct World {
     // ── Pawns ────────────────────────────────────────────────────────────────
     std::array<Pawn, MAX_PAWNS>          pawns;
-    int                                  playerID = 0;  // index of human pawn
+    int                                  playerID = 0;  // index of the local (viewed) pawn
+    uint8_t                              humanSeats = 1;  // bit per pawn run by commands, not BotAI
+    std::array<BotBrain, MAX_PAWNS>      brains;        // index matches pawns
 
     // ── Map geometry ─────────────────────────────────────────────────────────
     std::vector<MapSolid>                solids;        // AABB list
+    SolidGrid                            solidGrid;     // spatial index over solids
+    uint32_t                             geometryVersion = 0; // bumped on solids rebuild
     std::vector<Waypoint>                waypoints;
     ObjectiveZone                        objective;
 
     // ── Dynamic entities ─────────────────────────────────────────────────────
     std::vector<GrenadeEntity>           grenades;
     std::vector<SmokeZone>               smokes;
+    SmokeGrid                            smokeGrid;     // voxelised smokes for LOS
     std::vector<BulletTracer>            tracers;
     std::vector<ImpactDecal>             impacts;
+    int                                  maxTracers = MAX_TRACERS;   // quality preset caps
+    int                                  maxImpacts = MAX_IMPACTS;
+    SoundEventRing                       soundEvents;   // drained by AudioSystem
+    NoiseRing                            noises;        // pawn sounds bots can hear
+    SimRandom                            rng;           // every random draw a tick makes
 
     // ── Screen effects ────────────────────────────────────────────────────────
     StunState                            stun;
@@ -62,6 +78,14 @@ struct World {
         return false;
     }
 
+    // Raise a sound for the mixer; pawn-made ones are also left for bots to hear.
+    void EmitSound(SoundID id, Vector3 pos, int source = -1) {
+        soundEvents.Push(id, pos, source);
+        float range = HearingRange(id);
+        if(source >= 0 && range > 0.0f)
+            noises.Push({ pos, (int8_t)source, pawns[source].team, range });
+    }
+
     int aliveCount(Team t) const {
         int n = 0;
         for(auto& p : pawns) if(p.team == t && p.alive) n++;
@@ -4,41 +4,24 @@
 //
 //  States:
 //    PATROL   – walk along waypoint path, vision-check every 100ms
+//               and listen for enemy steps / shots (no rays: see HearNoise)
 //    ENGAGE   – face target, move to cover, shoot when LOS is clear
 //    SEARCH   – move to last known position after losing sight
 //    RETREAT  – if HP < 25 and ally alive, fall back to spawn
+//
+//  Bots drive their pawns like the player does: each tick the FSM fills a
+//  PlayerCommand (view, analog move, trigger) and ApplyPlayerCommand runs it.
 // ─────────────────────────────────────────────────────────────────────────────
 #include "../World.h"
+#include "../game/InputSystem.h"
 #include "../game/Physics.h"
 #include "../weapons/WeaponSystem.h"
+#include "../Tuning.h"
 #include <raymath.h>
 #include <cmath>
-#include <cstdlib>
 #include <algorithm>
 
-enum class BotFSMState : uint8_t {
-    PATROL,
-    ENGAGE,
-    SEARCH,
-    RETREAT
-};
-
-struct BotBrain {
-    BotFSMState state       = BotFSMState::PATROL;
-    int         waypointIdx = 0;     // current patrol target
-    int         targetID    = -1;    // pawn being engaged
-    Vector3     lastKnown   = {};    // last seen enemy position
-    float       visionTimer = 0.0f;  // countdown to next raycast check
-    float       reactionTimer = 0.0f;// delay before shooting
-    float       retreatTimer = 0.0f; // max time to stay in retreat
-    float       lostSightTimer = 0.0f;
-    float       strafeTimer = 0.0f;  // stagger direction change
-    float       strafeSign  = 1.0f;
-    bool        hasSightLine= false;
-};
-
-// One BotBrain per bot; index matches World::pawns index
-static BotBrain s_brains[MAX_PAWNS];
+// BotBrain lives in World::brains, one per pawn index (see Entity.h)
 
 static bool HasLineOfSightToTarget(const Pawn& bot, const Pawn& target, const World& world) {
     Vector3 eye = bot.eyePos();
@@ -54,7 +37,7 @@ static bool HasLineOfSightToTarget(const Pawn& bot, const Pawn& target, const Wo
     Vector3 dir = Vector3Scale(toTarget, 1.0f / dist);
     HitResult hr = RaycastSolids(eye, dir, dist, world.solids);
     if(hr.hit && hr.distance < dist - 0.15f) return false;
-    if(RayBlockedBySmoke(eye, targetPos, world.smokes)) return false;
+    if(RayBlockedBySmoke(eye, targetPos, world.smokeGrid)) return false;
     return true;
 }
 
@@ -63,7 +46,7 @@ static int FindVisibleEnemy(int botID, const World& world) {
     const Pawn& bot = world.pawns[botID];
     Vector3     eye = bot.eyePos();
 
-    float bestDist = BOT_VISION_RANGE * BOT_VISION_RANGE;
+    float bestDist = Tune().botVisionRange * Tune().botVisionRange;
     int   bestID   = -1;
 
     for(int i = 0; i < MAX_PAWNS; i++) {
@@ -80,7 +63,7 @@ static int FindVisibleEnemy(int botID, const World& world) {
         // FOV check
         Vector3 eyeDir = bot.lookDir();
         float   dot    = Vector3DotProduct(Vector3Normalize(toEnemy), eyeDir);
-        if(dot < BOT_VISION_DOT - 0.3f) continue;  // bots have slightly wider awareness
+        if(dot < Tune().botVisionDot - 0.3f) continue;  // bots have slightly wider awareness
 
         // Geometry occlusion
         HitResult hr = RaycastSolids(eye, Vector3Normalize(toEnemy),
@@ -89,7 +72,7 @@ static int FindVisibleEnemy(int botID, const World& world) {
 
         // Smoke occlusion
         Vector3 enemyPos = Vector3Add(p.xform.pos, {0, PLAYER_HEIGHT*0.5f, 0});
-        if(RayBlockedBySmoke(eye, enemyPos, world.smokes)) continue;
+        if(RayBlockedBySmoke(eye, enemyPos, world.smokeGrid)) continue;
 
         bestDist = d2;
         bestID   = i;
@@ -97,51 +80,67 @@ static int FindVisibleEnemy(int botID, const World& world) {
     return bestID;
 }
 
-// ─── Move bot towards a world position ────────────────────────────────────────
-static void MoveBotToward(Pawn& bot, Vector3 target, float dt,
-                          const std::vector<MapSolid>& solids,
-                          float strafeSign = 0.0f) {
+// ─── Nearest enemy noise since the last call (distance checks only) ─────────
+static bool HearNoise(int botID, BotBrain& brain, const World& world, Vector3& heardAt) {
+    const Pawn& bot = world.pawns[botID];
+    float best = -1.0f;
+    world.noises.ForEachSince(brain.noiseCursor, [&](const NoiseEvent& n) {
+        if(n.team == bot.team || n.source == botID) return;
+        float d2 = Vector3LengthSqr(Vector3Subtract(n.pos, bot.xform.pos));
+        if(d2 > n.range * n.range || (best >= 0.0f && d2 >= best)) return;
+        best    = d2;
+        heardAt = n.pos;
+    });
+    return best >= 0.0f;
+}
+
+// ─── Steer toward a world position ────────────────────────────────────────────
+// Writes the move into cmd relative to cmd's view; with face, the bot also
+// turns to look where it walks.
+// Analog stick depth that walks a bot at bots.speed
+inline float BotMoveScale() { return Tune().botSpeed / Tune().playerSpeed; }
+
+static void MoveBotToward(const Pawn& bot, Vector3 target, PlayerCommand& cmd,
+                          float strafeSign = 0.0f, bool face = true) {
     Vector3 toTarget = Vector3Subtract(target, bot.xform.pos);
     toTarget.y = 0;
     float dist = Vector3Length(toTarget);
     if(dist < 0.05f) return;
 
-    Vector3 forward = Vector3Scale(Vector3Normalize(toTarget), 1.0f);
+    Vector3 forward = Vector3Scale(toTarget, 1.0f / dist);
 
     // Optional strafe perpendicular
     Vector3 right   = { forward.z, 0, -forward.x };
     Vector3 move    = Vector3Add(forward, Vector3Scale(right, strafeSign * 0.3f));
     move = Vector3Normalize(move);
 
-    bot.velocity.x = move.x * BOT_SPEED;
-    bot.velocity.z = move.z * BOT_SPEED;
-    bot.velocity.y += GRAVITY * dt; if(bot.velocity.y < -50.0f) bot.velocity.y = -50.0f;
-
-
-    bool onGnd = false;
-    bot.xform.pos = SweepAABB(bot.xform.pos, bot.velocity, dt, onGnd, solids, bot.height());
-    if(onGnd && bot.velocity.y <= 0.0f) { bot.velocity.y = 0.0f; bot.onGround = true; } else if(!onGnd) { bot.onGround = false; }
-
     // Face movement direction
-    bot.xform.yaw = atan2f(toTarget.x, toTarget.z);
+    if(face) cmd.yaw = QuantizeYaw(SimAtan2(toTarget.x, toTarget.z));
+
+    float   yaw     = DequantizeYaw(cmd.yaw);
+    Vector3 viewFwd = { SimSin(yaw), 0, SimCos(yaw) };
+    Vector3 viewRt  = { viewFwd.z, 0, -viewFwd.x };
+    cmd.forward = QuantizeMove(Vector3DotProduct(move, viewFwd) * BotMoveScale());
+    cmd.side    = QuantizeMove(Vector3DotProduct(move, viewRt)  * BotMoveScale());
 }
 
 // ─── Aim bot at enemy with noise ──────────────────────────────────────────────
-static void AimAtTarget(Pawn& bot, Vector3 targetPos) {
+static void AimAtTarget(const Pawn& bot, Vector3 targetPos, PlayerCommand& cmd,
+                        SimRandom& rng) {
     Vector3 eye   = bot.eyePos();
     Vector3 delta = Vector3Subtract(targetPos, eye);
     float   dist  = Vector3Length(delta);
     if(dist < 0.01f) return;
 
     // Add per-frame noise
-    float noiseX = ((float)rand()/RAND_MAX - 0.5f) * BOT_AIM_NOISE_RAD * 2.0f;
-    float noiseY = ((float)rand()/RAND_MAX - 0.5f) * BOT_AIM_NOISE_RAD;
+    float noiseX = (rng.Float() - 0.5f) * Tune().botAimNoiseRad * 2.0f;
+    float noiseY = (rng.Float() - 0.5f) * Tune().botAimNoiseRad;
     delta.x += noiseX * dist;
     delta.y += noiseY * dist;
 
-    bot.xform.yaw   = atan2f(delta.x, delta.z);
-    bot.xform.pitch = atan2f(delta.y, sqrtf(delta.x*delta.x + delta.z*delta.z));
-    bot.xform.pitch = std::clamp(bot.xform.pitch, -1.3f, 1.3f);
+    float pitch = SimAtan2(delta.y, sqrtf(delta.x*delta.x + delta.z*delta.z));
+    cmd.yaw   = QuantizeYaw(SimAtan2(delta.x, delta.z));
+    cmd.pitch = QuantizePitch(std::clamp(pitch, -1.3f, 1.3f));
 }
 
 // ─── Nearest waypoint index ───────────────────────────────────────────────────
@@ -158,20 +157,23 @@ static int NearestWaypoint(Vector3 pos, const std::vector<Waypoint>& wps) {
 // ─────────────────────────────────────────────────────────────────────────────
 //  Main per-frame update for all bots
 // ─────────────────────────────────────────────────────────────────────────────
-inline void UpdateBots(World& world, float dt) {
+inline void UpdateBots(World& world, uint32_t tick, float dt) {
     for(int i = 0; i < MAX_PAWNS; i++) {
         Pawn& bot = world.pawns[i];
         if(!bot.isBot || !bot.alive) continue;
 
-        BotBrain& brain = s_brains[i];
+        BotBrain& brain = world.brains[i];
 
-        // ── Weapon tick ─────────────────────────────────────────────────────
-        WeaponTick(bot.weapon, dt);
+        // Hold the current view unless a state turns it
+        PlayerCommand cmd;
+        cmd.tick  = tick;
+        cmd.yaw   = QuantizeYaw(bot.xform.yaw);
+        cmd.pitch = QuantizePitch(bot.xform.pitch);
 
-        // ── Vision raycast (throttled to BOT_RAYCAST_HZ) ──────────────────
+        // ── Vision raycast (throttled to bots.raycast_hz) ─────────────────
         brain.visionTimer -= dt;
         if(brain.visionTimer <= 0) {
-            brain.visionTimer = 1.0f / BOT_RAYCAST_HZ;
+            brain.visionTimer = 1.0f / Tune().botRaycastHz;
             int vis = FindVisibleEnemy(i, world);
             if(vis >= 0) {
                 bool reacquire = (brain.targetID != vis) ||
@@ -184,17 +186,25 @@ inline void UpdateBots(World& world, float dt) {
                 brain.state = BotFSMState::ENGAGE;
 
                 if(reacquire) {
-                    brain.reactionTimer = BOT_REACTION_MS / 1000.0f;
+                    brain.reactionTimer = Tune().botReactionMs / 1000.0f;
                 }
             } else if(brain.targetID >= 0) {
                 if(brain.hasSightLine) {
-                    brain.reactionTimer = BOT_REACTION_MS / 1000.0f;
+                    brain.reactionTimer = Tune().botReactionMs / 1000.0f;
                 }
                 brain.hasSightLine = false;
                 brain.lostSightTimer = 0.0f;
                 if(brain.state == BotFSMState::ENGAGE)
                     brain.state = BotFSMState::SEARCH;
             }
+
+            // Unseen enemies still give themselves away by sound
+            Vector3 heardAt;
+            if(HearNoise(i, brain, world, heardAt) && brain.state != BotFSMState::ENGAGE &&
+               brain.state != BotFSMState::RETREAT) {
+                brain.lastKnown = heardAt;
+                brain.state     = BotFSMState::SEARCH;
+            }
         }
 
         // ── Retreat trigger ───────────────────────────────────────────────
@@ -210,13 +220,13 @@ inline void UpdateBots(World& world, float dt) {
         case BotFSMState::PATROL: {
             if(world.waypoints.empty()) break;
             Waypoint& wp = world.waypoints[brain.waypointIdx % world.waypoints.size()];
-            MoveBotToward(bot, wp.pos, dt, world.solids);
+            MoveBotToward(bot, wp.pos, cmd);
 
             float d = Vector3Length(Vector3Subtract(bot.xform.pos, wp.pos));
-            if(d < BOT_WAYPOINT_REACH) {
+            if(d < Tune().botWaypointReach) {
                 // Advance to next waypoint
                 if(!wp.neighbours.empty())
-                    brain.waypointIdx = wp.neighbours[rand() % wp.neighbours.size()];
+                    brain.waypointIdx = wp.neighbours[world.rng.Below((int)wp.neighbours.size())];
                 else
                     brain.waypointIdx = (brain.waypointIdx + 1) % world.waypoints.size();
             }
@@ -235,13 +245,13 @@ inline void UpdateBots(World& world, float dt) {
             Vector3 aimAt = { target.xform.pos.x,
                               target.xform.pos.y + target.height() * 0.6f,
                               target.xform.pos.z };
-            AimAtTarget(bot, aimAt);
+            AimAtTarget(bot, aimAt, cmd, world.rng);
 
             // Strafe while engaging
             brain.strafeTimer -= dt;
             if(brain.strafeTimer <= 0) {
-                brain.strafeTimer = 0.8f + (float)rand()/RAND_MAX * 1.2f;
-                brain.strafeSign  = ((rand()%2) ? 1.0f : -1.0f);
+                brain.strafeTimer = 0.8f + world.rng.Float() * 1.2f;
+                brain.strafeSign  = (world.rng.Below(2) ? 1.0f : -1.0f);
             }
 
             float engageDist = Vector3Length(
@@ -249,23 +259,15 @@ inline void UpdateBots(World& world, float dt) {
 
             // Keep distance ~8-15m
             if(engageDist > 15.0f)
-                MoveBotToward(bot, target.xform.pos, dt, world.solids, brain.strafeSign);
+                MoveBotToward(bot, target.xform.pos, cmd, brain.strafeSign, false);
             else if(engageDist < 6.0f)
                 MoveBotToward(bot, Vector3Add(bot.xform.pos,
                     Vector3Scale(Vector3Normalize(
                         Vector3Subtract(bot.xform.pos, target.xform.pos)), 1.0f)),
-                    dt, world.solids);
+                    cmd, 0.0f, false);
             else {
                 // Stand and strafe
-                Vector3 right = { bot.lookDir().z, 0, -bot.lookDir().x };
-                Vector3 vel = Vector3Scale(right, brain.strafeSign * BOT_SPEED * 0.5f);
-                bot.velocity.x = vel.x;
-                bot.velocity.z = vel.z;
-                bot.velocity.y += GRAVITY * dt; if(bot.velocity.y < -50.0f) bot.velocity.y = -50.0f;
-
-                bool og = false;
-                bot.xform.pos = SweepAABB(bot.xform.pos, bot.velocity, dt, og, world.solids, bot.height());
-                if(og && bot.velocity.y <= 0.0f) { bot.velocity.y = 0.0f; bot.onGround = true; } else if(!og) { bot.onGround = false; }
+                cmd.side = QuantizeMove(brain.strafeSign * BotMoveScale() * 0.5f);
             }
 
             bool frameSightLine = HasLineOfSightToTarget(bot, target, world);
@@ -274,13 +276,14 @@ inline void UpdateBots(World& world, float dt) {
                 brain.lostSightTimer = 0.0f;
 
                 brain.reactionTimer -= dt;
-                if(brain.reactionTimer <= 0) {
-                    WeaponFire(bot, world, false);
-                }
+                // Semi-auto weapons need the trigger released between shots
+                bool held = bot.lastButtons & CMD_FIRE;
+                if(brain.reactionTimer <= 0 && !(held && bot.weapon.stats().semiAuto))
+                    cmd.buttons |= CMD_FIRE;
             } else {
                 brain.hasSightLine = false;
                 brain.lastKnown = target.xform.pos;
-                brain.reactionTimer = BOT_REACTION_MS / 1000.0f;
+                brain.reactionTimer = Tune().botReactionMs / 1000.0f;
                 brain.lostSightTimer += dt;
 
                 // Keep engage for a short grace window to avoid flickering states
@@ -293,9 +296,9 @@ inline void UpdateBots(World& world, float dt) {
         }
         // ────────────────────────────────────────────────────────────────
         case BotFSMState::SEARCH: {
-            MoveBotToward(bot, brain.lastKnown, dt, world.solids);
+            MoveBotToward(bot, brain.lastKnown, cmd);
             float d = Vector3Length(Vector3Subtract(bot.xform.pos, brain.lastKnown));
-            if(d < BOT_WAYPOINT_REACH * 2.0f) {
+            if(d < Tune().botWaypointReach * 2.0f) {
                 brain.state    = BotFSMState::PATROL;
                 brain.targetID = -1;
                 brain.hasSightLine = false;
@@ -311,7 +314,7 @@ inline void UpdateBots(World& world, float dt) {
                 break;
             }
             int nearest = NearestWaypoint(bot.xform.pos, world.waypoints);
-            MoveBotToward(bot, world.waypoints[nearest].pos, dt, world.solids);
+            MoveBotToward(bot, world.waypoints[nearest].pos, cmd);
             brain.retreatTimer -= dt;
             if(bot.hp > 50 || brain.retreatTimer <= 0.0f || world.aliveCount(bot.team) <= 1) {
                 brain.state = BotFSMState::PATROL;
@@ -322,14 +325,24 @@ inline void UpdateBots(World& world, float dt) {
             break;
         }
         }
+
+        ApplyPlayerCommand(world, bot, cmd, dt);
     }
 }
 
 // ─── Initialise bot brains at round start ─────────────────────────────────────
-inline void InitBotBrains(const World& world) {
+inline void InitBotBrains(World& world) {
     for(int i = 0; i < MAX_PAWNS; i++) {
-        s_brains[i] = BotBrain{};
+        world.brains[i] = BotBrain{};
+        world.brains[i].noiseCursor = world.noises.head;   // last round's noise is stale
         if(!world.waypoints.empty())
-            s_brains[i].waypointIdx = i % (int)world.waypoints.size();
+            world.brains[i].waypointIdx = i % (int)world.waypoints.size();
     }
-}
\ No newline at end of file
+}
+
+// ─── Re-aim patrols after the waypoint graph changed (map hot reload) ────────
+inline void RetargetBotWaypoints(World& world) {
+    if(world.waypoints.empty()) return;
+    for(int i = 0; i < MAX_PAWNS; i++)
+        world.brains[i].waypointIdx = NearestWaypoint(world.pawns[i].xform.pos, world.waypoints);
+}
@@ -0,0 +1,258 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  AudioMixer.h  –  Voice pools and spatialisation (audio thread only)
+//
+//  Every SoundID owns a small pool of LoadSoundAlias voices sharing one
+//  decoded buffer, so rapid fire overlaps instead of cutting itself off.
+//  At most AUDIO_MAX_VOICES sound at once: a new sound takes a free voice
+//  from its pool, else the pool's oldest, and if the global cap is hit it
+//  must outrank (priority, then loudness) the weakest voice playing.
+//  Positional voices are attenuated by distance and panned against the
+//  listener's right vector; occlusion arrives precomputed in commands.
+//
+//  Nothing here is thread-safe: AudioSystem's thread owns the mixer and is
+//  the only caller of raylib's sound API once the device is open.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "SoundEvents.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+constexpr int   AUDIO_MAX_VOICES      = 12;     // sounding at once
+constexpr float AUDIO_MIN_GAIN        = 0.02f;  // quieter sounds are not started
+constexpr float AUDIO_OCCLUDED_GAIN   = 0.4f;   // behind a wall
+constexpr float AUDIO_OCCLUSION_RATE  = 6.0f;   // gain change per second, no pops
+constexpr float AUDIO_PAN_WIDTH       = 0.8f;   // never fully one-sided
+constexpr float AUDIO_PITCH_JITTER    = 0.04f;  // ± per shot, breaks up repeats
+constexpr const char* AUDIO_FALLBACK_FILE = "assets/audio/sniper.mp3";
+
+struct SoundDef {
+    const char* file;       // preferred asset; falls back to AUDIO_FALLBACK_FILE
+    float       volume;
+    float       pitch;      // also tells apart sounds sharing the fallback
+    int         voices;     // pool size
+    int         priority;   // higher may steal from lower
+    float       refDist;    // full volume inside this (metres)
+    float       maxDist;    // silent beyond this
+};
+
+constexpr SoundDef SOUND_DEFS[(int)SoundID::COUNT] = {
+    //  file                          vol   pitch voices prio  ref   max
+    { "assets/audio/pistol.mp3",     0.70f, 1.35f, 3,    1,  4.0f, 60.0f },  // SHOT_PISTOL
+    { "assets/audio/smg.mp3",        0.60f, 1.55f, 4,    1,  4.0f, 55.0f },  // SHOT_SMG
+    { "assets/audio/rifle.mp3",      0.80f, 1.20f, 4,    2,  5.0f, 70.0f },  // SHOT_RIFLE
+    { "assets/audio/sniper.mp3",     1.00f, 1.00f, 2,    3,  6.0f, 90.0f },  // SHOT_SNIPER
+    { "assets/audio/shotgun.mp3",    0.90f, 0.85f, 2,    2,  5.0f, 65.0f },  // SHOT_SHOTGUN
+    { "assets/audio/frag.mp3",       1.00f, 0.55f, 2,    4,  8.0f, 90.0f },  // FRAG_BLAST
+    { "assets/audio/smoke.mp3",      0.50f, 1.80f, 2,    0,  3.0f, 35.0f },  // SMOKE_POP
+    { "assets/audio/stun.mp3",       0.90f, 0.70f, 2,    3,  6.0f, 70.0f },  // STUN_BANG
+    { "assets/audio/step.mp3",       0.35f, 2.60f, 4,    0,  2.0f, 22.0f },  // FOOTSTEP
+    { "assets/audio/land.mp3",       0.55f, 2.10f, 2,    0,  2.5f, 28.0f },  // LAND
+};
+
+// Inverse-distance falloff, faded to zero over the last quarter of maxDist.
+inline float SoundAttenuation(const SoundDef& def, float dist) {
+    float g    = def.refDist / std::max(dist, def.refDist);
+    float fade = (def.maxDist - dist) / (def.maxDist * 0.25f);
+    return g * std::clamp(fade, 0.0f, 1.0f);
+}
+
+// ─── Game thread → audio thread ──────────────────────────────────────────────
+enum class AudioOp : uint8_t { PLAY, OCCLUSION, LISTENER, STOP_ALL };
+
+struct AudioCommand {
+    AudioOp  op         = AudioOp::PLAY;
+    SoundID  id         = SoundID::SHOT_PISTOL;
+    bool     positional = false;
+    uint16_t handle     = 0;      // PLAY / OCCLUSION: which voice
+    float    value      = 1.0f;   // PLAY / OCCLUSION: occlusion gain
+    Vector3  pos        = {};     // PLAY: source; LISTENER: position
+    Vector3  right      = {};     // LISTENER: unit right vector
+};
+
+class AudioMixer {
+public:
+    // Decode each file once to PCM (LoadWave), upload it as a Sound, and
+    // alias it into the pools.  Slow (MP3 decode), so the thread runs it.
+    void Load() {
+        for(int id = 0; id < (int)SoundID::COUNT; id++) {
+            const SoundDef& def = SOUND_DEFS[id];
+            const char* path = FileExists(def.file)            ? def.file
+                             : FileExists(AUDIO_FALLBACK_FILE) ? AUDIO_FALLBACK_FILE
+                             : nullptr;
+            pools[id] = { (int)voices.size(), 0 };
+            if(!path) {
+                TraceLog(LOG_WARNING, "AudioMixer: no audio for %s", def.file);
+                continue;
+            }
+            const Buffer* base = Base(path);
+            if(!base) continue;
+            for(int k = 0; k < def.voices; k++) {
+                Voice v;
+                v.sound = LoadSoundAlias(base->sound);
+                v.id    = (SoundID)id;
+                voices.push_back(v);
+            }
+            pools[id].count = def.voices;
+            lengthSec[id]   = base->seconds / def.pitch;
+        }
+        TraceLog(LOG_INFO, "AudioMixer: %d voices over %d PCM buffers, %d may sound at once",
+                 (int)voices.size(), (int)bases.size(), AUDIO_MAX_VOICES);
+    }
+
+    void Unload() {
+        for(Voice& v : voices) UnloadSoundAlias(v.sound);
+        for(auto& b : bases)   UnloadSound(b.sound);
+        voices.clear();
+        bases.clear();
+    }
+
+    // Playback length at the def's pitch, 0 if the sound has no audio.
+    float Length(SoundID id) const { return lengthSec[(int)id]; }
+
+    void Execute(const AudioCommand& c) {
+        switch(c.op) {
+        case AudioOp::PLAY:      Play(c); break;
+        case AudioOp::OCCLUSION:
+            for(Voice& v : voices)
+                if(v.active && v.handle == c.handle) v.occlusionTarget = c.value;
+            break;
+        case AudioOp::LISTENER:  listener = c.pos; right = c.right; break;
+        case AudioOp::STOP_ALL:
+            for(Voice& v : voices)
+                if(v.active) { StopSound(v.sound); v.active = false; }
+            break;
+        }
+    }
+
+    // Retire finished voices, ease occlusion, re-spatialise.
+    void Tick(float dt) {
+        clock += dt;
+        const float step = AUDIO_OCCLUSION_RATE * dt;
+        for(Voice& v : voices) {
+            if(!v.active) continue;
+            if(!IsSoundPlaying(v.sound)) { v.active = false; continue; }
+            if(!v.positional) continue;
+            v.occlusion += std::clamp(v.occlusionTarget - v.occlusion, -step, step);
+            Apply(v);
+        }
+    }
+
+private:
+    struct Voice {
+        Sound    sound = {};
+        SoundID  id    = SoundID::SHOT_PISTOL;
+        uint16_t handle     = 0;
+        bool     active     = false;
+        bool     positional = false;
+        Vector3  pos   = {};
+        float    loudness  = 0.0f;   // gain last applied, for stealing
+        float    occlusion = 1.0f;
+        float    occlusionTarget = 1.0f;
+        float    startedAt       = 0.0f;
+    };
+    struct Buffer    { std::string path; Sound sound; float seconds; };
+    struct PoolRange { int first, count; };
+
+    std::vector<Buffer>                          bases;
+    std::vector<Voice>                           voices;
+    std::array<PoolRange, (int)SoundID::COUNT>   pools{};
+    std::array<float, (int)SoundID::COUNT>       lengthSec{};
+    Vector3 listener = {};
+    Vector3 right    = { -1, 0, 0 };
+    float   clock    = 0.0f;
+
+    // One decode per file; aliases share it.
+    const Buffer* Base(const char* path) {
+        for(const auto& b : bases) if(b.path == path) return &b;
+        Wave w = LoadWave(path);
+        if(w.frameCount == 0 || w.sampleRate == 0) {
+            TraceLog(LOG_WARNING, "AudioMixer: cannot decode %s", path);
+            return nullptr;
+        }
+        bases.push_back({ path, LoadSoundFromWave(w), (float)w.frameCount / w.sampleRate });
+        UnloadWave(w);   // the Sound keeps its own device-format copy
+        return &bases.back();
+    }
+
+    void Apply(Voice& v) {
+        const SoundDef& def = SOUND_DEFS[(int)v.id];
+        float gain = def.volume;
+        float lr   = 0.0f;   // -1 left … +1 right
+        if(v.positional) {
+            Vector3 d    = Vector3Subtract(v.pos, listener);
+            float   dist = Vector3Length(d);
+            gain *= SoundAttenuation(def, dist) * v.occlusion;
+            if(dist > 0.01f) lr = Vector3DotProduct(d, right) / dist * AUDIO_PAN_WIDTH;
+        }
+        v.loudness = gain;
+        SetSoundVolume(v.sound, gain);
+        SetSoundPan(v.sound, 0.5f - 0.5f * lr);   // raylib 5.0: 1.0 = left
+    }
+
+    // Weakest sounding voice: lowest priority, then quietest.
+    int Weakest() const {
+        int best = -1;
+        for(int i = 0; i < (int)voices.size(); i++) {
+            const Voice& v = voices[i];
+            if(!v.active) continue;
+            if(best < 0 || Outranks(voices[best], v)) best = i;
+        }
+        return best;
+    }
+
+    static bool Outranks(const Voice& a, const Voice& b) {
+        int pa = SOUND_DEFS[(int)a.id].priority, pb = SOUND_DEFS[(int)b.id].priority;
+        return pa != pb ? pa > pb : a.loudness > b.loudness;
+    }
+
+    void Play(const AudioCommand& c) {
+        const SoundDef&  def  = SOUND_DEFS[(int)c.id];
+        const PoolRange& pool = pools[(int)c.id];
+        if(pool.count == 0) return;
+
+        Voice fresh;
+        fresh.id         = c.id;
+        fresh.handle     = c.handle;
+        fresh.positional = c.positional;
+        fresh.pos        = c.pos;
+        fresh.loudness   = def.volume;
+        if(fresh.positional) {
+            fresh.loudness *= SoundAttenuation(def, Vector3Distance(listener, c.pos)) * c.value;
+            if(fresh.loudness < AUDIO_MIN_GAIN) return;
+        }
+
+        // A free voice in the pool, else its oldest
+        int slot = -1;
+        for(int i = pool.first; i < pool.first + pool.count; i++) {
+            if(!voices[i].active) { slot = i; break; }
+            if(slot < 0 || voices[i].startedAt < voices[slot].startedAt) slot = i;
+        }
+        int sounding = 0;
+        for(const Voice& v : voices) sounding += v.active;
+        if(!voices[slot].active && sounding >= AUDIO_MAX_VOICES) {
+            int victim = Weakest();
+            if(victim < 0 || !Outranks(fresh, voices[victim])) return;   // drop
+            StopSound(voices[victim].sound);
+            voices[victim].active = false;
+        }
+
+        Voice& v = voices[slot];
+        if(v.active) StopSound(v.sound);
+        fresh.sound           = v.sound;
+        fresh.active          = true;
+        fresh.occlusion       = c.value;
+        fresh.occlusionTarget = c.value;
+        fresh.startedAt       = clock;
+        v = fresh;
+
+        float jitter = GetRandomValue(-100, 100) / 100.0f * AUDIO_PITCH_JITTER;
+        SetSoundPitch(v.sound, def.pitch * (1.0f + jitter));
+        Apply(v);
+        PlaySound(v.sound);
+    }
+};
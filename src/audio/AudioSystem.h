@@ -1,33 +1,198 @@
 #pragma once
 // ─────────────────────────────────────────────────────────────────────────────
-//  AudioSystem.h  –  Minimal audio, sniper shot only
+//  AudioSystem.h  –  Game-thread front end of the audio thread
+//
+//  The game thread never touches raylib's sound API.  Update() drains
+//  World::soundEvents, culls inaudible sounds, casts the occlusion ray and
+//  sends AudioCommands through a lock-free SPSC ring; a full ring drops the
+//  command rather than waiting.  The audio thread opens the audio device and
+//  decodes every asset to PCM once at startup, in parallel with the window
+//  and the map (sounds raised before Ready() are dropped), then drains the
+//  ring every AUDIO_TICK_MS and runs the AudioMixer.  It also closes the
+//  device, so raylib's audio module is only ever used from that thread.
+//
+//  Occlusion stays on the game thread because it reads world.solids, which
+//  streaming and hot reload replace there.  One ray when a sound starts,
+//  then at most AUDIO_OCCLUSION_RAYS rechecks per frame over the sources
+//  still playing, round-robin, so the cost is bounded however many are live.
 // ─────────────────────────────────────────────────────────────────────────────
+#include "../SpscRing.h"
+#include "../World.h"
+#include "../game/Physics.h"
+#include "AudioMixer.h"
+#include "SoundEvents.h"
 #include <raylib.h>
-#include "../Constants.h"
+#include <raymath.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
 
-struct AudioSystem {
+constexpr float AUDIO_OCCLUSION_HZ   = 10.0f;  // per-source recheck rate
+constexpr int   AUDIO_OCCLUSION_RAYS = 2;      // recheck rays per frame, all sources
+constexpr int   AUDIO_QUEUE_SIZE     = 256;    // commands in flight
+constexpr int   AUDIO_TICK_MS        = 2;      // audio thread wake-up period
+constexpr int   AUDIO_TRACKED        = 32;     // live sources re-occluded
 
-    Sound sniperShot = {};
-    bool  loaded     = false;
+class AudioSystem {
+public:
+    AudioSystem() = default;
+    AudioSystem(const AudioSystem&) = delete;
+    AudioSystem& operator=(const AudioSystem&) = delete;
+    ~AudioSystem() { Shutdown(); }
 
+    // Returns at once; device start-up and decoding happen on the thread.
     void Init() {
-        if(FileExists("assets/audio/sniper.mp3")) {
-            sniperShot = LoadSound("assets/audio/sniper.mp3");
-            loaded     = true;
-        } else {
-            TraceLog(LOG_WARNING, "AudioSystem: assets/audio/sniper.mp3 not found");
-        }
+        quit.store(false);
+        thread = std::thread([this]{ Run(); });
     }
 
     void Shutdown() {
-        if(loaded) UnloadSound(sniperShot);
+        if(!thread.joinable()) return;
+        quit.store(true, std::memory_order_release);
+        thread.join();
+    }
+
+    bool     Ready()   const { return ready.load(std::memory_order_acquire); }
+    uint32_t Dropped() const { return dropped; }   // commands lost to a full ring
+
+    // ── Game thread, once per frame ─────────────────────────────────────────
+    void Update(World& world, Vector3 listenerPos, Vector3 listenerFwd, float dt) {
+        clock   += dt;
+        listener = listenerPos;
+        Vector3 r = Vector3CrossProduct(listenerFwd, { 0, 1, 0 });
+        if(Vector3LengthSqr(r) > 1e-6f) right = Vector3Normalize(r);
+
+        AudioCommand c;
+        c.op    = AudioOp::LISTENER;
+        c.pos   = listener;
+        c.right = right;
+        Send(c);
+
+        SoundEvent ev;
+        while(world.soundEvents.Pop(ev)) Play(ev, world);
+        Reocclude(world);
+    }
+
+    void StopAll() {
+        AudioCommand c;
+        c.op = AudioOp::STOP_ALL;
+        Send(c);
+        for(Tracked& t : tracked) t.live = false;
+    }
+
+private:
+    // A positional sound the game thread keeps re-occluding until it ends.
+    struct Tracked {
+        uint16_t handle    = 0;
+        bool     live      = false;
+        Vector3  pos       = {};
+        float    endsAt    = 0.0f;
+        float    nextCheck = 0.0f;
+        float    occlusion = 1.0f;   // last value sent
+    };
+
+    // ── Shared with the audio thread ────────────────────────────────────────
+    SpscRing<AudioCommand, AUDIO_QUEUE_SIZE> queue;
+    std::thread       thread;
+    std::atomic<bool> quit{ false };
+    std::atomic<bool> ready{ false };   // mixer loaded; Length() is valid
+    AudioMixer        mixer;            // audio thread only, except Length()
+
+    // ── Game thread only ────────────────────────────────────────────────────
+    std::array<Tracked, AUDIO_TRACKED> tracked{};
+    Vector3  listener   = {};
+    Vector3  right      = { -1, 0, 0 };
+    float    clock      = 0.0f;
+    uint16_t nextHandle = 0;
+    int      cursor     = 0;
+    uint32_t dropped    = 0;
+
+    bool Send(const AudioCommand& c) {
+        if(queue.TryPush(c)) return true;
+        dropped++;
+        return false;
     }
 
-    void PlayShoot(WeaponID id) {
-        if(!loaded) return;
-        if(id == WeaponID::SNIPER) {
-            StopSound(sniperShot);
-            PlaySound(sniperShot);
+    float Occlusion(Vector3 src, const World& world) const {
+        Vector3 d    = Vector3Subtract(src, listener);
+        float   dist = Vector3Length(d);
+        if(dist < 0.5f) return 1.0f;
+        HitResult hr = RaycastSolids(listener, Vector3Scale(d, 1.0f / dist), dist, world.solids);
+        return (hr.hit && hr.distance < dist - 0.3f) ? AUDIO_OCCLUDED_GAIN : 1.0f;
+    }
+
+    void Play(const SoundEvent& ev, const World& world) {
+        if(!Ready()) return;   // still decoding; nothing has been heard yet
+        const SoundDef& def = SOUND_DEFS[(int)ev.id];
+
+        AudioCommand c;
+        c.op         = AudioOp::PLAY;
+        c.id         = ev.id;
+        c.positional = ev.source != world.playerID;   // own sounds stay centred
+        c.handle     = ++nextHandle;
+        c.pos        = ev.pos;
+        if(c.positional) {
+            // Cull before spending a ray on it
+            float dist = Vector3Distance(listener, ev.pos);
+            if(def.volume * SoundAttenuation(def, dist) < AUDIO_MIN_GAIN) return;
+            c.value = Occlusion(ev.pos, world);
+        }
+        if(!Send(c) || !c.positional) return;
+
+        // Track it; evict the source that ends first if all slots are live.
+        Tracked* slot = &tracked[0];
+        for(Tracked& t : tracked) {
+            if(!t.live || t.endsAt <= clock) { slot = &t; break; }
+            if(t.endsAt < slot->endsAt) slot = &t;
+        }
+        slot->handle    = c.handle;
+        slot->live      = true;
+        slot->pos       = ev.pos;
+        slot->endsAt    = clock + mixer.Length(ev.id) * (1.0f + AUDIO_PITCH_JITTER);
+        slot->nextCheck = clock + 1.0f / AUDIO_OCCLUSION_HZ;
+        slot->occlusion = c.value;
+    }
+
+    void Reocclude(const World& world) {
+        int rays = AUDIO_OCCLUSION_RAYS;
+        for(int k = 0; k < AUDIO_TRACKED && rays > 0; k++) {
+            Tracked& t = tracked[(cursor + k) % AUDIO_TRACKED];   // rotate who gets the rays
+            if(!t.live) continue;
+            if(clock >= t.endsAt) { t.live = false; continue; }
+            if(clock < t.nextCheck) continue;
+            rays--;
+            t.nextCheck = clock + 1.0f / AUDIO_OCCLUSION_HZ;
+            float occ = Occlusion(t.pos, world);
+            if(occ == t.occlusion) continue;
+            AudioCommand c;
+            c.op     = AudioOp::OCCLUSION;
+            c.handle = t.handle;
+            c.value  = occ;
+            if(Send(c)) t.occlusion = occ;
+        }
+        cursor = (cursor + 1) % AUDIO_TRACKED;
+    }
+
+    // ── Audio thread ─────────────────────────────────────────────────────────
+    void Run() {
+        InitAudioDevice();
+        mixer.Load();
+        ready.store(true, std::memory_order_release);
+
+        auto last = std::chrono::steady_clock::now();
+        AudioCommand c;
+        while(!quit.load(std::memory_order_acquire)) {
+            while(queue.TryPop(c)) mixer.Execute(c);
+            auto now = std::chrono::steady_clock::now();
+            mixer.Tick(std::chrono::duration<float>(now - last).count());
+            last = now;
+            std::this_thread::sleep_for(std::chrono::milliseconds(AUDIO_TICK_MS));
         }
+        c.op = AudioOp::STOP_ALL;
+        mixer.Execute(c);
+        mixer.Unload();
+        CloseAudioDevice();
     }
-};
\ No newline at end of file
+};
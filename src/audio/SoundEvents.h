@@ -0,0 +1,122 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  SoundEvents.h  –  Fixed ring of sound events raised by the simulation
+//
+//  Gameplay code never calls audio directly: it pushes a SoundEvent (what,
+//  where, who) and AudioSystem drains the ring once per frame.  The ring is
+//  fixed-size and overwrites its oldest entry when full, so a burst of
+//  gunfire can never allocate or stall the tick.
+//
+//  World::EmitSound also copies pawn-made sounds into a NoiseRing that bots
+//  poll for hearing: a distance check per event, no rays, so listening is
+//  far cheaper than another vision raycast.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Constants.h"
+#include <raylib.h>
+#include <array>
+#include <cstdint>
+
+enum class SoundID : uint8_t {
+    SHOT_PISTOL,
+    SHOT_SMG,
+    SHOT_RIFLE,
+    SHOT_SNIPER,
+    SHOT_SHOTGUN,
+    FRAG_BLAST,
+    SMOKE_POP,
+    STUN_BANG,
+    FOOTSTEP,
+    LAND,
+    COUNT
+};
+
+struct SoundEvent {
+    SoundID id     = SoundID::SHOT_PISTOL;
+    int8_t  source = -1;   // pawn index, -1 = world
+    Vector3 pos    = {};
+};
+
+constexpr int SOUND_EVENT_CAPACITY = 64;   // power of two
+
+struct SoundEventRing {
+    std::array<SoundEvent, SOUND_EVENT_CAPACITY> items;
+    uint32_t head = 0;   // next write
+    uint32_t tail = 0;   // next read
+
+    void Push(SoundID id, Vector3 pos, int source = -1) {
+        if(head - tail == SOUND_EVENT_CAPACITY) tail++;   // full: drop oldest
+        items[head++ & (SOUND_EVENT_CAPACITY - 1)] = { id, (int8_t)source, pos };
+    }
+
+    bool Pop(SoundEvent& out) {
+        if(tail == head) return false;
+        out = items[tail++ & (SOUND_EVENT_CAPACITY - 1)];
+        return true;
+    }
+
+    void Clear() { tail = head; }
+};
+
+static_assert((SOUND_EVENT_CAPACITY & (SOUND_EVENT_CAPACITY - 1)) == 0,
+              "SOUND_EVENT_CAPACITY must be a power of two");
+
+inline SoundID ShotSound(WeaponID id) {
+    switch(id) {
+    case WeaponID::PISTOL:  return SoundID::SHOT_PISTOL;
+    case WeaponID::SMG:     return SoundID::SHOT_SMG;
+    case WeaponID::RIFLE:   return SoundID::SHOT_RIFLE;
+    case WeaponID::SNIPER:  return SoundID::SHOT_SNIPER;
+    case WeaponID::SHOTGUN: return SoundID::SHOT_SHOTGUN;
+    case WeaponID::COUNT:   break;
+    }
+    return SoundID::SHOT_PISTOL;
+}
+
+// ─── Hearing ─────────────────────────────────────────────────────────────────
+// How far a bot notices each sound; shorter than the mixer's maxDist, since
+// a faint cue the player might catch is not enough for a bot to act on.
+inline float HearingRange(SoundID id) {
+    switch(id) {
+    case SoundID::SHOT_PISTOL:
+    case SoundID::SHOT_SMG:     return 30.0f;
+    case SoundID::SHOT_RIFLE:
+    case SoundID::SHOT_SHOTGUN: return 35.0f;
+    case SoundID::SHOT_SNIPER:  return 45.0f;
+    case SoundID::FOOTSTEP:     return 12.0f;
+    case SoundID::LAND:         return 16.0f;
+    case SoundID::FRAG_BLAST:
+    case SoundID::SMOKE_POP:
+    case SoundID::STUN_BANG:
+    case SoundID::COUNT:        break;   // world sounds reveal no one
+    }
+    return 0.0f;
+}
+
+struct NoiseEvent {
+    Vector3 pos    = {};
+    int8_t  source = -1;          // pawn index
+    Team    team   = Team::NONE;
+    float   range  = 0.0f;        // audible within this many metres
+};
+
+constexpr int NOISE_CAPACITY = 32;   // power of two
+
+// Unlike SoundEventRing there is no single consumer: every bot keeps its own
+// cursor and reads what was added since, so one event reaches all listeners.
+struct NoiseRing {
+    std::array<NoiseEvent, NOISE_CAPACITY> items;
+    uint32_t head = 0;   // total ever pushed
+
+    void Push(const NoiseEvent& e) { items[head++ & (NOISE_CAPACITY - 1)] = e; }
+
+    // Visit events newer than cursor, oldest first; a cursor that fell more
+    // than a ring behind skips what was overwritten.
+    template<class Fn>
+    void ForEachSince(uint32_t& cursor, Fn&& fn) const {
+        if(head - cursor > NOISE_CAPACITY) cursor = head - NOISE_CAPACITY;
+        for(; cursor != head; cursor++) fn(items[cursor & (NOISE_CAPACITY - 1)]);
+    }
+};
+
+static_assert((NOISE_CAPACITY & (NOISE_CAPACITY - 1)) == 0,
+              "NOISE_CAPACITY must be a power of two");
@@ -0,0 +1,154 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  Calibration.h  –  Pick a QualityPreset by timing this machine
+//
+//  Runs behind the loading screen when the first match starts, once the map
+//  is installed, in about a second:
+//    1. CPU   – CALIB_SIM_TICKS ticks of a live round: bots think, shoot
+//               and move, utility flies.
+//    2. Fill  – CALIB_FILL_LAYERS blended quads over the whole render target.
+//    3. Scene – the real renderer, offscreen, from CALIB_VIEWS waypoints
+//               looking at the objective through two smokes and a full
+//               load of impacts and tracers, once per preset.
+//  Readbacks of the render target fence the GPU work; the cost of one
+//  readback is measured alone and taken off.  The best preset whose frame
+//  (simulation share + scene + MSAA resolve) fits CALIB_HEADROOM of the
+//  TARGET_FPS budget wins.
+//
+//  The world is left mid-round with scratch effects; call ResetRound after.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../World.h"
+#include "../ai/BotAI.h"
+#include "../render/QualitySettings.h"
+#include "../render/Renderer.h"
+#include "../utility/UtilitySystem.h"
+#include "InputSnapshot.h"
+#include "InputSystem.h"
+#include "RoundManager.h"
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+
+constexpr int   CALIB_SIM_TICKS   = 300;
+constexpr int   CALIB_FILL_LAYERS = 16;
+constexpr int   CALIB_VIEWS       = 6;
+constexpr int   CALIB_FRAMES      = 3;      // scene frames per view between fences
+constexpr float CALIB_HEADROOM    = 0.75f;  // share of the frame budget a preset may use
+
+// Wait for everything drawn into target so far; returns the seconds it took.
+inline double CalibFence(const RenderTexture2D& target) {
+    double t0 = InputClock();
+    Image img = LoadImageFromTexture(target.texture);
+    UnloadImage(img);
+    return InputClock() - t0;
+}
+
+inline float CalibSimTickMs(World& world, const MapData& md) {
+    ResetRound(world, md);
+    world.roundState = RoundState::ACTIVE;
+    PlayerCommand idle;
+    idle.yaw   = QuantizeYaw(world.player().xform.yaw);
+    idle.pitch = QuantizePitch(world.player().xform.pitch);
+
+    double t0 = 0.0;
+    for(int tick = -20; tick < CALIB_SIM_TICKS; tick++) {   // 20 warm-up ticks
+        if(tick == 0) t0 = InputClock();
+        ApplyPlayerCommand(world, world.player(), idle, SIM_DT);
+        UpdateBots(world, (uint32_t)(tick + 20), SIM_DT);
+        UpdateUtility(world, SIM_DT);
+    }
+    return (float)((InputClock() - t0) * 1000.0 / CALIB_SIM_TICKS);
+}
+
+inline float CalibFillMpixS(const RenderTexture2D& target, double fence) {
+    double best = 1e9;
+    for(int rep = 0; rep < 3; rep++) {
+        CalibFence(target);
+        double t0 = InputClock();
+        BeginTextureMode(target);
+        for(int l = 0; l < CALIB_FILL_LAYERS; l++)
+            DrawRectangle(0, 0, RENDER_W, RENDER_H, { 255, 255, 255, 8 });
+        EndTextureMode();
+        CalibFence(target);
+        best = std::min(best, InputClock() - t0 - fence);
+    }
+    double pixels = (double)CALIB_FILL_LAYERS * RENDER_W * RENDER_H;
+    return (float)(pixels / std::max(best, 1e-6) / 1e6);
+}
+
+// Scripted scene: smokes on the objective, impacts scattered around it and
+// tracers into it, as many as the preset allows.
+inline void CalibStageEffects(World& world, const QualitySettings& q) {
+    Vector3 o = world.objective.pos;
+    world.smokes.clear();
+    world.smokes.push_back({ Vector3Add(o, { -1.5f, 0.5f, 0.0f }) });
+    world.smokes.push_back({ Vector3Add(o, {  1.5f, 0.5f, 1.0f }) });
+    world.impacts.clear();
+    for(int i = 0; i < q.maxImpacts; i++) {
+        float a = i * 2.39996f, r = 1.0f + (i % 8);   // golden-angle spiral
+        world.impacts.push_back({ Vector3Add(o, { cosf(a) * r, 0.05f + (i % 3), sinf(a) * r }) });
+    }
+    world.tracers.clear();
+    for(int i = 0; i < q.maxTracers && !world.waypoints.empty(); i++) {
+        const Waypoint& w = world.waypoints[i % world.waypoints.size()];
+        world.tracers.push_back({ Vector3Add(w.pos, { 0, 1.5f, 0 }), o });
+    }
+}
+
+inline float CalibSceneMs(World& world, Renderer& renderer, const QualitySettings& q, double fence) {
+    renderer.renderScale    = q.renderScale;
+    renderer.mapEdges       = q.mapEdges;
+    renderer.smokeLayers    = q.smokeLayers;
+    renderer.reducedEffects = false;
+    CalibStageEffects(world, q);
+
+    int views = std::min(CALIB_VIEWS, (int)world.waypoints.size());
+    Vector3 look = Vector3Add(world.objective.pos, { 0, 1.0f, 0 });
+    double total = 0.0;
+    for(int v = 0; v < views; v++) {
+        const Waypoint& w = world.waypoints[v * world.waypoints.size() / views];
+        renderer.cam3D.position = Vector3Add(w.pos, { 0, PLAYER_HEIGHT, 0 });
+        renderer.cam3D.target   = look;
+        CalibFence(renderer.renderTarget);
+        double t0 = InputClock();
+        for(int f = 0; f < CALIB_FRAMES; f++) renderer.DrawScene(world);
+        CalibFence(renderer.renderTarget);
+        total += InputClock() - t0 - fence;
+    }
+    return views ? (float)(std::max(total, 0.0) * 1000.0 / (views * CALIB_FRAMES)) : 0.0f;
+}
+
+inline QualitySettings RunCalibration(World& world, const MapData& md, Renderer& renderer,
+                                      CalibrationResult& out) {
+    out = CalibrationResult{};
+    out.cpuTickMs = CalibSimTickMs(world, md);
+
+    renderer.DrawScene(world);   // first draw builds the map mesh; keep it out of the timings
+    CalibFence(renderer.renderTarget);
+    double fence = 1e9;
+    for(int i = 0; i < 3; i++) fence = std::min(fence, CalibFence(renderer.renderTarget));
+
+    out.fillMpixS = CalibFillMpixS(renderer.renderTarget, fence);
+    for(int p = 0; p < (int)QualityPreset::COUNT; p++)
+        out.sceneMs[p] = CalibSceneMs(world, renderer, QUALITY_PRESETS[p], fence);
+
+    // MSAA resolves 4 samples per window pixel for the blit and HUD
+    float budgetMs  = 1000.0f / TARGET_FPS;
+    float simMs     = out.cpuTickMs * SIM_TICK_HZ / TARGET_FPS;
+    float msaaMs    = GetScreenWidth() * GetScreenHeight() * 3.0f / (out.fillMpixS * 1e6f) * 1000.0f;
+    QualitySettings pick = QUALITY_PRESETS[(int)QualityPreset::LOW];
+    for(int p = (int)QualityPreset::COUNT - 1; p >= 0; p--) {
+        float frameMs = simMs + out.sceneMs[p] + (QUALITY_PRESETS[p].msaa ? msaaMs : 0.0f);
+        if(frameMs <= budgetMs * CALIB_HEADROOM) { pick = QUALITY_PRESETS[p]; break; }
+    }
+
+    TraceLog(LOG_INFO, "Calibration: sim %.3f ms/tick, fill %.0f Mpix/s, scene low/medium/high "
+             "%.2f/%.2f/%.2f ms -> %s", out.cpuTickMs, out.fillMpixS, out.sceneMs[0],
+             out.sceneMs[1], out.sceneMs[2], QualityPresetName(pick.preset));
+
+    world.smokes.clear();
+    world.impacts.clear();
+    world.tracers.clear();
+    world.soundEvents.Clear();   // the bots' gunfire must not play in the menu
+    return pick;
+}
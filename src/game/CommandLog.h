@@ -0,0 +1,81 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  CommandLog.h  –  The local player's PlayerCommands, to and from a file
+//
+//  An 8-byte magic followed by raw 16-byte PlayerCommand records, one per
+//  simulated tick, little-endian as the Pi writes them.  `--record file`
+//  saves a session; `--replay file` feeds the player from it instead of the
+//  devices, through the same ApplyPlayerCommand path, until it runs out.
+//  Bots still think for themselves (World::rng, seeded from the clock), so
+//  a replay repeats the player's input, not the whole match.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "PlayerCommand.h"
+#include <raylib.h>
+#include <cstdio>
+#include <cstring>
+
+constexpr char COMMAND_LOG_MAGIC[8] = { 'T', 'L', 'C', 'M', 'D', '0', '0', '1' };
+
+class CommandLog {
+public:
+    CommandLog() = default;
+    CommandLog(const CommandLog&) = delete;
+    CommandLog& operator=(const CommandLog&) = delete;
+    ~CommandLog() { Close(); }
+
+    bool OpenRecord(const char* path) {
+        Close();
+        file = fopen(path, "wb");
+        if(!file || fwrite(COMMAND_LOG_MAGIC, sizeof(COMMAND_LOG_MAGIC), 1, file) != 1) {
+            TraceLog(LOG_WARNING, "CommandLog: cannot write %s", path);
+            Close();
+            return false;
+        }
+        writing = true;
+        count   = 0;
+        return true;
+    }
+
+    bool OpenReplay(const char* path) {
+        Close();
+        file = fopen(path, "rb");
+        char magic[sizeof(COMMAND_LOG_MAGIC)] = {};
+        if(!file || fread(magic, sizeof(magic), 1, file) != 1 ||
+           memcmp(magic, COMMAND_LOG_MAGIC, sizeof(magic)) != 0) {
+            TraceLog(LOG_WARNING, "CommandLog: %s is not a command log", path);
+            Close();
+            return false;
+        }
+        writing = false;
+        count   = 0;
+        return true;
+    }
+
+    bool Recording() const { return file && writing; }
+    bool Replaying() const { return file && !writing; }
+    uint32_t Count() const { return count; }
+
+    void Write(const PlayerCommand& cmd) {
+        if(!Recording()) return;
+        if(fwrite(&cmd, sizeof(cmd), 1, file) == 1) count++;
+    }
+
+    // False at the end of the file, which also ends the replay.
+    bool Read(PlayerCommand& cmd) {
+        if(!Replaying()) return false;
+        if(fread(&cmd, sizeof(cmd), 1, file) == 1) { count++; return true; }
+        TraceLog(LOG_INFO, "CommandLog: replay ended after %u ticks", count);
+        Close();
+        return false;
+    }
+
+    void Close() {
+        if(file) fclose(file);
+        file = nullptr;
+    }
+
+private:
+    FILE*    file    = nullptr;
+    bool     writing = false;
+    uint32_t count   = 0;
+};
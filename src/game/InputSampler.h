@@ -0,0 +1,238 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  InputSampler.h  –  evdev input on its own thread, consumed per sim tick
+//
+//  raylib samples input once per rendered frame, so at 40 fps a click can
+//  wait 25 ms to be seen and mouse motion arrives in frame-sized steps.  On
+//  Linux this thread reads /dev/input/event* directly, stamps every event
+//  with the kernel's CLOCK_MONOTONIC time and pushes it through an
+//  SpscRing.  The game thread then hands each fixed tick exactly the events
+//  that happened before the tick's end (Collect), so a click lands in the
+//  10 ms tick it was made in, aimed with the motion that preceded it.
+//
+//  Opening event devices needs read access (the `input` group).  Without
+//  it, or off Linux, Available() is false and the caller falls back to
+//  PollRaylibInput.  Devices are not grabbed, so the window system still
+//  gets them; events while the game is unfocused or paused are discarded.
+//  Raw counts are used as mouse deltas, which match raylib's with a flat
+//  pointer acceleration profile.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../SpscRing.h"
+#include "InputSnapshot.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+constexpr int INPUT_QUEUE_SIZE  = 1024;   // events in flight
+constexpr int INPUT_MAX_DEVICES = 32;     // /dev/input/event0..31 scanned
+constexpr int INPUT_POLL_MS     = 20;     // thread wakes at least this often
+
+struct InputEvent {
+    double      t      = 0.0;
+    bool        motion = false;   // true: dx/dy/wheel; false: action edge
+    InputAction action = InputAction::COUNT;
+    bool        down   = false;
+    float       dx = 0, dy = 0, wheel = 0;
+};
+
+namespace evdev {
+    // <linux/input.h> would #define KEY_W & co over raylib's enum, so the few
+    // ABI pieces needed are spelled out here.
+    struct RawEvent { unsigned long sec, usec; uint16_t type, code; int32_t value; };
+    constexpr uint16_t EV_SYN_ = 0, EV_KEY_ = 1, EV_REL_ = 2;
+    constexpr uint16_t REL_X_ = 0, REL_Y_ = 1, REL_WHEEL_ = 8;
+    constexpr uint16_t BTN_LEFT_ = 0x110, BTN_RIGHT_ = 0x111;
+
+    // evdev key code for each InputAction, matching the BIND_ keys
+    constexpr uint16_t ACTION_CODES[(int)InputAction::COUNT] = {
+        17, 31, 30, 32,      // W S A D
+        57, 29, 42, 19,      // SPACE LEFTCTRL LEFTSHIFT R
+        34, 20, 33,          // G T F
+        BTN_LEFT_, BTN_RIGHT_,
+        2, 3, 4, 5, 6        // 1–5
+    };
+
+    inline InputAction ActionFor(uint16_t code) {
+        for(int a = 0; a < (int)InputAction::COUNT; a++)
+            if(ACTION_CODES[a] == code) return (InputAction)a;
+        return InputAction::COUNT;
+    }
+}
+
+class InputSampler {
+public:
+    InputSampler() = default;
+    InputSampler(const InputSampler&) = delete;
+    InputSampler& operator=(const InputSampler&) = delete;
+    ~InputSampler() { Shutdown(); }
+
+    // Opens every keyboard / mouse it can read; starts the thread if any.
+    void Init() {
+#if defined(__linux__)
+        for(int i = 0; i < INPUT_MAX_DEVICES; i++) {
+            char path[32];
+            snprintf(path, sizeof(path), "/dev/input/event%d", i);
+            int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+            if(fd < 0) continue;
+            unsigned long types = 0;
+            int clock = CLOCK_MONOTONIC;
+            if(ioctl(fd, _IOC(_IOC_READ, 'E', 0x20, sizeof(types)), &types) < 0 ||
+               !(types & ((1ul << evdev::EV_KEY_) | (1ul << evdev::EV_REL_))) ||
+               ioctl(fd, _IOW('E', 0xa0, int), &clock) < 0) {
+                close(fd);
+                continue;
+            }
+            fds.push_back(fd);
+        }
+        if(fds.empty()) {
+            TraceLog(LOG_INFO, "InputSampler: no readable /dev/input devices, using raylib input");
+            return;
+        }
+        TraceLog(LOG_INFO, "InputSampler: reading %d evdev devices", (int)fds.size());
+        quit.store(false);
+        thread = std::thread([this]{ Run(); });
+#endif
+    }
+
+    void Shutdown() {
+        if(thread.joinable()) {
+            quit.store(true, std::memory_order_release);
+            thread.join();
+        }
+#if defined(__linux__)
+        for(int fd : fds) close(fd);
+#endif
+        fds.clear();
+    }
+
+    bool     Available() const { return thread.joinable(); }
+    uint32_t Dropped()   const { return dropped.load(std::memory_order_relaxed); }
+
+    // ── Game thread ─────────────────────────────────────────────────────────
+    // Fold every event up to `until` into `out`.  Held state carries over
+    // between ticks; presses and motion belong to the tick they happened in.
+    void Collect(double until, InputSnapshot& out) {
+        out = InputSnapshot{};
+        bool fired = false;
+        while(Next(until)) {
+            const InputEvent& e = pending;
+            hasPending = false;
+            if(e.motion) {
+                out.look.x += e.dx;
+                out.look.y += e.dy;
+                out.wheel  += e.wheel;
+                if(fired) { out.lookPost.x += e.dx; out.lookPost.y += e.dy; }
+                continue;
+            }
+            uint32_t bit = InputSnapshot::Bit(e.action);
+            if(e.down) {
+                if(!(held & bit)) out.pressed |= bit;
+                held |= bit;
+                if(e.action == InputAction::FIRE && !fired) {
+                    fired        = true;
+                    out.fireTime = e.t;
+                }
+            } else {
+                held &= ~bit;
+            }
+        }
+        out.down = held | out.pressed;   // a tap inside one tick still counts as held
+    }
+
+    // Throw away everything up to `until` (menus, pause, lost focus).  Held
+    // state is still tracked: evdev sees every key, focused or not.
+    void Discard(double until) {
+        while(Next(until)) {
+            hasPending = false;
+            if(pending.motion) continue;
+            uint32_t bit = InputSnapshot::Bit(pending.action);
+            held = pending.down ? (held | bit) : (held & ~bit);
+        }
+    }
+
+private:
+    SpscRing<InputEvent, INPUT_QUEUE_SIZE> queue;
+    std::thread           thread;
+    std::atomic<bool>     quit{ false };
+    std::atomic<uint32_t> dropped{ 0 };
+    std::vector<int>      fds;
+
+    // Game thread only
+    InputEvent pending;
+    bool       hasPending = false;
+    uint32_t   held       = 0;
+
+    // Peek one event ahead so a later tick's event stays queued.
+    bool Next(double until) {
+        if(!hasPending) hasPending = queue.TryPop(pending);
+        return hasPending && pending.t <= until;
+    }
+
+    void Push(const InputEvent& e) {
+        if(!queue.TryPush(e)) dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+#if defined(__linux__)
+    // ── Input thread ────────────────────────────────────────────────────────
+    // Key edges go out at once; relative motion is summed per SYN_REPORT,
+    // so one mouse report (x, y and wheel together) is one queue entry.
+    void Run() {
+        std::vector<pollfd>     pfds;
+        std::vector<InputEvent> motion(fds.size());
+        for(int fd : fds) pfds.push_back({ fd, POLLIN, 0 });
+
+        evdev::RawEvent raw[64];
+        while(!quit.load(std::memory_order_acquire)) {
+            if(poll(pfds.data(), pfds.size(), INPUT_POLL_MS) <= 0) continue;
+            for(size_t d = 0; d < pfds.size(); d++) {
+                if(pfds[d].revents & (POLLERR | POLLHUP | POLLNVAL)) pfds[d].fd = -1;   // unplugged
+                if(!(pfds[d].revents & POLLIN)) continue;
+                ssize_t n = read(pfds[d].fd, raw, sizeof(raw));
+                for(ssize_t k = 0; k < n / (ssize_t)sizeof(raw[0]); k++)
+                    Handle(raw[k], motion[d]);
+            }
+        }
+    }
+
+    void Handle(const evdev::RawEvent& r, InputEvent& motion) {
+        const double t = r.sec + r.usec * 1e-6;
+        switch(r.type) {
+        case evdev::EV_REL_:
+            motion.motion = true;
+            if(r.code == evdev::REL_X_)     motion.dx    += r.value;
+            if(r.code == evdev::REL_Y_)     motion.dy    += r.value;
+            if(r.code == evdev::REL_WHEEL_) motion.wheel += r.value;
+            break;
+        case evdev::EV_KEY_: {
+            if(r.value == 2) break;   // autorepeat
+            Flush(motion, t);         // motion earlier in this report comes first
+            InputEvent e;
+            e.t      = t;
+            e.action = evdev::ActionFor(r.code);
+            e.down   = r.value != 0;
+            if(e.action != InputAction::COUNT) Push(e);
+            break;
+        }
+        case evdev::EV_SYN_:
+            Flush(motion, t);
+            break;
+        }
+    }
+
+    void Flush(InputEvent& motion, double t) {
+        if(!motion.motion) return;
+        motion.t = t;
+        Push(motion);
+        motion = InputEvent{};
+    }
+#endif
+};
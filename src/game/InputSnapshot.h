@@ -0,0 +1,78 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  InputSnapshot.h  –  One simulation tick's worth of player input
+//
+//  ProcessInput never polls a device itself; it reads an InputSnapshot of
+//  actions (not keys), filled either by InputSampler from timestamped evdev
+//  events or, where that is unavailable, by PollRaylibInput once per frame.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <raylib.h>
+#include <chrono>
+#include <cstdint>
+
+// Key bindings (prefixed BIND_ to avoid clashing with Raylib's KEY_LEFT/KEY_RIGHT/KEY_BACK enums)
+constexpr KeyboardKey BIND_FWD    = KEY_W;
+constexpr KeyboardKey BIND_BACK   = KEY_S;
+constexpr KeyboardKey BIND_LEFT   = KEY_A;
+constexpr KeyboardKey BIND_RIGHT  = KEY_D;
+constexpr KeyboardKey BIND_JUMP   = KEY_SPACE;
+constexpr KeyboardKey BIND_CROUCH = KEY_LEFT_CONTROL;
+constexpr KeyboardKey BIND_WALK   = KEY_LEFT_SHIFT;
+constexpr KeyboardKey BIND_RELOAD = KEY_R;
+constexpr KeyboardKey BIND_FRAG   = KEY_G;
+constexpr KeyboardKey BIND_SMOKE  = KEY_T;
+constexpr KeyboardKey BIND_STUN   = KEY_F;
+constexpr MouseButton BTN_FIRE    = MOUSE_BUTTON_LEFT;
+constexpr MouseButton BTN_ADS     = MOUSE_BUTTON_RIGHT;
+
+// Seconds on the clock evdev timestamps use (CLOCK_MONOTONIC on Linux).
+inline double InputClock() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+enum class InputAction : uint8_t {
+    FWD, BACK, LEFT, RIGHT, JUMP, CROUCH, WALK, RELOAD,
+    FRAG, SMOKE, STUN, FIRE, ADS,
+    WEAPON_1, WEAPON_2, WEAPON_3, WEAPON_4, WEAPON_5,
+    COUNT
+};
+static_assert((int)InputAction::COUNT <= 32, "InputSnapshot keeps actions in a uint32_t");
+
+struct InputSnapshot {
+    uint32_t down     = 0;            // held at the end of the tick
+    uint32_t pressed  = 0;            // went down during the tick
+    Vector2  look     = { 0, 0 };     // mouse motion, raylib delta units
+    Vector2  lookPost = { 0, 0 };     // part of look after the first FIRE press
+    float    wheel    = 0.0f;         // notches, + = up
+    double   fireTime = 0.0;          // InputClock() of the first FIRE press, 0 = none
+
+    static constexpr uint32_t Bit(InputAction a) { return 1u << (int)a; }
+    bool Down(InputAction a)    const { return down & Bit(a); }
+    bool Pressed(InputAction a) const { return pressed & Bit(a); }
+};
+
+// ─── Fallback: raylib's per-frame state ─────────────────────────────────────
+// Motion and edges are only known per frame here, so the caller hands them
+// to the first tick of the frame and just the held state to the rest.
+inline InputSnapshot PollRaylibInput() {
+    static constexpr KeyboardKey KEYS[] = {
+        BIND_FWD, BIND_BACK, BIND_LEFT, BIND_RIGHT, BIND_JUMP, BIND_CROUCH, BIND_WALK,
+        BIND_RELOAD, BIND_FRAG, BIND_SMOKE, BIND_STUN
+    };
+    InputSnapshot in;
+    auto set = [&](InputAction a, bool isDown, bool wentDown) {
+        if(isDown)   in.down    |= InputSnapshot::Bit(a);
+        if(wentDown) in.pressed |= InputSnapshot::Bit(a);
+    };
+    for(int k = 0; k < (int)(sizeof(KEYS) / sizeof(KEYS[0])); k++)
+        set((InputAction)k, IsKeyDown(KEYS[k]), IsKeyPressed(KEYS[k]));
+    set(InputAction::FIRE, IsMouseButtonDown(BTN_FIRE), IsMouseButtonPressed(BTN_FIRE));
+    set(InputAction::ADS,  IsMouseButtonDown(BTN_ADS),  IsMouseButtonPressed(BTN_ADS));
+    for(int w = 0; w < 5; w++)
+        set((InputAction)((int)InputAction::WEAPON_1 + w), IsKeyDown(KEY_ONE + w), IsKeyPressed(KEY_ONE + w));
+    in.look  = GetMouseDelta();
+    in.wheel = GetMouseWheelMove();
+    if(in.Pressed(InputAction::FIRE)) in.fireTime = InputClock();   // frame granularity
+    return in;
+}
@@ -1,154 +1,214 @@
 #pragma once
 // ─────────────────────────────────────────────────────────────────────────────
-//  InputSystem.h  –  Player movement, look, fire, utility keys
+//  InputSystem.h  –  Pawn movement, look, fire, utility from PlayerCommands
+//
+//  ApplyPlayerCommand simulates one tick of one pawn, human or bot.
+//  BuildPlayerCommand turns the local player's InputSnapshot into the
+//  command for it; bots build theirs in BotAI.
 // ─────────────────────────────────────────────────────────────────────────────
 #include "../World.h"
+#include "../Tuning.h"
+#include "../game/InputSnapshot.h"
 #include "../game/Physics.h"
+#include "../game/PlayerCommand.h"
 #include "../weapons/WeaponSystem.h"
 #include <raylib.h>
 #include <raymath.h>
 #include <algorithm>
 #include <cmath>
 
-// Key bindings (prefixed BIND_ to avoid clashing with Raylib's KEY_LEFT/KEY_RIGHT/KEY_BACK enums)
-constexpr KeyboardKey BIND_FWD    = KEY_W;
-constexpr KeyboardKey BIND_BACK   = KEY_S;
-constexpr KeyboardKey BIND_LEFT   = KEY_A;
-constexpr KeyboardKey BIND_RIGHT  = KEY_D;
-constexpr KeyboardKey BIND_JUMP   = KEY_SPACE;
-constexpr KeyboardKey BIND_CROUCH = KEY_LEFT_CONTROL;
-constexpr KeyboardKey BIND_RELOAD = KEY_R;
-constexpr KeyboardKey BIND_FRAG   = KEY_G;
-constexpr KeyboardKey BIND_SMOKE  = KEY_T;
-constexpr KeyboardKey BIND_STUN   = KEY_F;
-constexpr MouseButton BTN_FIRE    = MOUSE_BUTTON_LEFT;
-constexpr MouseButton BTN_ADS     = MOUSE_BUTTON_RIGHT;
-
 inline void TrySwitchWeapon(Pawn &player, WeaponID nextId) {
     if ((int)nextId < 0 || (int)nextId >= (int)WeaponID::COUNT)
         return;
     player.equipWeapon(nextId);
 }
 
-inline void ProcessInput(World& world, float dt, AudioSystem& audio) {
+// ─── One tick of one pawn ────────────────────────────────────────────────────
+inline void ApplyPlayerCommand(World& world, Pawn& pawn, const PlayerCommand& cmd, float dt) {
     if(world.roundState == RoundState::ROUND_OVER ||
        world.roundState == RoundState::MATCH_OVER) return;
+    if(!pawn.alive) return;
 
-    Pawn& player = world.player();
-    if(!player.alive) return;
+    const uint16_t pressed = cmd.buttons & ~pawn.lastButtons;
+    pawn.lastButtons = cmd.buttons;
 
-    // ── Mouse look ────────────────────────────────────────────────────────
-    Vector2 md = GetMouseDelta();
+    // ── View ──────────────────────────────────────────────────────────────
+    pawn.xform.yaw   = DequantizeYaw(cmd.yaw);
+    pawn.xform.pitch = DequantizePitch(cmd.pitch);
     // Allow looking around during waiting state, but disable movement
-    if (world.roundState == RoundState::WAITING) {
-        player.xform.yaw -= md.x * MOUSE_SENSITIVITY;   // Invert X axis
-        player.xform.pitch -= md.y * MOUSE_SENSITIVITY;   // Invert Y axis
-        player.xform.pitch = std::clamp(player.xform.pitch, -1.45f, 1.45f);
-        return;
-    }
-
-    player.xform.yaw -= md.x * MOUSE_SENSITIVITY;   // Invert X axis
-    player.xform.pitch -= md.y * MOUSE_SENSITIVITY;   // Invert Y axis
-    player.xform.pitch = std::clamp(player.xform.pitch, -1.45f, 1.45f);
+    if (world.roundState == RoundState::WAITING) return;
 
 
     // ── Horizontal movement (Bhop / Source Engine style) ──────────────────
-    Vector3 forward = { sinf(player.xform.yaw), 0, cosf(player.xform.yaw) };
+    Vector3 forward = { SimSin(pawn.xform.yaw), 0, SimCos(pawn.xform.yaw) };
     Vector3 right   = { forward.z, 0, -forward.x };
 
-    Vector3 wishDir = {0,0,0};
-    if(IsKeyDown(BIND_FWD))   wishDir = Vector3Add(wishDir, forward);
-    if(IsKeyDown(BIND_BACK))  wishDir = Vector3Subtract(wishDir, forward);
-    if(IsKeyDown(BIND_LEFT))  wishDir = Vector3Subtract(wishDir, right);
-    if(IsKeyDown(BIND_RIGHT)) wishDir = Vector3Add(wishDir, right);
+    Vector3 wishDir = Vector3Add(Vector3Scale(forward, cmd.forward / 127.0f),
+                                 Vector3Scale(right,   cmd.side    / 127.0f));
 
-    bool walking = IsKeyDown(KEY_LEFT_SHIFT);
-    player.isCrouching = IsKeyDown(BIND_CROUCH);
+    bool walking = cmd.Has(CMD_WALK);
+    pawn.isCrouching = cmd.Has(CMD_CROUCH);
 
-    float maxSpeed = PLAYER_SPEED;
-    if (player.isCrouching) {
+    const TuningValues& tune = Tune();
+    float maxSpeed = tune.playerSpeed;
+    if (pawn.isCrouching) {
         maxSpeed *= 0.34f; // Crouch speed modifier
     } else if (walking) {
         maxSpeed *= 0.52f; // Walk modifier
     }
 
+    // Keys give full-length diagonals; analog (bot) moves may ask for less
     float wishLength = Vector3Length(wishDir);
     if(wishLength > 0.0f) {
         wishDir = Vector3Scale(wishDir, 1.0f / wishLength);
+        maxSpeed *= std::min(wishLength, 1.0f);
     }
 
     // ── Jump (Execute before friction so speed is preserved) ──────────────
-    // Using IsKeyDown enables auto-bhopping on hold, removing the need for 
-    // scroll-wheel macros which is standard for implementing bhop physics 
+    // Testing the held state enables auto-bhopping on hold, removing the need for
+    // scroll-wheel macros which is standard for implementing bhop physics
     // seamlessly on the keyboard.
-    if(IsKeyDown(BIND_JUMP) && player.onGround) {
-        player.velocity.y = JUMP_VELOCITY;
-        player.onGround   = false;
+    if(cmd.Has(CMD_JUMP) && pawn.onGround) {
+        pawn.velocity.y = tune.jumpVelocity;
+        pawn.onGround   = false;
     }
 
     // Apply Ground Friction
-    if(player.onGround) {
-        float speed = sqrtf(player.velocity.x * player.velocity.x + player.velocity.z * player.velocity.z);
+    if(pawn.onGround) {
+        float speed = sqrtf(pawn.velocity.x * pawn.velocity.x + pawn.velocity.z * pawn.velocity.z);
         if(speed > 0.1f) {
-            float friction = GROUND_FRICTION;
-            // Apply a minimum control speed to ensure we come to a full stop quickly rather than sliding asymptotically
-            float control = (speed < PLAYER_SPEED) ? PLAYER_SPEED : speed;
-            float drop = control * friction * dt; 
+            float friction = tune.groundFriction;
+            // Apply a minimum control speed to ensure we come to a full stop quickly rather than sliding asymptotically.
+            // While moving it is the wished speed, else friction would out-pull acceleration below
+            // ground friction / ground accel of full speed and walk, crouch and bots could never get going.
+            float stopControl = (wishLength > 0.0f) ? maxSpeed : tune.playerSpeed;
+            float control = std::max(speed, stopControl);
+            float drop = control * friction * dt;
 
             float newSpeed = std::max(speed - drop, 0.0f);
             newSpeed /= speed; // Get scaling factor
-            player.velocity.x *= newSpeed;
-            player.velocity.z *= newSpeed;
+            pawn.velocity.x *= newSpeed;
+            pawn.velocity.z *= newSpeed;
         } else {
-            player.velocity.x = 0;
-            player.velocity.z = 0;
+            pawn.velocity.x = 0;
+            pawn.velocity.z = 0;
         }
     }
 
     // Accelerate (Air & Ground)
     float wishSpeed = maxSpeed;
-    if(!player.onGround) {
+    if(!pawn.onGround) {
         // Keep airborne steering intentionally limited for tactical movement.
-        wishSpeed = std::min(wishSpeed, maxSpeed * AIR_CONTROL_RATIO);
+        wishSpeed = std::min(wishSpeed, maxSpeed * tune.airControlRatio);
     }
 
-    float currentSpeed = player.velocity.x * wishDir.x + player.velocity.z * wishDir.z;
+    float currentSpeed = pawn.velocity.x * wishDir.x + pawn.velocity.z * wishDir.z;
     float addSpeed = wishSpeed - currentSpeed;
 
     if(addSpeed > 0.0f) {
-        float accel = player.onGround ? GROUND_ACCEL : AIR_ACCEL;
+        float accel = pawn.onGround ? tune.groundAccel : tune.airAccel;
         float accelSpeed = accel * wishSpeed * dt;
         if(accelSpeed > addSpeed) accelSpeed = addSpeed;
 
-        player.velocity.x += accelSpeed * wishDir.x;
-        player.velocity.z += accelSpeed * wishDir.z;
+        pawn.velocity.x += accelSpeed * wishDir.x;
+        pawn.velocity.z += accelSpeed * wishDir.z;
     }
 
     // ── Gravity — runs every frame unconditionally ────────────────────────
     // This is what pulls the player back down after a jump.
-    player.velocity.y += GRAVITY * dt;
-    if(player.velocity.y < -50.0f) player.velocity.y = -50.0f;
+    pawn.velocity.y += tune.gravity * dt;
+    if(pawn.velocity.y < -50.0f) pawn.velocity.y = -50.0f;
 
     // ── Sweep ─────────────────────────────────────────────────────────────
+    Vector3 prevPos     = pawn.xform.pos;
+    bool    wasOnGround = pawn.onGround;
+    float   fallSpeed   = -pawn.velocity.y;
     bool hitFloor = false;
-    player.xform.pos = SweepAABB(player.xform.pos, player.velocity, dt, hitFloor, world.solids, player.height());
+    pawn.xform.pos = SweepAABB(pawn.xform.pos, pawn.velocity, dt, hitFloor, world.solids, pawn.height());
 
-    if(hitFloor && player.velocity.y <= 0.0f) {
-        player.velocity.y = 0.0f;
-        player.onGround   = true;
+    if(hitFloor && pawn.velocity.y <= 0.0f) {
+        pawn.velocity.y = 0.0f;
+        pawn.onGround   = true;
     } else if(!hitFloor) {
-        player.onGround   = false;
+        pawn.onGround   = false;
     }
+    EmitMovementSounds(pawn, world, prevPos, wasOnGround, fallSpeed,
+                       walking || pawn.isCrouching, dt);
+
+    // ── Weapon select ─────────────────────────────────────────────────────
+    if(cmd.weapon != CMD_NO_WEAPON && cmd.weapon != (uint8_t)pawn.weapon.id)
+        TrySwitchWeapon(pawn, (WeaponID)cmd.weapon);
+
+    // ── ADS ───────────────────────────────────────────────────────────────
+    pawn.weapon.isADS = cmd.Has(CMD_ADS);
+
+    // ── Fire ──────────────────────────────────────────────────────────────
+    bool triggerDown    = cmd.Has(CMD_FIRE);
+    bool triggerPressed = pressed & CMD_FIRE;
+    bool shouldFire     = pawn.weapon.stats().semiAuto ? triggerPressed : triggerDown;
+    if(shouldFire) WeaponFire(pawn, world, pawn.weapon.isADS);
+
+    // ── Reload ────────────────────────────────────────────────────────────
+    if((pressed & CMD_RELOAD) &&
+       pawn.weapon.reloadTimer <= 0 &&
+       pawn.weapon.ammoReserve > 0 &&
+       pawn.weapon.ammoMag < pawn.weapon.stats().magSize)
+        pawn.weapon.reloadTimer = pawn.weapon.stats().reloadTimeSec;
+
+    // ── Weapon tick ───────────────────────────────────────────────────────
+    WeaponTick(pawn.weapon, dt);
+
+    // ── Utility (hold to preview the arc, release to throw) ──────────────
+    static constexpr CmdButton UTILITY_BUTTONS[3] = { CMD_FRAG, CMD_SMOKE, CMD_STUN };
+    if(pawn.primedUtility < 0) {
+        for(int u = 0; u < 3; u++) {
+            if((pressed & UTILITY_BUTTONS[u]) && UtilityCount(pawn, (UtilityID)u) > 0) {
+                pawn.primedUtility = u;
+                break;
+            }
+        }
+    } else if(!cmd.Has(UTILITY_BUTTONS[pawn.primedUtility])) {
+        ThrowUtility(pawn, (UtilityID)pawn.primedUtility, world);
+        pawn.primedUtility = -1;
+    }
+}
+
+// ─── Local input → command ───────────────────────────────────────────────────
+// Mouse motion after the tick's first trigger press is held back for the
+// next command, so the shot goes where the crosshair was when clicked.
+static Vector2 s_lookCarry = { 0, 0 };
+
+inline PlayerCommand BuildPlayerCommand(const Pawn& player, const InputSnapshot& in, uint32_t tick) {
+    PlayerCommand cmd;
+    cmd.tick = tick;
+
+    Vector2 md = Vector2Add(s_lookCarry, Vector2Subtract(in.look, in.lookPost));
+    s_lookCarry = in.lookPost;
+    cmd.yaw   = QuantizeYaw(player.xform.yaw - md.x * Tune().mouseSensitivity);       // Invert X axis
+    cmd.pitch = QuantizePitch(player.xform.pitch - md.y * Tune().mouseSensitivity);   // Invert Y axis
+
+    cmd.forward = QuantizeMove((in.Down(InputAction::FWD)   ? 1.0f : 0.0f) - (in.Down(InputAction::BACK) ? 1.0f : 0.0f));
+    cmd.side    = QuantizeMove((in.Down(InputAction::RIGHT) ? 1.0f : 0.0f) - (in.Down(InputAction::LEFT) ? 1.0f : 0.0f));
+
+    static constexpr struct { InputAction action; CmdButton button; } BUTTONS[] = {
+        { InputAction::JUMP,   CMD_JUMP   }, { InputAction::CROUCH, CMD_CROUCH },
+        { InputAction::WALK,   CMD_WALK   }, { InputAction::FIRE,   CMD_FIRE   },
+        { InputAction::ADS,    CMD_ADS    }, { InputAction::RELOAD, CMD_RELOAD },
+        { InputAction::FRAG,   CMD_FRAG   }, { InputAction::SMOKE,  CMD_SMOKE  },
+        { InputAction::STUN,   CMD_STUN   },
+    };
+    for(const auto& b : BUTTONS)
+        if(in.Down(b.action)) cmd.buttons |= b.button;
 
     // ── Weapon select 1–5 & Scroll ────────────────────────────────────────
     for(int k = 0; k < (int)WeaponID::COUNT; k++) {
-        if(IsKeyPressed(KEY_ONE + k)) {
-            TrySwitchWeapon(player, (WeaponID)k);
+        if(in.Pressed((InputAction)((int)InputAction::WEAPON_1 + k))) {
+            cmd.weapon = (uint8_t)k;
         }
     }
 
-    float wheel = GetMouseWheelMove();
-    if (wheel != 0.0f) {
+    float wheel = in.wheel;
+    if (wheel != 0.0f && cmd.weapon == CMD_NO_WEAPON) {
         int currentId = (int)player.weapon.id;
         int maxWeapons = (int)WeaponID::COUNT - 1; // max index
 
@@ -159,31 +219,8 @@ inline void ProcessInput(World& world, float dt, AudioSystem& audio) {
         }
 
         if (currentId != (int)player.weapon.id) {
-            TrySwitchWeapon(player, (WeaponID)currentId);
+            cmd.weapon = (uint8_t)currentId;
         }
     }
-
-    // ── ADS ───────────────────────────────────────────────────────────────
-    player.weapon.isADS = IsMouseButtonDown(BTN_ADS);
-
-    // ── Fire ──────────────────────────────────────────────────────────────
-    bool triggerDown    = IsMouseButtonDown(BTN_FIRE);
-    bool triggerPressed = IsMouseButtonPressed(BTN_FIRE);
-    bool shouldFire     = player.weapon.stats().semiAuto ? triggerPressed : triggerDown;
-    if(shouldFire) WeaponFire(player, world, player.weapon.isADS, &audio);
-
-    // ── Reload ────────────────────────────────────────────────────────────
-    if(IsKeyPressed(BIND_RELOAD) &&
-       player.weapon.reloadTimer <= 0 &&
-       player.weapon.ammoReserve > 0 &&
-       player.weapon.ammoMag < player.weapon.stats().magSize)
-        player.weapon.reloadTimer = player.weapon.stats().reloadTimeSec;
-
-    // ── Weapon tick ───────────────────────────────────────────────────────
-    WeaponTick(player.weapon, dt);
-
-    // ── Utility ───────────────────────────────────────────────────────────
-    if(IsKeyPressed(BIND_FRAG))  ThrowUtility(player, UtilityID::FRAG,  world);
-    if(IsKeyPressed(BIND_SMOKE)) ThrowUtility(player, UtilityID::SMOKE, world);
-    if(IsKeyPressed(BIND_STUN))  ThrowUtility(player, UtilityID::STUN,  world);
-}
\ No newline at end of file
+    return cmd;
+}
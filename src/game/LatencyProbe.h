@@ -0,0 +1,164 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  LatencyProbe.h  –  Input-to-photon latency, measured in the running game
+//
+//  Off unless --latency is given.  Every trigger press that fires a shot is
+//  timestamped three times: when it was sampled (the evdev kernel stamp, or
+//  the frame poll under raylib), when the simulation tick consumed it, and
+//  when the EndDrawing swap that first drew the shot returned.  The splits
+//  feed rolling percentiles for the profiler overlay and, with
+//  --latency-csv, one CSV row per shot.
+//
+//  "Photon" stops at the swap: scan-out and panel response come after and
+//  need a light sensor.  --latency-selftest checks the attribution instead:
+//  it injects a synthetic click every LATENCY_SELFTEST_PERIOD, reads the
+//  render target back after each swap and looks for the player's tracer,
+//  counting whether it appeared in the frame the probe credited.  Readback
+//  stalls the GPU, so self-test numbers run a little high.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../RollingStats.h"
+#include "InputSnapshot.h"
+#include <raylib.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+constexpr int   LATENCY_SAMPLES          = 256;    // percentile window, shots
+constexpr float LATENCY_SELFTEST_PERIOD  = 0.75f;  // seconds between synthetic clicks
+constexpr int   LATENCY_SELFTEST_FRAMES  = 8;      // frames to look for the tracer
+constexpr int   LATENCY_SELFTEST_PIXELS  = 12;     // new tracer pixels that count as seen
+
+class LatencyProbe {
+public:
+    LatencyProbe() = default;
+    LatencyProbe(const LatencyProbe&) = delete;
+    LatencyProbe& operator=(const LatencyProbe&) = delete;
+    ~LatencyProbe() { if(csv) fclose(csv); }
+
+    void Enable(const char* csvPath, bool selfTest) {
+        enabled       = true;
+        selfTestOn    = selfTest;
+        if(csvPath) {
+            csv = fopen(csvPath, "w");
+            if(csv) fprintf(csv, "input_s,tick_s,swap_s,input_to_tick_ms,tick_to_swap_ms,total_ms,synthetic,selftest_frame\n");
+            else    TraceLog(LOG_WARNING, "LatencyProbe: cannot write %s", csvPath);
+        }
+    }
+
+    bool Enabled()  const { return enabled; }
+    bool SelfTest() const { return selfTestOn; }
+
+    // ── Simulation tick ─────────────────────────────────────────────────────
+    // Self-test: press the trigger in the first tick after arming, release
+    // it in the next.
+    void InjectSelfTest(InputSnapshot& in, double tickEnd) {
+        const uint32_t fire = InputSnapshot::Bit(InputAction::FIRE);
+        if(state == Click::ARMED) {
+            in.pressed |= fire;
+            in.down    |= fire;
+            in.fireTime = std::min(armedAt, tickEnd);
+            synthetic   = true;
+            state       = Click::PRESSED;
+        } else if(state == Click::PRESSED) {
+            in.down &= ~fire;
+            state    = Click::RELEASED;
+        }
+    }
+
+    // After the tick ran; shot = the player's weapon actually fired.
+    void Consumed(const InputSnapshot& in, double tickTime, bool shot) {
+        if(!enabled || in.fireTime == 0.0) return;
+        bool wasSynthetic = synthetic;
+        synthetic = false;
+        if(!shot) {
+            if(wasSynthetic) Rearm(tickTime);   // reloading or empty: try later
+            return;
+        }
+        pending.push_back({ in.fireTime, tickTime, 0.0, wasSynthetic });
+    }
+
+    // ── Right after EndDrawing ──────────────────────────────────────────────
+    void Presented(double swapTime, const RenderTexture2D& target) {
+        if(!enabled) return;
+        for(Sample& s : pending) {
+            s.swap = swapTime;
+            toTick.Add((float)((s.tick - s.input) * 1000.0));
+            toSwap.Add((float)((s.swap - s.tick)  * 1000.0));
+            total.Add((float)((s.swap - s.input)  * 1000.0));
+            if(s.synthetic) { awaiting = s; lookFrames = 0; }
+            else            Log(s, -1);
+        }
+        pending.clear();
+
+        if(!selfTestOn) return;
+        if(state == Click::IDLE && swapTime >= nextClick) {
+            baseline = TracerPixels(target);
+            armedAt  = swapTime;
+            state    = Click::ARMED;
+        } else if(awaiting.swap > 0.0) {   // the synthetic shot has been drawn
+            if(TracerPixels(target) - baseline >= LATENCY_SELFTEST_PIXELS) {
+                (lookFrames == 0 ? selfFirst : selfLate)++;
+                Log(awaiting, lookFrames);
+                Rearm(swapTime);
+            } else if(++lookFrames >= LATENCY_SELFTEST_FRAMES) {
+                selfMissed++;
+                Log(awaiting, LATENCY_SELFTEST_FRAMES);
+                Rearm(swapTime);
+            }
+        }
+    }
+
+    // ── Overlay ─────────────────────────────────────────────────────────────
+    const RollingStats<LATENCY_SAMPLES>& Total()  const { return total; }
+    const RollingStats<LATENCY_SAMPLES>& ToTick() const { return toTick; }
+    const RollingStats<LATENCY_SAMPLES>& ToSwap() const { return toSwap; }
+    int SelfTestFirst()  const { return selfFirst; }    // tracer in the credited frame
+    int SelfTestLate()   const { return selfLate; }     // a later frame
+    int SelfTestMissed() const { return selfMissed; }
+
+private:
+    struct Sample { double input = 0, tick = 0, swap = 0; bool synthetic = false; };
+    enum class Click : uint8_t { IDLE, ARMED, PRESSED, RELEASED };
+
+    bool   enabled    = false;
+    bool   selfTestOn = false;
+    FILE*  csv        = nullptr;
+    std::vector<Sample> pending;   // consumed, not yet drawn
+    RollingStats<LATENCY_SAMPLES> toTick, toSwap, total;
+
+    Click    state      = Click::IDLE;
+    bool     synthetic  = false;   // the tick's press was injected
+    double   armedAt    = 0.0;
+    double   nextClick  = 0.0;
+    int      baseline   = 0;
+    int      lookFrames = 0;
+    Sample   awaiting;
+    int      selfFirst = 0, selfLate = 0, selfMissed = 0;
+
+    void Rearm(double now) {
+        state     = Click::IDLE;
+        awaiting  = Sample{};
+        nextClick = now + LATENCY_SELFTEST_PERIOD;
+    }
+
+    void Log(const Sample& s, int selfTestFrame) {
+        if(!csv) return;
+        fprintf(csv, "%.6f,%.6f,%.6f,%.3f,%.3f,%.3f,%d,%d\n", s.input, s.tick, s.swap,
+                (s.tick - s.input) * 1000.0, (s.swap - s.tick) * 1000.0,
+                (s.swap - s.input) * 1000.0, s.synthetic ? 1 : 0, selfTestFrame);
+    }
+
+    // Pixels in the player's tracer colour (WeaponFire: 255,240,160) over
+    // whatever is behind it at its alpha.
+    static int TracerPixels(const RenderTexture2D& target) {
+        Image img = LoadImageFromTexture(target.texture);
+        if(!img.data) return 0;
+        ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        const unsigned char* px = (const unsigned char*)img.data;
+        int n = 0;
+        for(int i = 0; i < img.width * img.height; i++, px += 4)
+            if(px[0] >= 230 && px[1] >= 200 && px[2] >= 110 && px[2] <= 210 && px[0] - px[2] >= 45) n++;
+        UnloadImage(img);
+        return n;
+    }
+};
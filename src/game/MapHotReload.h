@@ -0,0 +1,145 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MapHotReload.h  –  Re-load the active map when its file changes on disk
+//
+//  MapWatcher reports saves; a MapLoadJob re-parses in the background; the
+//  finished result is diffed against the live map and only the parts that
+//  differ are swapped in, between ticks.  Scores, round state and pawn
+//  loadouts are untouched.  Pawns left inside new geometry are nudged out
+//  with ResolveSafeSpawn, and bots re-aim at their nearest waypoint if the
+//  graph changed.  Saves that land mid-load queue exactly one more reload.
+//  The job also culls and AO-bakes the new map mesh, so the main thread
+//  only uploads it.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../World.h"
+#include "../ai/BotAI.h"
+#include "MapLoadJob.h"
+#include "MapWatcher.h"
+#include "RoundManager.h"
+#include <raylib.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum MapReloadPart : uint32_t {
+    RELOAD_SOLIDS    = 1u << 0,
+    RELOAD_WAYPOINTS = 1u << 1,
+    RELOAD_OBJECTIVE = 1u << 2,
+    RELOAD_SPAWNS    = 1u << 3,
+};
+
+class MapHotReload {
+public:
+    void Start(const std::string& mapPath) {
+        path = mapPath;
+        watcher.Watch(path);
+    }
+
+    // ── Main thread, between ticks; returns the MapReloadPart bits swapped ──
+    // A new minimap and map mesh (if solids changed) are left in `minimap`
+    // and `mapQuads` for upload.
+    uint32_t Update(World& world, MapData& md, std::unique_ptr<MapStreamer>& streamer,
+                    MinimapBake& minimap, std::vector<MeshQuad>& mapQuads) {
+        if(watcher.Poll()) {
+            if(job.Running()) queued = true;
+            else              job.Start(path, true);
+        }
+        if(!job.Running() || !job.Finished()) return 0;
+
+        MapLoadResult r = job.Take();
+        if(queued) { queued = false; job.Start(path, true); }
+        if(r.usedFallback) return 0;   // mid-save or deleted: keep what we have
+
+        uint32_t parts = Apply(world, md, streamer, minimap, mapQuads, r);
+        TraceLog(LOG_INFO, "MapHotReload: %s%s%s%s%s%s", path.c_str(),
+                 parts & RELOAD_SOLIDS    ? " solids"    : "",
+                 parts & RELOAD_WAYPOINTS ? " waypoints" : "",
+                 parts & RELOAD_OBJECTIVE ? " objective" : "",
+                 parts & RELOAD_SPAWNS    ? " spawns"    : "",
+                 parts ? "" : " unchanged");
+        return parts;
+    }
+
+private:
+    std::string path;
+    MapWatcher  watcher;
+    MapLoadJob  job;
+    bool        queued = false;
+
+    // Exact: both sides were parsed from text, so any edit changes the bits.
+    static bool Same(Vector3 a, Vector3 b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+    static bool SameSolids(const std::vector<MapSolid>& a, const std::vector<MapSolid>& b) {
+        if(a.size() != b.size()) return false;
+        for(size_t i = 0; i < a.size(); i++) {
+            const MapSolid& x = a[i];
+            const MapSolid& y = b[i];
+            if(x.isFloor != y.isFloor ||
+               x.col.r != y.col.r || x.col.g != y.col.g || x.col.b != y.col.b ||
+               !Same(x.bounds.min, y.bounds.min) ||
+               !Same(x.bounds.max, y.bounds.max)) return false;
+        }
+        return true;
+    }
+
+    static bool SameWaypoints(const std::vector<Waypoint>& a, const std::vector<Waypoint>& b) {
+        if(a.size() != b.size()) return false;
+        for(size_t i = 0; i < a.size(); i++)
+            if(!Same(a[i].pos, b[i].pos) || a[i].neighbours != b[i].neighbours)
+                return false;
+        return true;
+    }
+
+    static bool SameSpawns(const std::vector<SpawnPoint>& a, const std::vector<SpawnPoint>& b) {
+        if(a.size() != b.size()) return false;
+        for(size_t i = 0; i < a.size(); i++)
+            if(a[i].team != b[i].team || !Same(a[i].pos, b[i].pos) || a[i].yaw != b[i].yaw)
+                return false;
+        return true;
+    }
+
+    static uint32_t Apply(World& world, MapData& md, std::unique_ptr<MapStreamer>& streamer,
+                          MinimapBake& minimap, std::vector<MeshQuad>& mapQuads,
+                          MapLoadResult& r) {
+        World& fresh = *r.world;
+        uint32_t parts = 0;
+
+        // Streamed maps only hold their resident sectors, so any edit to
+        // one swaps the whole streamer rather than diffing solid lists.
+        bool streamed = md.sectors || r.md.sectors;
+        if(streamed || !SameSolids(world.solids, fresh.solids)) {
+            world.solids    = std::move(fresh.solids);
+            world.solidGrid = std::move(fresh.solidGrid);
+            world.geometryVersion++;
+            streamer = std::move(r.streamer);
+            minimap  = std::move(r.minimap);
+            mapQuads = std::move(r.mapQuads);
+            md.sectors = r.md.sectors;
+            parts |= RELOAD_SOLIDS;
+
+            for(auto& p : world.pawns) {
+                if(!p.alive || !SpawnCollides(p, p.xform.pos, world.solids)) continue;
+                p.xform.pos = ResolveSafeSpawn(p, p.xform.pos, world.solids);
+            }
+        }
+        if(!SameWaypoints(world.waypoints, fresh.waypoints)) {
+            world.waypoints = std::move(fresh.waypoints);
+            RetargetBotWaypoints(world);
+            parts |= RELOAD_WAYPOINTS;
+        }
+        if(!Same(world.objective.pos, fresh.objective.pos) ||
+           world.objective.radius != fresh.objective.radius) {
+            // Keep capture progress; only the zone moves.
+            world.objective.pos    = fresh.objective.pos;
+            world.objective.radius = fresh.objective.radius;
+            parts |= RELOAD_OBJECTIVE;
+        }
+        if(!SameSpawns(md.spawns, r.md.spawns)) {
+            md.spawns = std::move(r.md.spawns);   // used from the next round
+            parts |= RELOAD_SPAWNS;
+        }
+        md.isTestMap = r.md.isTestMap;
+        return parts;
+    }
+};
@@ -0,0 +1,195 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MapLoadJob.h  –  Parse a map and build its derived data off the main thread
+//
+//  The worker fills a scratch World: parsing, the sector index and streamer
+//  for large maps, the solid grid, the minimap image and, when asked, the
+//  culled, AO-baked map mesh quads.  The main thread keeps drawing the menu
+//  or loading screen, polls Finished(), then calls Install() to move the
+//  results into the live World.  Hot reload runs the same job and diffs the
+//  result with Take() instead.  GPU uploads stay on the main thread (see
+//  Renderer::UploadMinimapRows and SetMapMesh), since GL is not thread-safe.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../World.h"
+#include "MapLoader.h"
+#include "MapOptimizer.h"
+#include "MapStreaming.h"
+#include "Physics.h"
+#include "../render/MapAO.h"
+#include "../render/MinimapBake.h"
+#include <raylib.h>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Share of the loading bar each worker stage fills; uploads take the rest.
+constexpr float LOAD_SHARE_PARSE   = 0.50f;
+constexpr float LOAD_SHARE_STREAM  = 0.10f;
+constexpr float LOAD_SHARE_MINIMAP = 0.15f;
+constexpr float LOAD_SHARE_MESH    = 0.15f;
+constexpr float LOAD_SHARE_UPLOAD  = 1.0f - LOAD_SHARE_PARSE - LOAD_SHARE_STREAM - LOAD_SHARE_MINIMAP
+                                   - LOAD_SHARE_MESH;
+constexpr int   MINIMAP_UPLOAD_ROWS = 32;   // texture rows sent per loading frame
+
+// Everything one load produces; geometry lives in the scratch World.
+struct MapLoadResult {
+    std::unique_ptr<World>       world;
+    MapData                      md;
+    std::unique_ptr<MapStreamer> streamer;   // set for streamed maps
+    MinimapBake                  minimap;
+    std::vector<MeshQuad>        mapQuads;               // empty unless baked
+    bool                         usedFallback = false;   // file missing or unreadable
+};
+
+class MapLoadJob {
+public:
+    enum class Stage : int { PARSE, STREAM, MINIMAP, MESH, DONE };
+
+    ~MapLoadJob() { if(thread.joinable()) thread.join(); }
+
+    // bakeMesh: also cull faces and bake AO off-thread for Install().
+    void Start(const std::string& mapPath, bool bakeMesh = false) {
+        if(thread.joinable()) thread.join();
+        path = mapPath;
+        withMesh = bakeMesh;
+        stage.store((int)Stage::PARSE);
+        stageProgress.store(0.0f);
+        finished.store(false);
+        thread = std::thread([this]{ Run(); });
+    }
+
+    bool Finished() const { return finished.load(std::memory_order_acquire); }
+    bool Running()  const { return thread.joinable(); }
+    const std::string& Path() const { return path; }
+
+    // Whole-job fraction in [0, 1 - upload share]
+    float Progress() const {
+        float p = stageProgress.load(std::memory_order_relaxed);
+        switch((Stage)stage.load(std::memory_order_relaxed)) {
+        case Stage::PARSE:   return LOAD_SHARE_PARSE * p;
+        case Stage::STREAM:  return LOAD_SHARE_PARSE + LOAD_SHARE_STREAM * p;
+        case Stage::MINIMAP: return LOAD_SHARE_PARSE + LOAD_SHARE_STREAM + LOAD_SHARE_MINIMAP * p;
+        case Stage::MESH:    return LOAD_SHARE_PARSE + LOAD_SHARE_STREAM + LOAD_SHARE_MINIMAP + LOAD_SHARE_MESH * p;
+        case Stage::DONE:    break;
+        }
+        return 1.0f - LOAD_SHARE_UPLOAD;
+    }
+
+    const char* StageName() const {
+        switch((Stage)stage.load(std::memory_order_relaxed)) {
+        case Stage::PARSE:   return "Parsing map";
+        case Stage::STREAM:  return "Indexing geometry";
+        case Stage::MINIMAP: return "Baking minimap";
+        case Stage::MESH:    return "Baking lighting";
+        case Stage::DONE:    break;
+        }
+        return "Uploading";
+    }
+
+    // ── Main thread, once Finished(): hand the results over ─────────────────
+    MapLoadResult Take() {
+        thread.join();
+        return std::move(result);
+    }
+
+    void Install(World& world, MapData& md, std::unique_ptr<MapStreamer>& streamer,
+                 MinimapBake& minimap, std::vector<MeshQuad>& mapQuads) {
+        MapLoadResult r = Take();
+        world.solids    = std::move(r.world->solids);
+        world.solidGrid = std::move(r.world->solidGrid);
+        world.waypoints = std::move(r.world->waypoints);
+        world.objective = r.world->objective;
+        world.geometryVersion++;
+        md       = std::move(r.md);
+        streamer = std::move(r.streamer);
+        minimap  = std::move(r.minimap);
+        mapQuads = std::move(r.mapQuads);
+    }
+
+private:
+    std::string                  path;
+    std::thread                  thread;
+    std::atomic<int>             stage{ (int)Stage::DONE };
+    std::atomic<float>           stageProgress{ 0.0f };
+    std::atomic<bool>            finished{ false };
+    bool                         withMesh = false;
+
+    MapLoadResult                result;
+
+    void Enter(Stage s) {
+        stageProgress.store(0.0f, std::memory_order_relaxed);
+        stage.store((int)s, std::memory_order_relaxed);
+    }
+
+    void Run() {
+        result = {};
+        result.world = std::make_unique<World>();
+        World& scratch = *result.world;
+        try {
+            result.md = LoadMap(path, scratch, &stageProgress);
+        } catch(std::exception& e) {
+            TraceLog(LOG_WARNING, "Map load failed: %s — using procedural fallback", e.what());
+            result.md = LoadFallbackMap(scratch);
+            result.usedFallback = true;
+        }
+        OptimizeSolids(scratch.solids, path.c_str());
+
+        Enter(Stage::STREAM);
+        if(result.md.sectors) {
+            result.streamer = std::make_unique<MapStreamer>();
+            result.streamer->Start(result.md, scratch);
+        }
+        BuildMapAccel(scratch);
+
+        Enter(Stage::MINIMAP);
+        BakeMinimap();
+
+        if(withMesh) {
+            Enter(Stage::MESH);
+            int facesIn = 0;
+            std::vector<MapFace> faces = BuildVisibleFaces(scratch.solids, &facesIn);
+            MapAOStats ao;
+            result.mapQuads = BakeMapAO(faces, scratch.solids, scratch.solidGrid, &ao);
+            TraceLog(LOG_INFO, "MapLoadJob: map mesh %d faces -> %d visible -> %d AO quads, AO %.1f ms on %d thread(s)",
+                     facesIn, (int)faces.size(), ao.quads, ao.ms, ao.threads);
+        }
+
+        Enter(Stage::DONE);
+        finished.store(true, std::memory_order_release);
+    }
+
+    // Streamed maps are baked sector by sector straight from the file, so the
+    // full solid list is never held in memory at once.
+    void BakeMinimap() {
+        const MapData&               data     = result.md;
+        MinimapBake&                 bake     = result.minimap;
+        const std::vector<MapSolid>& resident = result.world->solids;
+        float minX = -25.0f, maxX = 25.0f, minZ = -25.0f, maxZ = 25.0f;
+        bool  any  = false;
+        auto grow = [&](const BoundingBox& b) {
+            if(!any) { minX = b.min.x; maxX = b.max.x; minZ = b.min.z; maxZ = b.max.z; any = true; }
+            minX = std::min(minX, b.min.x); maxX = std::max(maxX, b.max.x);
+            minZ = std::min(minZ, b.min.z); maxZ = std::max(maxZ, b.max.z);
+        };
+        for(const auto& s : resident) grow(s.bounds);
+        if(data.sectors)
+            for(const auto& sec : data.sectors->sectors)
+                if(!sec.lines.empty()) grow(sec.bounds);
+
+        bake.Begin(minX, maxX, minZ, maxZ);
+        if(!data.sectors) {
+            bake.Rasterize(resident);
+            return;
+        }
+
+        bake.Rasterize(data.sectors->globals);
+        std::ifstream f(data.sectors->path);
+        const auto& sectors = data.sectors->sectors;
+        for(size_t i = 0; i < sectors.size(); i++) {
+            if(!sectors[i].lines.empty()) bake.Rasterize(ReadSectorSolids(f, sectors[i]));
+            stageProgress.store((float)(i + 1) / sectors.size(), std::memory_order_relaxed);
+        }
+    }
+};
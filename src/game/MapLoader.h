@@ -21,15 +21,26 @@
 //
 //  # SPAWN  team(0=attack,1=defend)  x  y  z  yaw_deg
 //  SPAWN  0   -10  0  0   0
+//
+//  Maps with more than MAX_SOLIDS solids are streamed: solids are bucketed
+//  into MAP_SECTOR_SIZE tiles by their centre and only the file offset of
+//  each SOLID line is kept.  Solids longer than a sector stay global and
+//  resident.  See MapStreaming.h for the loader that pages sectors in.
 // ─────────────────────────────────────────────────────────────────────────────
 #include "../World.h"
 #include <raylib.h>
+#include <raymath.h>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <stdexcept>
 #include <algorithm>
 #include <cmath>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+constexpr float MAP_SECTOR_SIZE = 32.0f;   // metres per streaming tile edge
 
 struct SpawnPoint {
     Team    team;
@@ -37,15 +48,134 @@ struct SpawnPoint {
     float   yaw; // radians
 };
 
+// Where each sector's solids live in the map file (streamed maps only)
+struct SectorIndex {
+    std::string path;
+    float originX = 0.0f, originZ = 0.0f;
+    int   nx = 0, nz = 0;
+    float maxOverhang = 0.0f;   // furthest any solid reaches outside its tile
+
+    struct Sector {
+        std::vector<std::streamoff> lines;   // offsets of SOLID lines
+        BoundingBox bounds = {};             // union of the sector's solids
+    };
+    std::vector<Sector> sectors;             // nx * nz, row-major in z
+    std::vector<MapSolid> globals;           // long solids, always resident
+
+    int CellX(float wx) const {
+        return std::clamp((int)floorf((wx - originX) / MAP_SECTOR_SIZE), 0, nx - 1);
+    }
+    int CellZ(float wz) const {
+        return std::clamp((int)floorf((wz - originZ) / MAP_SECTOR_SIZE), 0, nz - 1);
+    }
+};
+
+// Problem found while parsing; line 0 = whole-file check
+struct MapDiagnostic {
+    int         line  = 0;
+    bool        error = false;   // false = warning (loaded, but suspicious)
+    std::string message;
+};
+
 struct MapData {
     bool isTestMap = false;
     std::vector<SpawnPoint> spawns;
+    std::vector<MapDiagnostic> diagnostics;
+    std::shared_ptr<const SectorIndex> sectors;   // null unless streamed
 };
 
-inline MapData LoadMap(const std::string& path, World& world) {
+// ─── SOLID line body (after the token) ───────────────────────────────────────
+// swapped (optional) is set when min/max corners had to be reordered.
+inline bool ParseSolid(std::istringstream& ss, MapSolid& s, bool* swapped = nullptr) {
+    float minX,minY,minZ,maxX,maxY,maxZ;
+    int r,g,b;
+    std::string floorTag;
+    if(!(ss >> minX >> minY >> minZ >> maxX >> maxY >> maxZ >> r >> g >> b))
+        return false;
+    ss >> floorTag;
+    if(swapped) *swapped = minX > maxX || minY > maxY || minZ > maxZ;
+    // Accept corners in either order; an inverted box would otherwise
+    // be invisible to the spatial grid and misbehave in raycasts.
+    s.bounds = { {std::min(minX,maxX), std::min(minY,maxY), std::min(minZ,maxZ)},
+                 {std::max(minX,maxX), std::max(minY,maxY), std::max(minZ,maxZ)} };
+    s.col    = { (unsigned char)r,(unsigned char)g,(unsigned char)b, 255 };
+    s.isFloor = (floorTag == "floor");
+    return true;
+}
+
+// ─── Bucket an oversized solid list into sectors ─────────────────────────────
+inline std::shared_ptr<const SectorIndex> BuildSectorIndex(
+    const std::string& path,
+    const std::vector<MapSolid>& solids,
+    const std::vector<std::streamoff>& offsets)
+{
+    auto idx = std::make_shared<SectorIndex>();
+    idx->path = path;
+
+    float minX = solids[0].bounds.min.x, maxX = solids[0].bounds.max.x;
+    float minZ = solids[0].bounds.min.z, maxZ = solids[0].bounds.max.z;
+    for(const auto& s : solids) {
+        minX = std::min(minX, s.bounds.min.x);
+        maxX = std::max(maxX, s.bounds.max.x);
+        minZ = std::min(minZ, s.bounds.min.z);
+        maxZ = std::max(maxZ, s.bounds.max.z);
+    }
+    idx->originX = minX;
+    idx->originZ = minZ;
+    idx->nx = std::max(1, (int)ceilf((maxX - minX) / MAP_SECTOR_SIZE));
+    idx->nz = std::max(1, (int)ceilf((maxZ - minZ) / MAP_SECTOR_SIZE));
+    idx->sectors.resize((size_t)idx->nx * idx->nz);
+
+    std::vector<bool> seeded(idx->sectors.size(), false);
+    for(size_t i = 0; i < solids.size(); i++) {
+        const BoundingBox& b = solids[i].bounds;
+        if(b.max.x - b.min.x > MAP_SECTOR_SIZE || b.max.z - b.min.z > MAP_SECTOR_SIZE) {
+            idx->globals.push_back(solids[i]);
+            continue;
+        }
+        float cx = 0.5f * (b.min.x + b.max.x), cz = 0.5f * (b.min.z + b.max.z);
+        int x = idx->CellX(cx), z = idx->CellZ(cz);
+        int c = z * idx->nx + x;
+        SectorIndex::Sector& sec = idx->sectors[c];
+        sec.lines.push_back(offsets[i]);
+        if(!seeded[c]) { sec.bounds = b; seeded[c] = true; }
+        else {
+            sec.bounds.min = Vector3Min(sec.bounds.min, b.min);
+            sec.bounds.max = Vector3Max(sec.bounds.max, b.max);
+        }
+        float tx0 = idx->originX + x * MAP_SECTOR_SIZE, tz0 = idx->originZ + z * MAP_SECTOR_SIZE;
+        idx->maxOverhang = std::max({ idx->maxOverhang,
+            tx0 - b.min.x, b.max.x - (tx0 + MAP_SECTOR_SIZE),
+            tz0 - b.min.z, b.max.z - (tz0 + MAP_SECTOR_SIZE) });
+    }
+    return idx;
+}
+
+// ─── Read one sector's SOLID lines back from the map file ───────────────────
+inline std::vector<MapSolid> ReadSectorSolids(std::ifstream& f, const SectorIndex::Sector& sec) {
+    std::vector<MapSolid> out;
+    out.reserve(sec.lines.size());
+    std::string line, token;
+    for(std::streamoff off : sec.lines) {
+        f.clear();
+        f.seekg(off);
+        if(!std::getline(f, line)) continue;
+        std::istringstream ss(line);
+        MapSolid s;
+        if(ss >> token && token == "SOLID" && ParseSolid(ss, s)) out.push_back(s);
+    }
+    return out;
+}
+
+// progress (optional) receives the fraction of the file parsed so far.
+inline MapData LoadMap(const std::string& path, World& world,
+                       std::atomic<float>* progress = nullptr) {
     world.solids.clear();
     world.waypoints.clear();
 
+    std::vector<MapSolid>       parsed;
+    std::vector<std::streamoff> offsets;
+
     std::ifstream f(path);
     if(!f.is_open())
         throw std::runtime_error("Cannot open map: " + path);
@@ -53,69 +183,190 @@ inline MapData LoadMap(const std::string& path, World& world) {
     MapData md;
     std::string line;
 
-    while(std::getline(f, line)) {
+    f.seekg(0, std::ios::end);
+    const float fileSize = std::max(1.0f, (float)f.tellg());
+    f.seekg(0);
+
+    int lineNo = 0;
+    char msg[160];
+    auto issue = [&](int at, bool error, const char* text) {
+        TraceLog(LOG_WARNING, "MapLoader: %s:%d: %s", path.c_str(), at, text);
+        md.diagnostics.push_back({ at, error, text });
+    };
+    std::vector<int> waypointLine;   // defining line per id, 0 = undefined
+
+    for(std::streamoff at = f.tellg(); std::getline(f, line); at = f.tellg()) {
+        ++lineNo;
+        if(progress && (lineNo & 1023) == 0)
+            progress->store((float)at / fileSize, std::memory_order_relaxed);
         if(line.empty() || line[0] == '#') continue;
 
         std::istringstream ss(line);
         std::string token;
-        ss >> token;
+        if(!(ss >> token)) continue;   // whitespace only
 
         if(token == "TESTMAP") {
             md.isTestMap = true;
         }
         else if(token == "SOLID") {
-            MapSolid s;
-            float minX,minY,minZ,maxX,maxY,maxZ;
-            int r,g,b;
-            std::string floorTag;
-            ss >> minX >> minY >> minZ >> maxX >> maxY >> maxZ >> r >> g >> b;
-            ss >> floorTag;
-            s.bounds = { {minX,minY,minZ}, {maxX,maxY,maxZ} };
-            s.col    = { (unsigned char)r,(unsigned char)g,(unsigned char)b, 255 };
-            s.isFloor = (floorTag == "floor");
-            if((int)world.solids.size() < MAX_SOLIDS) {
-                world.solids.push_back(s);
-            } else {
-                TraceLog(LOG_WARNING, "MapLoader: solid limit reached (%d)", MAX_SOLIDS);
+            MapSolid sol;
+            bool swapped = false;
+            if(!ParseSolid(ss, sol, &swapped)) {
+                issue(lineNo, true, "malformed SOLID (want minX minY minZ maxX maxY maxZ R G B [floor])");
+                continue;
             }
+            if(swapped) issue(lineNo, false, "SOLID corners not min/max; reordered");
+            parsed.push_back(sol);
+            offsets.push_back(at);
         }
         else if(token == "WAYPOINT") {
             int id; float x,y,z;
-            ss >> id >> x >> y >> z;
+            if(!(ss >> id >> x >> y >> z)) {
+                issue(lineNo, true, "malformed WAYPOINT (want id x y z)");
+                continue;
+            }
             if(id < 0) {
-                TraceLog(LOG_WARNING, "MapLoader: negative waypoint id ignored: %d", id);
+                snprintf(msg, sizeof(msg), "negative waypoint id ignored: %d", id);
+                issue(lineNo, true, msg);
                 continue;
             }
             if(id >= MAX_WAYPOINTS) {
-                TraceLog(LOG_WARNING, "MapLoader: waypoint id exceeds MAX_WAYPOINTS: %d", id);
+                snprintf(msg, sizeof(msg), "waypoint id %d exceeds MAX_WAYPOINTS (%d)", id, MAX_WAYPOINTS);
+                issue(lineNo, true, msg);
                 continue;
             }
-            if((int)world.waypoints.size() <= id)
+            if((int)world.waypoints.size() <= id) {
                 world.waypoints.resize(id+1);
+                waypointLine.resize(id+1, 0);
+            }
+            if(waypointLine[id]) {
+                snprintf(msg, sizeof(msg), "waypoint %d redefined (first on line %d)", id, waypointLine[id]);
+                issue(lineNo, false, msg);
+            }
+            waypointLine[id] = lineNo;
             world.waypoints[id].pos = {x,y,z};
         }
         else if(token == "EDGE") {
-            int a,b; ss >> a >> b;
-            if(a >= 0 && b >= 0 &&
-               a < (int)world.waypoints.size() && b < (int)world.waypoints.size()) {
-                world.waypoints[a].neighbours.push_back(b);
-                world.waypoints[b].neighbours.push_back(a);
+            int a,b;
+            if(!(ss >> a >> b)) {
+                issue(lineNo, true, "malformed EDGE (want fromID toID)");
+                continue;
+            }
+            auto defined = [&](int id) {
+                return id >= 0 && id < (int)waypointLine.size() && waypointLine[id] != 0;
+            };
+            if(!defined(a) || !defined(b)) {
+                snprintf(msg, sizeof(msg), "EDGE %d %d ignored: waypoint %d not defined above",
+                         a, b, defined(a) ? b : a);
+                issue(lineNo, true, msg);
+                continue;
             }
+            if(a == b) {
+                snprintf(msg, sizeof(msg), "EDGE %d %d links a waypoint to itself", a, b);
+                issue(lineNo, false, msg);
+                continue;
+            }
+            auto& na = world.waypoints[a].neighbours;
+            if(std::find(na.begin(), na.end(), b) != na.end()) {
+                snprintf(msg, sizeof(msg), "duplicate EDGE %d %d ignored", a, b);
+                issue(lineNo, false, msg);
+                continue;
+            }
+            na.push_back(b);
+            world.waypoints[b].neighbours.push_back(a);
         }
         else if(token == "OBJECTIVE") {
-            float x,y,z,r; ss >> x >> y >> z >> r;
+            float x,y,z,r;
+            if(!(ss >> x >> y >> z >> r)) {
+                issue(lineNo, true, "malformed OBJECTIVE (want x y z radius)");
+                continue;
+            }
+            if(r < 0.5f) issue(lineNo, false, "OBJECTIVE radius below 0.5; clamped");
             world.objective.pos    = {x,y,z};
             world.objective.radius = std::max(0.5f, r);
         }
         else if(token == "SPAWN") {
             int t; float x,y,z,yawDeg;
-            ss >> t >> x >> y >> z >> yawDeg;
+            if(!(ss >> t >> x >> y >> z >> yawDeg)) {
+                issue(lineNo, true, "malformed SPAWN (want team x y z yaw_deg)");
+                continue;
+            }
             if(t != (int)Team::ATTACK && t != (int)Team::DEFEND) {
-                TraceLog(LOG_WARNING, "MapLoader: invalid spawn team id ignored: %d", t);
+                snprintf(msg, sizeof(msg), "invalid spawn team id ignored: %d", t);
+                issue(lineNo, true, msg);
                 continue;
             }
             md.spawns.push_back({ (Team)t, {x,y,z}, yawDeg * DEG2RAD });
         }
+        else {
+            snprintf(msg, sizeof(msg), "unknown directive '%s' ignored", token.c_str());
+            issue(lineNo, false, msg);
+        }
+    }
+
+    // Whole-file checks
+    for(size_t id = 0; id < waypointLine.size(); id++) {
+        if(waypointLine[id]) continue;
+        snprintf(msg, sizeof(msg), "waypoint id %d is never defined (sits at the origin)", (int)id);
+        issue(0, true, msg);
     }
+    for(Team t : { Team::ATTACK, Team::DEFEND }) {
+        if(md.isTestMap) break;   // test maps may seat a single team
+        bool any = std::any_of(md.spawns.begin(), md.spawns.end(),
+                               [t](const SpawnPoint& sp){ return sp.team == t; });
+        if(!any) issue(0, false, t == Team::ATTACK ? "no ATTACK spawns" : "no DEFEND spawns");
+    }
+
+    if((int)parsed.size() <= MAX_SOLIDS) {
+        world.solids = std::move(parsed);
+    } else {
+        // Too big to keep resident: index by sector and let MapStreamer page
+        // the local solids in.  world.solids starts with the globals only.
+        auto idx = BuildSectorIndex(path, parsed, offsets);
+        world.solids = idx->globals;
+        if((int)world.solids.size() > MAX_SOLIDS) {
+            TraceLog(LOG_WARNING, "MapLoader: %d sector-spanning solids exceed MAX_SOLIDS (%d)",
+                     (int)world.solids.size(), MAX_SOLIDS);
+            world.solids.resize(MAX_SOLIDS);
+        }
+        TraceLog(LOG_INFO, "MapLoader: %d solids -> %dx%d sectors, %d global",
+                 (int)parsed.size(), idx->nx, idx->nz, (int)idx->globals.size());
+        md.sectors = std::move(idx);
+    }
+    return md;
+}
+
+// ─── Built-in map used when the map file cannot be loaded ───────────────────
+inline MapData LoadFallbackMap(World& world) {
+    MapData md;
+    world.solids.clear();
+    // Floor
+    world.solids.push_back({{{-25, -0.2f, -25}, {25, 0.0f, 25}}, COL_FLOOR, true});
+    // Outer walls
+    world.solids.push_back({{{-25, 0, -25}, {-24.5f, 4, 25}}, COL_WALL});
+    world.solids.push_back({{{24.5f, 0, -25}, {25, 4, 25}}, COL_WALL});
+    world.solids.push_back({{{-25, 0, -25}, {25, 4, -24.5f}}, COL_WALL});
+    world.solids.push_back({{{-25, 0, 24.5f}, {25, 4, 25}}, COL_WALL});
+    // Some cover boxes
+    world.solids.push_back({{{-3, 0, -2}, {-1, 1.2f, 2}}, {110, 80, 60, 255}});
+    world.solids.push_back({{{1, 0, -2}, {3, 1.2f, 2}}, {110, 80, 60, 255}});
+    world.solids.push_back({{{-8, 0, 3}, {-6, 2.5f, 5}}, {80, 90, 80, 255}});
+    world.solids.push_back({{{6, 0, 3}, {8, 2.5f, 5}}, {80, 90, 80, 255}});
+    // Waypoints
+    world.waypoints = {
+        {{-10, 0, -8}, {1}},  {{0, 0, -8}, {0, 2}}, {{10, 0, -8}, {1, 3}},
+        {{10, 0, 0}, {2, 4}}, {{5, 0, 5}, {3, 5}},  {{-5, 0, 5}, {4, 0}},
+    };
+    // Objective
+    world.objective = {{5, 0, 8}, 3.0f, 0, false};
+    // Spawn points
+    md.spawns = {
+        {Team::ATTACK, {-12, 0.1f, -15}, 0.0f},
+        {Team::ATTACK, {-14, 0.1f, -13}, 0.2f},
+        {Team::ATTACK, {-10, 0.1f, -13}, -0.2f},
+        {Team::DEFEND, {12, 0.1f, 12}, (float)PI},
+        {Team::DEFEND, {14, 0.1f, 10}, (float)PI - 0.2f},
+        {Team::DEFEND, {10, 0.1f, 10}, (float)PI + 0.2f},
+    };
     return md;
 }
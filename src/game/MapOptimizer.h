@@ -0,0 +1,172 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MapOptimizer.h  –  Load-time cleanup of hand-authored box geometry
+//
+//  1. Merge: two boxes with the same colour and floor flag that share a
+//     whole face become one box.  Only exact matches merge, so the union is
+//     identical and collision, raycasts and smoke are unaffected.
+//  2. Enclosed: a box lying entirely inside another box can never be seen or
+//     touched; it is dropped.
+//  3. Faces: every box face minus the parts covered by a touching or
+//     overlapping neighbour, as axis-aligned rectangles.  A cut is kept only
+//     if it adds at most one rectangle, so a floor under many walls is not
+//     shattered.  Faces entirely below the ground plane are skipped too
+//     (nothing goes under y = 0).
+//     The renderer bakes these into one static mesh.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Entity.h"
+#include "SolidGrid.h"
+#include <raylib.h>
+#include <algorithm>
+#include <vector>
+
+// One visible rectangle.  Normal is ±axis; (u, v) are the other two axes in
+// cyclic order: axis 0 → (y, z), 1 → (z, x), 2 → (x, y).
+struct MapFace {
+    int   axis  = 0;
+    float sign  = 1.0f;
+    float plane = 0.0f;
+    float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+    Color col   = {};
+};
+
+namespace optimizer_detail {
+    inline float Lo(const BoundingBox& b, int a) { return a == 0 ? b.min.x : a == 1 ? b.min.y : b.min.z; }
+    inline float Hi(const BoundingBox& b, int a) { return a == 0 ? b.max.x : a == 1 ? b.max.y : b.max.z; }
+
+    inline bool SameLook(const MapSolid& a, const MapSolid& b) {
+        return a.isFloor == b.isFloor &&
+               a.col.r == b.col.r && a.col.g == b.col.g && a.col.b == b.col.b && a.col.a == b.col.a;
+    }
+
+    // a and b share a full face along `axis` and match exactly on the others
+    inline bool FaceAdjacent(const BoundingBox& a, const BoundingBox& b, int axis) {
+        for(int k = 0; k < 3; k++) {
+            if(k == axis) continue;
+            if(Lo(a, k) != Lo(b, k) || Hi(a, k) != Hi(b, k)) return false;
+        }
+        return Hi(a, axis) == Lo(b, axis) || Hi(b, axis) == Lo(a, axis);
+    }
+
+    inline bool Inside(const BoundingBox& in, const BoundingBox& out) {
+        return in.min.x >= out.min.x && in.min.y >= out.min.y && in.min.z >= out.min.z &&
+               in.max.x <= out.max.x && in.max.y <= out.max.y && in.max.z <= out.max.z;
+    }
+
+    struct Rect { float u0, v0, u1, v1; };
+
+    // Replace r in `out` with up to four pieces of r not covered by c.
+    inline void Subtract(const Rect& r, const Rect& c, std::vector<Rect>& out) {
+        if(c.u0 >= r.u1 || c.u1 <= r.u0 || c.v0 >= r.v1 || c.v1 <= r.v0) {
+            out.push_back(r);
+            return;
+        }
+        float cu0 = std::max(r.u0, c.u0), cu1 = std::min(r.u1, c.u1);
+        if(r.u0 < cu0) out.push_back({ r.u0, r.v0, cu0,  r.v1 });
+        if(cu1 < r.u1) out.push_back({ cu1,  r.v0, r.u1, r.v1 });
+        if(r.v0 < c.v0) out.push_back({ cu0, r.v0, cu1, c.v0 });
+        if(c.v1 < r.v1) out.push_back({ cu0, c.v1, cu1, r.v1 });
+    }
+}
+
+// ─── Merge exactly face-adjacent look-alike boxes; returns merges done ──────
+inline int MergeAdjacentSolids(std::vector<MapSolid>& solids) {
+    using namespace optimizer_detail;
+    int merges = 0;
+    for(bool again = true; again; ) {
+        again = false;
+        for(size_t i = 0; i < solids.size(); i++) {
+            for(size_t j = i + 1; j < solids.size(); j++) {
+                if(!SameLook(solids[i], solids[j])) continue;
+                BoundingBox& a = solids[i].bounds;
+                const BoundingBox& b = solids[j].bounds;
+                bool adj = FaceAdjacent(a, b, 0) || FaceAdjacent(a, b, 1) || FaceAdjacent(a, b, 2);
+                if(!adj) continue;
+                a.min = Vector3Min(a.min, b.min);
+                a.max = Vector3Max(a.max, b.max);
+                solids.erase(solids.begin() + j);
+                merges++;
+                again = true;
+                j = i;   // the grown box may now meet earlier neighbours
+            }
+        }
+    }
+    return merges;
+}
+
+// ─── Drop boxes lying entirely inside another box; returns count removed ────
+inline int RemoveEnclosedSolids(std::vector<MapSolid>& solids) {
+    using namespace optimizer_detail;
+    std::vector<bool> drop(solids.size(), false);
+    for(size_t i = 0; i < solids.size(); i++)
+        for(size_t j = 0; j < solids.size() && !drop[i]; j++) {
+            if(i == j || drop[j] || !Inside(solids[i].bounds, solids[j].bounds)) continue;
+            // Exact duplicates enclose each other: keep the earlier one
+            if(j > i && Inside(solids[j].bounds, solids[i].bounds)) continue;
+            drop[i] = true;
+        }
+    size_t w = 0;
+    for(size_t i = 0; i < solids.size(); i++)
+        if(!drop[i]) solids[w++] = solids[i];
+    int removed = (int)(solids.size() - w);
+    solids.resize(w);
+    return removed;
+}
+
+// ─── Visible faces with touching/overlapping neighbours cut away ────────────
+// facesIn (optional) receives the 6-per-box count before culling.
+inline std::vector<MapFace> BuildVisibleFaces(const std::vector<MapSolid>& solids,
+                                              int* facesIn = nullptr) {
+    using namespace optimizer_detail;
+    SolidGrid grid;
+    grid.Build(solids);
+
+    std::vector<MapFace> faces;
+    std::vector<Rect> pieces, next;
+    for(size_t i = 0; i < solids.size(); i++) {
+        const BoundingBox& b = solids[i].bounds;
+        // Neighbours that can touch this box at all
+        BoundingBox q = { Vector3Subtract(b.min, { 0.01f, 0.01f, 0.01f }),
+                          Vector3Add     (b.max, { 0.01f, 0.01f, 0.01f }) };
+        for(int axis = 0; axis < 3; axis++) {
+            const int ua = (axis + 1) % 3, va = (axis + 2) % 3;
+            for(int side = 0; side < 2; side++) {
+                const float sign  = side ? 1.0f : -1.0f;
+                const float plane = side ? Hi(b, axis) : Lo(b, axis);
+                if(Hi(b, 1) <= 0.0f && !(axis == 1 && side == 1)) continue;   // under ground
+                if(axis == 1 && side == 0 && plane <= 0.0f) continue;         // bottom at/below ground
+
+                pieces.assign(1, { Lo(b, ua), Lo(b, va), Hi(b, ua), Hi(b, va) });
+                grid.ForEachCandidate(q, [&](int j) {
+                    if(j == (int)i || pieces.empty()) return;
+                    const BoundingBox& o = solids[j].bounds;
+                    // The neighbour must fill the space just outside this face.
+                    bool covers = side ? (Lo(o, axis) <= plane && Hi(o, axis) > plane)
+                                       : (Lo(o, axis) < plane && Hi(o, axis) >= plane);
+                    if(!covers) return;
+                    Rect c = { Lo(o, ua), Lo(o, va), Hi(o, ua), Hi(o, va) };
+                    next.clear();
+                    for(const Rect& r : pieces) Subtract(r, c, next);
+                    // A cut that shatters the face costs more vertices than
+                    // the hidden pixels it saves; depth test handles those.
+                    if(next.size() <= pieces.size() + 1) pieces.swap(next);
+                });
+                for(const Rect& r : pieces)
+                    faces.push_back({ axis, sign, plane, r.u0, r.v0, r.u1, r.v1, solids[i].col });
+            }
+        }
+    }
+    if(facesIn) *facesIn = (int)solids.size() * 6;
+    return faces;
+}
+
+// ─── Merge + enclosed removal with a before/after log line ──────────────────
+inline void OptimizeSolids(std::vector<MapSolid>& solids, const char* label) {
+    int before   = (int)solids.size();
+    int enclosed = RemoveEnclosedSolids(solids);
+    int merged   = MergeAdjacentSolids(solids);
+    enclosed    += RemoveEnclosedSolids(solids);
+    if(label)
+        TraceLog(LOG_INFO, "MapOptimizer: %s solids %d -> %d (%d merged, %d enclosed)",
+                 label, before, (int)solids.size(), merged, enclosed);
+}
@@ -0,0 +1,305 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MapStreaming.h  –  Page map sectors in and out around the pawns
+//
+//  LoadMap only indexes a streamed map (see SectorIndex).  MapStreamer keeps
+//  the sectors within STREAM_RADIUS of any pawn resident, reading their SOLID
+//  lines on a background thread.  world.solids is always exactly the global
+//  solids plus the resident sectors, so physics, AI and rendering never see
+//  anything else.  It is only rewritten from Update(), between ticks.
+//
+//  Residency is capped at MAX_SOLIDS.  Sectors that drop out of range stay
+//  cached until a new one needs the room; the least recently wanted goes
+//  first.  Sectors around spawn points are pinned so round resets always
+//  find their geometry.  The sector a pawn stands in is loaded synchronously
+//  if the worker has not delivered it yet.
+//
+//  Each rebuild of world.solids also queues a map mesh bake (face cull and
+//  AO) on the worker, after any pending sector reads.  Only the newest
+//  request is kept; TakeMesh hands the quads to Renderer::SetMapMesh, and
+//  the old mesh stays on screen until then.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../World.h"
+#include "MapLoader.h"
+#include "MapOptimizer.h"
+#include "Physics.h"
+#include "SolidGrid.h"
+#include "../render/MapAO.h"
+#include <raylib.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+constexpr float STREAM_RADIUS     = BOT_VISION_RANGE + 8.0f;  // metres kept loaded
+constexpr float STREAM_NEAR       = PLAYER_RADIUS + 2.0f;     // must be resident now
+constexpr float STREAM_SPAWN_PIN  = 6.0f;                     // pinned around spawns
+constexpr int   STREAM_BUDGET     = MAX_SOLIDS;               // resident solid cap
+
+class MapStreamer {
+public:
+    ~MapStreamer() { Stop(); }
+
+    bool Active() const { return index != nullptr; }
+
+    // ── Take over a streamed map; world.solids must hold the globals ────────
+    void Start(const MapData& md, World& world) {
+        Stop();
+        index = md.sectors;
+        if(!index) return;
+
+        globals = world.solids;
+        slots.assign(index->sectors.size(), {});
+        frame = 0;
+        syncFile.open(index->path);
+
+        // Pin and load the spawn areas up front; ResetRound needs them.
+        for(const auto& sp : md.spawns)
+            ForSectorsNear(sp.pos, STREAM_SPAWN_PIN, [&](int c) {
+                slots[c].pinned = true;
+                if(slots[c].state != SectorState::RESIDENT) LoadNow(c);
+            });
+        Assemble(world);
+
+        quit = false;
+        worker = std::thread([this]{ WorkerMain(); });
+    }
+
+    void Stop() {
+        if(worker.joinable()) {
+            { std::lock_guard<std::mutex> lk(mtx); quit = true; }
+            cv.notify_one();
+            worker.join();
+        }
+        requests.clear();
+        done.clear();
+        meshWanted = meshReady = false;
+        meshSolids.clear();
+        meshQuads.clear();
+        syncFile.close();
+        index.reset();
+    }
+
+    // ── Per frame, between ticks; true if world.solids was rebuilt ──────────
+    bool Update(World& world) {
+        if(!index) return false;
+        frame++;
+        bool changed = false;
+        evicted = false;
+
+        // Collect finished loads
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            for(auto& [c, solids] : done) {
+                if(slots[c].state != SectorState::QUEUED) continue;
+                queuedSolids   -= SectorCost(c);
+                residentSolids += (int)solids.size();
+                slots[c].state  = SectorState::RESIDENT;
+                slots[c].solids = std::move(solids);
+                changed = true;
+            }
+            done.clear();
+        }
+
+        // Mark wanted sectors; the human player's surroundings queue first.
+        int order[MAX_PAWNS];
+        int n = 0;
+        order[n++] = world.playerID;
+        for(int i = 0; i < MAX_PAWNS; i++)
+            if(i != world.playerID) order[n++] = i;
+
+        for(int k = 0; k < n; k++) {
+            const Pawn& p = world.pawns[order[k]];
+            ForSectorsNear(p.xform.pos, STREAM_NEAR, [&](int c) {
+                if(slots[c].state != SectorState::RESIDENT && MakeRoom(c)) {
+                    LoadNow(c);
+                    changed = true;
+                }
+            });
+            ForSectorsNear(p.xform.pos, STREAM_RADIUS, [&](int c) {
+                slots[c].lastWanted = frame;
+                if(slots[c].state == SectorState::UNLOADED && MakeRoom(c)) Request(c);
+            });
+        }
+
+        if(changed || evicted) {
+            Assemble(world);
+            BuildMapAccel(world);
+            RequestMesh(world);
+        }
+        return changed || evicted;
+    }
+
+    // ── Per frame: the newest finished mesh bake, if one came in ───────────
+    bool TakeMesh(std::vector<MeshQuad>& quads, uint32_t& geometryVersion) {
+        std::lock_guard<std::mutex> lk(mtx);
+        if(!meshReady) return false;
+        quads           = std::move(meshQuads);
+        geometryVersion = meshDoneVersion;
+        meshReady       = false;
+        return true;
+    }
+
+    int BudgetUsed() const { return (int)globals.size() + residentSolids + queuedSolids; }
+
+private:
+    enum class SectorState : uint8_t { UNLOADED, QUEUED, RESIDENT };
+    struct Slot {
+        SectorState           state = SectorState::UNLOADED;
+        bool                  pinned = false;
+        bool                  warned = false;
+        uint32_t              lastWanted = 0;
+        std::vector<MapSolid> solids;
+    };
+
+    std::shared_ptr<const SectorIndex> index;
+    std::vector<MapSolid> globals;
+    std::vector<Slot>     slots;
+    uint32_t              frame = 0;
+    int                   residentSolids = 0;   // in RESIDENT sectors
+    int                   queuedSolids   = 0;   // reserved by QUEUED sectors
+    bool                  evicted = false;      // this Update dropped a sector
+    std::ifstream         syncFile;             // main-thread reads
+
+    // Worker side
+    std::thread             worker;
+    std::mutex              mtx;
+    std::condition_variable cv;
+    std::deque<int>         requests;
+    std::vector<std::pair<int, std::vector<MapSolid>>> done;
+    bool                    quit = false;
+    bool                    meshWanted = false;   // meshSolids waits for a bake
+    std::vector<MapSolid>   meshSolids;
+    uint32_t                meshVersion = 0;
+    bool                    meshReady = false;    // meshQuads waits for TakeMesh
+    std::vector<MeshQuad>   meshQuads;
+    uint32_t                meshDoneVersion = 0;
+
+    int SectorCost(int c) const { return (int)index->sectors[c].lines.size(); }
+
+    // Visit sectors whose solids come within `radius` of pos (XZ).
+    template<class Fn>
+    void ForSectorsNear(Vector3 pos, float radius, Fn&& fn) {
+        float reach = radius + index->maxOverhang;
+        int x0 = index->CellX(pos.x - reach), x1 = index->CellX(pos.x + reach);
+        int z0 = index->CellZ(pos.z - reach), z1 = index->CellZ(pos.z + reach);
+        for(int z = z0; z <= z1; z++)
+            for(int x = x0; x <= x1; x++) {
+                int c = z * index->nx + x;
+                const SectorIndex::Sector& sec = index->sectors[c];
+                if(sec.lines.empty()) continue;
+                float dx = std::max({ sec.bounds.min.x - pos.x, 0.0f, pos.x - sec.bounds.max.x });
+                float dz = std::max({ sec.bounds.min.z - pos.z, 0.0f, pos.z - sec.bounds.max.z });
+                if(dx * dx + dz * dz <= radius * radius) fn(c);
+            }
+    }
+
+    // Evict least-recently-wanted sectors until sector c fits the budget.
+    bool MakeRoom(int c) {
+        int need = (int)globals.size() + residentSolids + queuedSolids;
+        if(slots[c].state == SectorState::UNLOADED) need += SectorCost(c);
+        while(need > STREAM_BUDGET) {
+            int victim = -1;
+            for(size_t i = 0; i < slots.size(); i++) {
+                const Slot& s = slots[i];
+                if(s.state != SectorState::RESIDENT || s.pinned || s.lastWanted == frame) continue;
+                if(victim < 0 || s.lastWanted < slots[victim].lastWanted) victim = (int)i;
+            }
+            if(victim < 0) {
+                if(!slots[c].warned) {
+                    TraceLog(LOG_WARNING, "MapStreamer: budget of %d solids full, sector %d skipped",
+                             STREAM_BUDGET, c);
+                    slots[c].warned = true;
+                }
+                return false;
+            }
+            residentSolids -= (int)slots[victim].solids.size();
+            need           -= (int)slots[victim].solids.size();
+            slots[victim].state = SectorState::UNLOADED;
+            evicted = true;
+            slots[victim].solids.clear();
+            slots[victim].solids.shrink_to_fit();
+        }
+        return true;
+    }
+
+    void Request(int c) {
+        slots[c].state = SectorState::QUEUED;
+        queuedSolids += SectorCost(c);
+        { std::lock_guard<std::mutex> lk(mtx); requests.push_back(c); }
+        cv.notify_one();
+    }
+
+    // Synchronous load; a pending worker result for c is discarded on arrival.
+    void LoadNow(int c) {
+        if(slots[c].state == SectorState::QUEUED) queuedSolids -= SectorCost(c);
+        slots[c].solids = ReadSectorSolids(syncFile, index->sectors[c]);
+        OptimizeSolids(slots[c].solids, nullptr);
+        slots[c].state  = SectorState::RESIDENT;
+        residentSolids += (int)slots[c].solids.size();
+    }
+
+    // Replaces any bake still waiting; one already running finishes first.
+    void RequestMesh(const World& world) {
+        {
+            std::lock_guard<std::mutex> lk(mtx);
+            meshSolids  = world.solids;
+            meshVersion = world.geometryVersion;
+            meshWanted  = true;
+        }
+        cv.notify_one();
+    }
+
+    // world.solids = globals + resident sectors, in sector order
+    void Assemble(World& world) {
+        world.solids = globals;
+        for(const Slot& s : slots)
+            if(s.state == SectorState::RESIDENT)
+                world.solids.insert(world.solids.end(), s.solids.begin(), s.solids.end());
+    }
+
+    void WorkerMain() {
+        std::ifstream f(index->path);
+        std::unique_lock<std::mutex> lk(mtx);
+        for(;;) {
+            cv.wait(lk, [this]{ return quit || !requests.empty() || meshWanted; });
+            if(quit) return;
+            if(requests.empty()) {
+                BakeMesh(lk);
+                continue;
+            }
+            int c = requests.front();
+            requests.pop_front();
+            lk.unlock();
+            std::vector<MapSolid> solids = ReadSectorSolids(f, index->sectors[c]);
+            OptimizeSolids(solids, nullptr);
+            lk.lock();
+            done.emplace_back(c, std::move(solids));
+        }
+    }
+
+    // Worker, lock held on entry and exit
+    void BakeMesh(std::unique_lock<std::mutex>& lk) {
+        std::vector<MapSolid> solids = std::move(meshSolids);
+        uint32_t version = meshVersion;
+        meshWanted = false;
+        lk.unlock();
+        SolidGrid grid;
+        grid.Build(solids);
+        int facesIn = 0;
+        std::vector<MapFace> faces = BuildVisibleFaces(solids, &facesIn);
+        MapAOStats ao;
+        std::vector<MeshQuad> quads = BakeMapAO(faces, solids, grid, &ao);
+        TraceLog(LOG_INFO, "MapStreamer: map mesh %d faces -> %d visible -> %d AO quads, AO %.1f ms on %d thread(s)",
+                 facesIn, (int)faces.size(), ao.quads, ao.ms, ao.threads);
+        lk.lock();
+        meshQuads       = std::move(quads);
+        meshDoneVersion = version;
+        meshReady       = true;
+    }
+};
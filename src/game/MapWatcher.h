@@ -0,0 +1,81 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MapWatcher.h  –  inotify watch on the active map file (Linux only)
+//
+//  Watches the map's directory rather than the file itself: most editors save
+//  by writing a temp file and renaming it over the original, which would
+//  silently orphan a watch on the old inode.  The descriptor is non-blocking,
+//  so Poll() costs one read() that returns EAGAIN on quiet frames.  On other
+//  platforms the watcher is inert.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <raylib.h>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+class MapWatcher {
+public:
+    MapWatcher() = default;
+    MapWatcher(const MapWatcher&) = delete;
+    MapWatcher& operator=(const MapWatcher&) = delete;
+    ~MapWatcher() { Close(); }
+
+    bool Watch(const std::string& path) {
+        Close();
+        size_t slash = path.find_last_of('/');
+        dir  = (slash == std::string::npos) ? "." : path.substr(0, slash);
+        name = (slash == std::string::npos) ? path : path.substr(slash + 1);
+#if defined(__linux__)
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(fd < 0) {
+            TraceLog(LOG_WARNING, "MapWatcher: inotify_init1 failed (%d)", errno);
+            return false;
+        }
+        if(inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            TraceLog(LOG_WARNING, "MapWatcher: cannot watch %s (%d)", dir.c_str(), errno);
+            Close();
+            return false;
+        }
+        TraceLog(LOG_INFO, "MapWatcher: watching %s", path.c_str());
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // True if the map file was written or replaced since the last call.
+    bool Poll() {
+#if defined(__linux__)
+        if(fd < 0) return false;
+        bool hit = false;
+        alignas(inotify_event) char buf[4096];
+        for(;;) {
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if(n <= 0) break;   // EAGAIN: drained
+            for(ssize_t off = 0; off < n; ) {
+                const inotify_event* ev = (const inotify_event*)(buf + off);
+                if(ev->len && name == ev->name) hit = true;
+                off += sizeof(inotify_event) + ev->len;
+            }
+        }
+        return hit;
+#else
+        return false;
+#endif
+    }
+
+private:
+    std::string dir, name;
+    int         fd = -1;
+
+    void Close() {
+#if defined(__linux__)
+        if(fd >= 0) close(fd);
+#endif
+        fd = -1;
+    }
+};
@@ -11,6 +11,7 @@
 #include <raymath.h>
 #include <cmath>
 #include <algorithm>
+#include <array>
 
 constexpr float PHYS_SKIN = 0.02f;   // gap kept between player and surfaces
 
@@ -95,6 +96,40 @@ inline Vector3 SweepAABB(
     return pos;
 }
 
+// ─── Movement contact events ─────────────────────────────────────────────────
+// SweepAABB reports contacts; this turns them into sounds.  Steps follow the
+// ground actually covered, so cadence rises with speed and pushing into a
+// wall is silent.  Walking, crouching and slow movement make no steps; a
+// landing is heard from any stance once the fall is fast enough.  The skin
+// gap makes a pawn on flat ground miss the floor for a frame or two at a
+// time, so steps keep counting through STEP_AIR_GRACE of lost contact.
+constexpr float STEP_STRIDE    = 1.4f;                 // metres per footstep
+constexpr float STEP_MIN_SPEED = PLAYER_SPEED * 0.6f;  // above walk speed
+constexpr float STEP_AIR_GRACE = 0.1f;                 // seconds
+constexpr float LAND_MIN_SPEED = 3.0f;                 // m/s downward at impact
+
+// Call right after the sweep.  prevPos / wasOnGround / fallSpeed (downward
+// velocity, positive) describe the pawn before it; quiet = walk or crouch.
+inline void EmitMovementSounds(Pawn& p, World& world, Vector3 prevPos,
+                               bool wasOnGround, float fallSpeed, bool quiet, float dt) {
+    p.airTime = p.onGround ? 0.0f : p.airTime + dt;
+    if(p.onGround && !wasOnGround && fallSpeed >= LAND_MIN_SPEED) {
+        world.EmitSound(SoundID::LAND, p.xform.pos, p.id);
+        p.strideDist = STEP_STRIDE * 0.5f;   // next step comes half a stride early
+        return;
+    }
+    if(p.airTime > STEP_AIR_GRACE) return;   // jumping or falling: silent
+
+    float dx = p.xform.pos.x - prevPos.x, dz = p.xform.pos.z - prevPos.z;
+    float d  = sqrtf(dx * dx + dz * dz);
+    if(quiet || dt <= 0.0f || d < STEP_MIN_SPEED * dt) { p.strideDist = 0.0f; return; }
+    p.strideDist += d;
+    if(p.strideDist >= STEP_STRIDE) {
+        p.strideDist -= STEP_STRIDE;
+        world.EmitSound(SoundID::FOOTSTEP, p.xform.pos, p.id);
+    }
+}
+
 // ─── Raycast against world geometry ──────────────────────────────────────────
 struct HitResult {
     bool    hit        = false;
@@ -125,20 +160,216 @@ inline HitResult RaycastSolids(
     return best;
 }
 
+// ─── Batched raycast (ray packet) ────────────────────────────────────────────
+// For rays that share a neighbourhood, e.g. one explosion to every pawn in
+// range.  Candidate solids are gathered from the grid once for the whole
+// packet, then each candidate box is tested against every ray.  Results match
+// RaycastSolids ray for ray, ties included (candidates run in index order).
+struct RayQuery {
+    Vector3 origin;
+    Vector3 direction;   // normalised
+    float   maxDist;
+};
+
+constexpr int MAX_PACKET_RAYS = MAX_PAWNS;
+
+inline void RaycastSolidsPacket(
+    const RayQuery* rays,
+    int             count,
+    HitResult*      out,
+    const World&    world)
+{
+    if(count <= 0) return;
+
+    BoundingBox packetBox = { rays[0].origin, rays[0].origin };
+    for(int r = 0; r < count; r++) {
+        Vector3 end = Vector3Add(rays[r].origin,
+                                 Vector3Scale(rays[r].direction, rays[r].maxDist));
+        packetBox.min = Vector3Min(packetBox.min, Vector3Min(rays[r].origin, end));
+        packetBox.max = Vector3Max(packetBox.max, Vector3Max(rays[r].origin, end));
+        out[r] = HitResult{};
+        out[r].distance = rays[r].maxDist + 1.0f;
+    }
+    // Pad so boxes touched only at a ray's end point survive float rounding.
+    packetBox.min = Vector3Subtract(packetBox.min, {0.01f, 0.01f, 0.01f});
+    packetBox.max = Vector3Add(packetBox.max, {0.01f, 0.01f, 0.01f});
+
+    std::array<int, MAX_SOLIDS> candidates;
+    int numCandidates = 0;
+    world.solidGrid.ForEachCandidate(packetBox, [&](int i) {
+        if(numCandidates < MAX_SOLIDS &&
+           CheckCollisionBoxes(packetBox, world.solids[i].bounds))
+            candidates[numCandidates++] = i;
+    });
+    std::sort(candidates.begin(), candidates.begin() + numCandidates);
+
+    for(int c = 0; c < numCandidates; c++) {
+        const BoundingBox& box = world.solids[candidates[c]].bounds;
+        for(int r = 0; r < count; r++) {
+            RayCollision rc = GetRayCollisionBox({rays[r].origin, rays[r].direction}, box);
+            if(rc.hit && rc.distance > 0.0f && rc.distance < out[r].distance) {
+                out[r].hit        = true;
+                out[r].distance   = rc.distance;
+                out[r].point      = rc.point;
+                out[r].solidIndex = candidates[c];
+            }
+        }
+    }
+    for(int r = 0; r < count; r++)
+        if(out[r].distance > rays[r].maxDist) out[r].hit = false;
+}
+
+// ─── Swept sphere vs AABB (time of impact) ───────────────────────────────────
+// Exact sweep against the box's Minkowski sum with the sphere: the inflated
+// box catches face contacts, then edge and corner regions are refined
+// against the rounded cylinders / spheres they really are.  Returns the
+// first contact fraction t ∈ [0,1] along d and the contact normal.
+namespace sweep_detail {
+    // Segment p + d·t against box; on success [t0, t1] is the overlap.
+    inline bool SegmentBox(const float p[3], const float d[3],
+                           const float lo[3], const float hi[3],
+                           float& t0, float& t1) {
+        t0 = 0.0f; t1 = 1.0f;
+        for(int a = 0; a < 3; a++) {
+            if(fabsf(d[a]) < 1e-9f) {
+                if(p[a] < lo[a] || p[a] > hi[a]) return false;
+                continue;
+            }
+            float inv = 1.0f / d[a];
+            float ta = (lo[a] - p[a]) * inv;
+            float tb = (hi[a] - p[a]) * inv;
+            if(ta > tb) std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+            if(t0 > t1) return false;
+        }
+        return true;
+    }
+
+    // Smallest root in [0,1] of |o + d·t - c|² = r² over the given axes.
+    inline bool SegmentRound(const float p[3], const float d[3], const float c[3],
+                             float r, int skipAxis, float& t) {
+        float a = 0, b = 0, cc = -r * r;
+        for(int k = 0; k < 3; k++) {
+            if(k == skipAxis) continue;
+            float m = p[k] - c[k];
+            a  += d[k] * d[k];
+            b  += m * d[k];
+            cc += m * m;
+        }
+        if(cc <= 0.0f) { t = 0.0f; return true; }       // already touching
+        if(a < 1e-12f || b >= 0.0f) return false;        // parallel / receding
+        float disc = b * b - a * cc;
+        if(disc < 0.0f) return false;
+        t = (-b - sqrtf(disc)) / a;
+        return t >= 0.0f && t <= 1.0f;
+    }
+}
+
+inline bool SweepSphereAABB(Vector3 pos, Vector3 delta, float radius,
+                            const BoundingBox& box, float& tHit, Vector3& normal)
+{
+    using namespace sweep_detail;
+    const float p[3]  = { pos.x, pos.y, pos.z };
+    const float d[3]  = { delta.x, delta.y, delta.z };
+    const float lo[3] = { box.min.x, box.min.y, box.min.z };
+    const float hi[3] = { box.max.x, box.max.y, box.max.z };
+    const float elo[3] = { lo[0] - radius, lo[1] - radius, lo[2] - radius };
+    const float ehi[3] = { hi[0] + radius, hi[1] + radius, hi[2] + radius };
+
+    float t0, t1;
+    if(!SegmentBox(p, d, elo, ehi, t0, t1)) return false;
+
+    // Which Voronoi region of the box does the entry point sit in?
+    float q[3];
+    int below = 0, above = 0;
+    for(int k = 0; k < 3; k++) {
+        q[k] = p[k] + d[k] * t0;
+        if(q[k] < lo[k]) below |= 1 << k;
+        if(q[k] > hi[k]) above |= 1 << k;
+    }
+    int outside = below | above;
+    int count   = (outside & 1) + ((outside >> 1) & 1) + ((outside >> 2) & 1);
+
+    float t = t0;
+    if(count >= 2) {
+        // Edge or corner region: the rounded shape sits inside the inflated
+        // box here, so intersect the real cylinders and corner sphere.
+        float corner[3];
+        for(int k = 0; k < 3; k++) corner[k] = (below & (1 << k)) ? lo[k] : hi[k];
+
+        bool  any  = false;
+        float best = 2.0f, tc;
+        for(int axis = 0; axis < 3; axis++) {
+            if(outside & (1 << axis)) continue;        // edge runs along the free axis
+            if(SegmentRound(p, d, corner, radius, axis, tc)) {
+                float along = p[axis] + d[axis] * tc;
+                if(along >= lo[axis] && along <= hi[axis] && tc < best) { best = tc; any = true; }
+            }
+            // Edge end caps
+            float endA[3] = { corner[0], corner[1], corner[2] };
+            float endB[3] = { corner[0], corner[1], corner[2] };
+            endA[axis] = lo[axis];
+            endB[axis] = hi[axis];
+            if(SegmentRound(p, d, endA, radius, -1, tc) && tc < best) { best = tc; any = true; }
+            if(SegmentRound(p, d, endB, radius, -1, tc) && tc < best) { best = tc; any = true; }
+        }
+        if(count == 3) {
+            for(int axis = 0; axis < 3; axis++) {
+                if(SegmentRound(p, d, corner, radius, axis, tc)) {
+                    float along = p[axis] + d[axis] * tc;
+                    if(along >= lo[axis] && along <= hi[axis] && tc < best) { best = tc; any = true; }
+                }
+            }
+            if(SegmentRound(p, d, corner, radius, -1, tc) && tc < best) { best = tc; any = true; }
+        }
+        if(!any) return false;
+        t = best;
+    }
+
+    // Normal from the closest point on the box to the sphere centre at contact.
+    Vector3 c  = Vector3Add(pos, Vector3Scale(delta, t));
+    Vector3 cp = { std::clamp(c.x, box.min.x, box.max.x),
+                   std::clamp(c.y, box.min.y, box.max.y),
+                   std::clamp(c.z, box.min.z, box.max.z) };
+    Vector3 n  = Vector3Subtract(c, cp);
+    float   nl = Vector3Length(n);
+    if(nl > 1e-6f) {
+        n = Vector3Scale(n, 1.0f / nl);
+    } else {
+        // Centre inside the box: push out along the shallowest face.
+        float best = INFINITY; int axis = 1; float sign = 1.0f;
+        const float cc[3] = { c.x, c.y, c.z };
+        for(int k = 0; k < 3; k++) {
+            if(cc[k] - lo[k] < best) { best = cc[k] - lo[k]; axis = k; sign = -1.0f; }
+            if(hi[k] - cc[k] < best) { best = hi[k] - cc[k]; axis = k; sign =  1.0f; }
+        }
+        n = { 0, 0, 0 };
+        (axis == 0 ? n.x : axis == 1 ? n.y : n.z) = sign;
+    }
+
+    // Starting in contact but already moving away is not a hit.
+    if(t <= 0.0f && Vector3DotProduct(delta, n) >= 0.0f) return false;
+
+    tHit   = t;
+    normal = n;
+    return true;
+}
+
+// ─── Derived map data (rebuild whenever world.solids changes) ────────────────
+inline void BuildMapAccel(World& world) {
+    world.solidGrid.Build(world.solids);
+    world.geometryVersion++;
+}
+
 // ─── Smoke occlusion check ────────────────────────────────────────────────────
+// Marches the voxelised smoke grid; smoke never counts through walls because
+// the flood fill that built it stopped at solids.
 inline bool RayBlockedBySmoke(
-    Vector3                       from,
-    Vector3                       to,
-    const std::vector<SmokeZone>& smokes)
+    Vector3          from,
+    Vector3          to,
+    const SmokeGrid& smoke)
 {
-    Vector3 dir = Vector3Subtract(to, from);
-    float   len = Vector3Length(dir);
-    if(len < 0.01f) return false;
-    dir = Vector3Scale(dir, 1.0f / len);
-    Ray ray = {from, dir};
-    for(auto& smoke : smokes) {
-        RayCollision rc = GetRayCollisionSphere(ray, smoke.pos, smoke.radius);
-        if(rc.hit && rc.distance > 0.0f && rc.distance < len) return true;
-    }
-    return false;
-}
\ No newline at end of file
+    if(Vector3LengthSqr(Vector3Subtract(to, from)) < 0.0001f) return false;
+    return smoke.SegmentBlocked(from, to);
+}
@@ -0,0 +1,65 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  PlayerCommand.h  –  What one pawn wants to do for one simulation tick
+//
+//  Everything that drives a pawn goes through a 16-byte PlayerCommand:
+//  held buttons, absolute view angles, analog move and a weapon pick.
+//  Local input (raylib or evdev), a replay file and the bot AI all produce
+//  them, and ApplyPlayerCommand is the only code that turns them into
+//  movement, shots and throws, so every source takes the same path.
+//
+//  Commands carry held state only; press edges come from comparing with
+//  the pawn's previous command (Pawn::lastButtons).  View angles are
+//  quantised so a command read back from a file or the network moves the
+//  pawn exactly as it did when it was made.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Constants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+enum CmdButton : uint16_t {
+    CMD_JUMP   = 1 << 0,
+    CMD_CROUCH = 1 << 1,
+    CMD_WALK   = 1 << 2,
+    CMD_FIRE   = 1 << 3,
+    CMD_ADS    = 1 << 4,
+    CMD_RELOAD = 1 << 5,
+    CMD_FRAG   = 1 << 6,
+    CMD_SMOKE  = 1 << 7,
+    CMD_STUN   = 1 << 8,
+};
+
+constexpr uint8_t CMD_NO_WEAPON = 0xFF;
+constexpr float   CMD_MAX_PITCH = 1.45f;   // view pitch limit, radians
+
+struct PlayerCommand {
+    uint32_t tick    = 0;
+    uint16_t buttons = 0;              // CmdButton bits held this tick
+    uint16_t yaw     = 0;              // full turn over 65536
+    int16_t  pitch   = 0;              // ±CMD_MAX_PITCH over ±32767
+    int8_t   forward = 0;              // move along yaw, ±127 = full speed
+    int8_t   side    = 0;              // move to the right, ±127
+    uint8_t  weapon  = CMD_NO_WEAPON;  // WeaponID to switch to
+    uint8_t  reserved[3] = {};
+
+    bool Has(CmdButton b) const { return buttons & b; }
+};
+static_assert(sizeof(PlayerCommand) == 16, "PlayerCommand is a fixed 16-byte record");
+
+// ─── Angle quantisation ─────────────────────────────────────────────────────
+inline uint16_t QuantizeYaw(float yaw) {
+    float turns = yaw / (2.0f * PI);
+    turns -= floorf(turns);
+    return (uint16_t)((uint32_t)lroundf(turns * 65536.0f) & 0xFFFF);
+}
+inline float DequantizeYaw(uint16_t q) { return q * (2.0f * PI / 65536.0f); }
+
+inline int16_t QuantizePitch(float pitch) {
+    return (int16_t)lroundf(std::clamp(pitch, -CMD_MAX_PITCH, CMD_MAX_PITCH) / CMD_MAX_PITCH * 32767.0f);
+}
+inline float DequantizePitch(int16_t q) { return q * (CMD_MAX_PITCH / 32767.0f); }
+
+inline int8_t QuantizeMove(float m) {
+    return (int8_t)lroundf(std::clamp(m, -1.0f, 1.0f) * 127.0f);
+}
@@ -5,6 +5,7 @@
 #include "../World.h"
 #include "../ai/BotAI.h"
 #include "../game/MapLoader.h"
+#include "../utility/UtilitySystem.h"
 #include <algorithm>
 #include <array>
 
@@ -66,15 +67,18 @@ inline void SpawnPawns(World &world, const MapData &md) {
     p.id = i;
     p.alive = true;
     p.hp = MAX_HP;
+    p.lastAttacker = -1;
     p.fragCount = 1;
     p.smokeCount = 1;
     p.stunCount = 1;
+    p.primedUtility = -1;
     p.velocity = {0, 0, 0};
     p.onGround = true;
     p.isCrouching = false;
+    p.lastButtons = 0;
 
-    // Player is pawn 0 on attack team
-    p.isBot = (i != world.playerID);
+    // Seats in humanSeats take PlayerCommands; playerID is the one viewed
+    p.isBot = !(world.humanSeats & (1u << i));
     if (md.isTestMap && p.isBot) {
         p.alive = false;
     }
@@ -148,6 +152,7 @@ inline void ResetRound(World &world, const MapData &md) {
 
   world.grenades.clear();
   world.smokes.clear();
+  world.smokeGrid.ClearAll();
   world.tracers.clear();
   world.impacts.clear();
   world.stun.timeLeft = 0;
@@ -244,4 +249,15 @@ inline void UpdateRound(World &world, const MapData &md, float dt) {
     // GUI layer handles replay.
     break;
   }
-}
\ No newline at end of file
+}
+
+// ─── One simulation tick after the human seats' commands ran
+// ─────────────────────────────────────
+// Shared by the game loop and MatchHost so both advance a World the same way.
+inline void StepWorld(World &world, const MapData &md, uint32_t tick, float dt) {
+  UpdateRound(world, md, dt);
+  if (world.roundState == RoundState::ACTIVE) {
+    UpdateBots(world, tick, dt);
+    UpdateUtility(world, dt);
+  }
+}
@@ -0,0 +1,102 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  SolidGrid.h  –  Uniform XZ grid over static map solids
+//
+//  Maps are built from vertical boxes, so a 2D grid on the ground plane is
+//  enough to cut "test every solid" loops down to the few solids near a
+//  query box.  Cells store solid indices in one flat array (CSR layout);
+//  the grid is built once per map and only read afterwards.
+//
+//  A solid spanning several cells is reported once per query: only the cell
+//  at the lower corner of (solid ∩ query) emits it.  That keeps queries
+//  stateless, so any number of threads may query the same grid.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Entity.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+constexpr float SOLID_GRID_CELL = 4.0f;   // metres per cell edge
+
+struct SolidGrid {
+    float originX = 0.0f, originZ = 0.0f;
+    int   nx = 0, nz = 0;
+
+    struct CellRange { int x0, z0, x1, z1; };
+    std::vector<CellRange> ranges;     // per solid, inclusive cell bounds
+    std::vector<int>       cellStart;  // nx*nz + 1 offsets into items
+    std::vector<int>       items;      // solid indices, grouped by cell
+
+    // ── Build (map load) ─────────────────────────────────────────────────────
+    void Build(const std::vector<MapSolid>& solids) {
+        ranges.clear(); cellStart.clear(); items.clear();
+        nx = nz = 0;
+        if(solids.empty()) return;
+
+        float minX = solids[0].bounds.min.x, maxX = solids[0].bounds.max.x;
+        float minZ = solids[0].bounds.min.z, maxZ = solids[0].bounds.max.z;
+        for(const auto& s : solids) {
+            minX = std::min(minX, s.bounds.min.x);
+            maxX = std::max(maxX, s.bounds.max.x);
+            minZ = std::min(minZ, s.bounds.min.z);
+            maxZ = std::max(maxZ, s.bounds.max.z);
+        }
+        originX = minX;
+        originZ = minZ;
+        nx = std::max(1, (int)ceilf((maxX - minX) / SOLID_GRID_CELL));
+        nz = std::max(1, (int)ceilf((maxZ - minZ) / SOLID_GRID_CELL));
+
+        ranges.resize(solids.size());
+        std::vector<int> counts((size_t)nx * nz, 0);
+        for(size_t i = 0; i < solids.size(); i++) {
+            const BoundingBox& b = solids[i].bounds;
+            CellRange r = { CellX(b.min.x), CellZ(b.min.z), CellX(b.max.x), CellZ(b.max.z) };
+            ranges[i] = r;
+            for(int z = r.z0; z <= r.z1; z++)
+                for(int x = r.x0; x <= r.x1; x++)
+                    counts[z * nx + x]++;
+        }
+
+        cellStart.resize((size_t)nx * nz + 1);
+        cellStart[0] = 0;
+        for(int c = 0; c < nx * nz; c++) cellStart[c + 1] = cellStart[c] + counts[c];
+        items.resize(cellStart.back());
+
+        std::fill(counts.begin(), counts.end(), 0);
+        for(size_t i = 0; i < solids.size(); i++) {
+            const CellRange& r = ranges[i];
+            for(int z = r.z0; z <= r.z1; z++)
+                for(int x = r.x0; x <= r.x1; x++) {
+                    int c = z * nx + x;
+                    items[cellStart[c] + counts[c]++] = (int)i;
+                }
+        }
+    }
+
+    // ── Visit every solid whose cells overlap the query box (XZ only) ───────
+    template<class Fn>
+    void ForEachCandidate(const BoundingBox& q, Fn&& fn) const {
+        if(nx == 0) return;
+        int qx0 = CellX(q.min.x), qx1 = CellX(q.max.x);
+        int qz0 = CellZ(q.min.z), qz1 = CellZ(q.max.z);
+        for(int z = qz0; z <= qz1; z++) {
+            for(int x = qx0; x <= qx1; x++) {
+                int c = z * nx + x;
+                for(int k = cellStart[c]; k < cellStart[c + 1]; k++) {
+                    int i = items[k];
+                    const CellRange& r = ranges[i];
+                    if(x != std::max(r.x0, qx0) || z != std::max(r.z0, qz0)) continue;
+                    fn(i);
+                }
+            }
+        }
+    }
+
+private:
+    int CellX(float wx) const {
+        return std::clamp((int)floorf((wx - originX) / SOLID_GRID_CELL), 0, nx - 1);
+    }
+    int CellZ(float wz) const {
+        return std::clamp((int)floorf((wz - originZ) / SOLID_GRID_CELL), 0, nz - 1);
+    }
+};
@@ -0,0 +1,100 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  WorldHash.h  –  Fingerprint of the state a tick depends on
+//
+//  Two Worlds that hash equal after the same tick will keep stepping the
+//  same way.  Lockstep peers compare this hash every few ticks to catch a
+//  desync at the tick it happened.  It covers pawns, bot brains, grenades,
+//  smokes, round and objective state, the random stream and the noise
+//  ring's count.  Map geometry is left out because it never changes in a
+//  match; LockstepSession's hello compares MapHash before tick 0.  So are
+//  tracers, impacts, sound events and the screen effects, which nothing
+//  reads back and which differ per peer because each one has its own
+//  playerID.
+//
+//  About 2 KB of fields, a few microseconds on a Pi 4.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Hash.h"
+#include "../World.h"
+
+inline void HashWeapon(Fnv1a& h, const WeaponState& w) {
+    h.U8((uint8_t)w.id);
+    h.U32((uint32_t)w.ammoMag);
+    h.U32((uint32_t)w.ammoReserve);
+    h.F32(w.reloadTimer);
+    h.F32(w.fireCooldown);
+    h.U8(w.isADS);
+    h.U32((uint32_t)w.shotsFired);
+    h.F32(w.timeSinceLastShot);
+}
+
+inline uint64_t WorldHash(const World& world) {
+    Fnv1a h;
+    for(const Pawn& p : world.pawns) {
+        h.U8((uint8_t)p.team);
+        h.U8(p.isBot);
+        h.U8(p.alive);
+        h.Vec(p.xform.pos);
+        h.F32(p.xform.yaw);
+        h.F32(p.xform.pitch);
+        h.Vec(p.velocity);
+        h.U8(p.onGround);
+        h.U8(p.isCrouching);
+        h.F32(p.strideDist);
+        h.F32(p.airTime);
+        h.U32(p.lastButtons);
+        h.U32((uint32_t)p.hp);
+        h.U32((uint32_t)p.lastAttacker);
+        HashWeapon(h, p.weapon);
+        for(const WeaponState& w : p.weaponSlots) HashWeapon(h, w);
+        h.U32((uint32_t)p.fragCount);
+        h.U32((uint32_t)p.smokeCount);
+        h.U32((uint32_t)p.stunCount);
+        h.U32((uint32_t)p.primedUtility);
+    }
+    for(const BotBrain& b : world.brains) {
+        h.U8((uint8_t)b.state);
+        h.U32((uint32_t)b.waypointIdx);
+        h.U32((uint32_t)b.targetID);
+        h.Vec(b.lastKnown);
+        h.F32(b.visionTimer);
+        h.F32(b.reactionTimer);
+        h.F32(b.retreatTimer);
+        h.F32(b.lostSightTimer);
+        h.F32(b.strafeTimer);
+        h.F32(b.strafeSign);
+        h.U8(b.hasSightLine);
+        h.U32(b.noiseCursor);
+    }
+    h.U32((uint32_t)world.grenades.size());
+    for(const GrenadeEntity& g : world.grenades) {
+        h.U8((uint8_t)g.type);
+        h.Vec(g.pos);
+        h.Vec(g.vel);
+        h.F32(g.fuseTimer);
+        h.U8(g.detonated);
+        h.F32(g.activeTimer);
+        h.U32((uint32_t)g.ownerID);
+    }
+    h.U32((uint32_t)world.smokes.size());
+    for(const SmokeZone& s : world.smokes) {
+        h.Vec(s.pos);
+        h.F32(s.radius);
+        h.F32(s.lifeLeft);
+    }
+    h.U32((uint32_t)(world.rng.state));
+    h.U32((uint32_t)(world.rng.state >> 32));
+    h.U32(world.noises.head);
+
+    h.U8((uint8_t)world.roundState);
+    h.F32(world.roundTimer);
+    h.F32(world.freezeTimer);
+    h.F32(world.roundOverTimer);
+    h.U8((uint8_t)world.roundWinner);
+    h.U32((uint32_t)world.scoreAttack);
+    h.U32((uint32_t)world.scoreDefend);
+    h.U32((uint32_t)world.roundNumber);
+    h.F32(world.objective.captureProgress);
+    h.U8(world.objective.captured);
+    return h.value;
+}
@@ -3,20 +3,37 @@
 //  Raspberry Pi 4 / OpenGL ES 2.0 / Raylib 4.5+
 // ─────────────────────────────────────────────────────────────────────────────
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <raylib.h>
 #include <raymath.h>
 
 #include "Constants.h"
+#include "StartupTimer.h"
+#include "Tuning.h"
 #include "World.h"
 #include "ai/BotAI.h"
 #include "audio/AudioSystem.h"
+#include "game/Calibration.h"
+#include "game/CommandLog.h"
+#include "game/InputSampler.h"
 #include "game/InputSystem.h"
+#include "game/LatencyProbe.h"
+#include "game/MapHotReload.h"
+#include "game/MapLoadJob.h"
 #include "game/MapLoader.h"
+#include "game/MapStreaming.h"
 #include "game/Physics.h"
 #include "game/RoundManager.h"
+#include "net/Lockstep.h"
+#include "net/PawnInterpolator.h"
+#include "render/FramePacer.h"
+#include "render/QualitySettings.h"
 #include "render/Renderer.h"
+#include "server/Relevancy.h"
+#include "server/Snapshot.h"
 #include "ui/MenuSystem.h"
+#include "ui/ProfilerOverlay.h"
 #include "utility/UtilitySystem.h"
 
 // ─── Pi 4 specific: force GLES2 context before window creation ───────────────
@@ -28,74 +45,195 @@ static void ConfigurePi() {
 #endif
 }
 
-int main() {
-  srand((unsigned)time(nullptr));
+int main(int argc, char **argv) {
+  StartupTimer startup;   // STARTUP log line: time to menu and first match frame
   ConfigurePi();
 
+  // --record <file> / --replay <file>: the player's commands, see CommandLog.h
+  // --latency, --latency-csv <file>, --latency-selftest: see LatencyProbe.h
+  // --calibrate: re-run the quality benchmark, see Calibration.h
+  // --startup-bench: start a match at once, quit after its first frame (CI)
+  // --remote-view: draw other pawns from this seat's snapshots through the
+  //   client interpolation buffer, as a networked client would see them
+  // --lockstep <seat> <peers> [--seed <n>]: peer-to-peer match, see
+  //   Lockstep.h; every peer gives the same list and seed
+  CommandLog commandLog;
+  bool latency = false, latencySelfTest = false, calibrate = false;
+  bool startupBench = false, remoteView = false;
+  const char *latencyCsv = nullptr;
+  int lockSeat = -1;
+  const char *lockPeers = nullptr;
+  uint64_t lockSeed = 1;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--record") && i + 1 < argc)
+      commandLog.OpenRecord(argv[++i]);
+    else if (!strcmp(argv[i], "--replay") && i + 1 < argc)
+      commandLog.OpenReplay(argv[++i]);
+    else if (!strcmp(argv[i], "--latency"))
+      latency = true;
+    else if (!strcmp(argv[i], "--latency-csv") && i + 1 < argc)
+      latency = true, latencyCsv = argv[++i];
+    else if (!strcmp(argv[i], "--latency-selftest"))
+      latency = latencySelfTest = true;
+    else if (!strcmp(argv[i], "--calibrate"))
+      calibrate = true;
+    else if (!strcmp(argv[i], "--startup-bench"))
+      startupBench = true;
+    else if (!strcmp(argv[i], "--remote-view"))
+      remoteView = true;
+    else if (!strcmp(argv[i], "--lockstep") && i + 2 < argc)
+      lockSeat = atoi(argv[++i]), lockPeers = argv[++i];
+    else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+      lockSeed = strtoull(argv[++i], nullptr, 10);
+  }
+  LoadTuning(TUNING_FILE);   // F5 reloads it in game
+
+  LatencyProbe probe;
+  if (latency)
+    probe.Enable(latencyCsv, latencySelfTest);
+
+  // Audio device, decode and the map start first, so they overlap the window
+  AudioSystem audio;
+  audio.Init();   // device + decode on the audio thread
+  MapLoadJob loadJob;
+  loadJob.Start("assets/maps/map01t.map", true);
+  startup.Phase("workers");
+
   // ── Window ────────────────────────────────────────────────────────────
-  SetConfigFlags(FLAG_MSAA_4X_HINT);
+  QualityConfig quality;   // HIGH until calibrated
+  quality.Load(QUALITY_FILE);
+  if (quality.settings.msaa)
+    SetConfigFlags(FLAG_MSAA_4X_HINT);
+  SetTraceLogCallback(CaptureGLInfo);
   InitWindow(RENDER_W, RENDER_H, "TacticalLite – 3v3 MVP");
-  SetTargetFPS(TARGET_FPS);
-  DisableCursor(); // lock + hide mouse for FPS look
+  SetTraceLogCallback(nullptr);
+  startup.Phase("window");
+  std::string fingerprint = HardwareFingerprint();
+  if (quality.loaded && quality.fingerprint != fingerprint) {
+    TraceLog(LOG_INFO, "Quality: hardware or driver changed, calibrating again");
+    calibrate = true;
+  }
+  calibrate |= !quality.loaded;
+  SetTargetFPS(0);   // FramePacer paces, see below
 
-  InitAudioDevice();
-  AudioSystem audio;
-  audio.Init();
+  InputSampler input;   // evdev thread; raylib polling if unavailable
+  input.Init();
 
   // ── World & systems ───────────────────────────────────────────────────
   World world;
+  world.rng.Seed((uint64_t)time(nullptr));
   Renderer renderer;
   renderer.Init();
+  ApplyQualityCaps(quality.settings, world);
 
-  // Load map
-  MapData md;
-  try {
-    md = LoadMap("assets/maps/map01t.map", world);
-  } catch (std::exception &e) {
-    TraceLog(LOG_WARNING, "Map load failed: %s — using procedural fallback",
-             e.what());
-    // ── Procedural fallback map ───────────────────────────────────────
-    // Floor
-    world.solids.push_back(
-        {{{-25, -0.2f, -25}, {25, 0.0f, 25}}, COL_FLOOR, true});
-    // Outer walls
-    world.solids.push_back({{{-25, 0, -25}, {-24.5f, 4, 25}}, COL_WALL});
-    world.solids.push_back({{{24.5f, 0, -25}, {25, 4, 25}}, COL_WALL});
-    world.solids.push_back({{{-25, 0, -25}, {25, 4, -24.5f}}, COL_WALL});
-    world.solids.push_back({{{-25, 0, 24.5f}, {25, 4, 25}}, COL_WALL});
-    // Some cover boxes
-    world.solids.push_back({{{-3, 0, -2}, {-1, 1.2f, 2}}, {110, 80, 60, 255}});
-    world.solids.push_back({{{1, 0, -2}, {3, 1.2f, 2}}, {110, 80, 60, 255}});
-    world.solids.push_back({{{-8, 0, 3}, {-6, 2.5f, 5}}, {80, 90, 80, 255}});
-    world.solids.push_back({{{6, 0, 3}, {8, 2.5f, 5}}, {80, 90, 80, 255}});
-    // Waypoints
-    world.waypoints = {
-        {{-10, 0, -8}, {1}},  {{0, 0, -8}, {0, 2}}, {{10, 0, -8}, {1, 3}},
-        {{10, 0, 0}, {2, 4}}, {{5, 0, 5}, {3, 5}},  {{-5, 0, 5}, {4, 0}},
-    };
-    // Objective
-    world.objective = {{5, 0, 8}, 3.0f, 0, false};
-    // Spawn points
-    md.spawns = {
-        {Team::ATTACK, {-12, 0.1f, -15}, 0.0f},
-        {Team::ATTACK, {-14, 0.1f, -13}, 0.2f},
-        {Team::ATTACK, {-10, 0.1f, -13}, -0.2f},
-        {Team::DEFEND, {12, 0.1f, 12}, (float)PI},
-        {Team::DEFEND, {14, 0.1f, 10}, (float)PI - 0.2f},
-        {Team::DEFEND, {10, 0.1f, 10}, (float)PI + 0.2f},
-    };
-  }
+  // --remote-view: the local world stands in for a server
+  ClientInterest viewInterest;
+  static SnapshotPacket viewPacket;
+  static Snapshot viewSnapshot;
+  PawnInterpolator remotePawns;
+  std::array<PawnPose, MAX_PAWNS> remotePoses;
 
-  // Initial round
-  ResetRound(world, md);
+  // The map loads while the menu is up; Start waits on the loading screen
+  MapData md;
+  std::unique_ptr<MapStreamer> streamer;   // set for maps over MAX_SOLIDS
+  bool mapInstalled = false;
+  bool calibrationShown = false;   // "Calibrating" frame is on screen
+  MapHotReload hotReload;   // re-applies edits to the map file live
 
   MenuSystem menu;
   bool quitIntent = false;
 
+  // --lockstep: peers step one World on everyone's commands.  The view
+  // turns with the last command sent, not the pawn, which runs
+  // LOCKSTEP_INPUT_DELAY ticks behind it.
+  static LockstepSession lockSession;
+  LockstepLink lockLink;
+  bool lockstep = lockPeers && lockLink.Open(lockSeat, lockPeers);
+  if (lockstep) {
+    world.humanSeats = lockLink.Seats();
+    world.playerID = lockLink.Seat();
+    remoteView = false;   // no snapshots: every peer holds the whole World
+  }
+  PlayerCommand lockView;
+  RoundState lockRound = RoundState::WAITING;
+  bool lockDesyncShown = false;
+  bool lockRefusedShown = false;
+  auto viewPawn = [&]() {
+    Pawn view = world.player();
+    if (lockstep) {
+      view.xform.yaw = DequantizeYaw(lockView.yaw);
+      view.xform.pitch = DequantizePitch(lockView.pitch);
+    }
+    return view;
+  };
+  // Poses before the last simulated tick; the renderer lerps from them to
+  // the current ones by how far `now` is into the next tick.
+  std::array<PawnPose, MAX_PAWNS> tickPoses{};
+  Vector3 tickEye = {};
+  float tickAlpha = 1.0f;
+  auto holdTickState = [&]() {
+    for (int i = 0; i < MAX_PAWNS; i++)
+      tickPoses[i] = PawnPose::Of(world.pawns[i]);
+    tickEye = viewPawn().eyePos();
+  };
+  auto startMatch = [&]() {
+    if (lockstep) {
+      StartLockstepMatch(world, md, lockSeed + lockLink.Epoch());
+      lockSession.Start(lockLink.Seat(), lockLink.Seats(), world, lockSeed + lockLink.Epoch(),
+                        loadJob.Path().c_str());
+      lockView.yaw = QuantizeYaw(world.player().xform.yaw);
+      lockView.pitch = QuantizePitch(world.player().xform.pitch);
+      lockRound = world.roundState;
+      lockDesyncShown = lockRefusedShown = false;
+    } else {
+      world.scoreAttack = 0;
+      world.scoreDefend = 0;
+      world.roundNumber = 1;
+      ResetRound(world, md);
+    }
+    viewInterest.Reset(world.playerID, world);
+    remotePawns.Reset();
+    holdTickState();
+  };
+
   // ── Performance counters ──────────────────────────────────────────────
   double frameTimeAccum = 0;
   int frameCount = 0;
   float displayFPS = 0;
+  ProfilerOverlay profiler;
+  profiler.visible = probe.Enabled();
+  FramePacer pacer;
+  pacer.Init(GetMonitorRefreshRate(GetCurrentMonitor()));
+  startup.Phase("systems");
+
+  // Lockstep: run every tick all seats' commands are in for
+  auto stepLockstep = [&]() {
+    while (lockSession.Ready() && world.roundState != RoundState::MATCH_OVER) {
+      holdTickState();
+      lockSession.Step(world, md);
+      if (world.roundState == RoundState::WAITING && lockRound != RoundState::WAITING) {
+        lockView.yaw = QuantizeYaw(world.player().xform.yaw);   // respawned
+        lockView.pitch = QuantizePitch(world.player().xform.pitch);
+      }
+      lockRound = world.roundState;
+    }
+    if (lockSession.Refused() && !lockRefusedShown) {
+      lockRefusedShown = true;
+      profiler.visible = true;   // the match stays frozen; say why
+      profiler.Log(TextFormat("Lockstep: seat %d has another map, seed, tuning or peer list",
+                              lockSession.RefusedSeat()));
+    }
+    if (lockSession.Desynced() && !lockDesyncShown) {
+      lockDesyncShown = true;
+      profiler.Log(TextFormat("Lockstep: desync with seat %d at tick %u",
+                              lockSession.DesyncSeat(), lockSession.DesyncTick()));
+    }
+  };
+
+  // ── Fixed-tick clock (InputClock seconds) ────────────────────────────
+  double simClock = InputClock();   // end of the last simulated tick
+  uint32_t simTick = 0;
+  InputSnapshot carried;            // raylib fallback input not yet ticked
 
   // Enable cursor at startup for main menu
   EnableCursor();
@@ -107,15 +245,13 @@ int main() {
     if (dt > 0.05f)
       dt = 0.05f;
 
+    if (startupBench && menu.currentState == AppState::MAIN_MENU)
+      menu.startMatchRequested = true;
     if (menu.startMatchRequested) {
+      // The loading screen waits for the map (and calibration) if needed
       menu.startMatchRequested = false;
       menu.playAgainRequested = false;
-      world.scoreAttack = 0;
-      world.scoreDefend = 0;
-      world.roundNumber = 1;
-      ResetRound(world, md);
-      menu.currentState = AppState::PLAYING;
-      DisableCursor();
+      menu.currentState = AppState::LOADING;
     }
 
     // ── ESC to pause / resume ─────────────────────────────────────────
@@ -130,15 +266,139 @@ int main() {
       }
     }
 
+    // ── Map: install the worker's results, then upload in chunks ──────
+    if (!mapInstalled && loadJob.Finished()) {
+      MinimapBake minimap;
+      std::vector<MeshQuad> mapQuads;
+      loadJob.Install(world, md, streamer, minimap, mapQuads);
+      renderer.SetMinimap(std::move(minimap));
+      renderer.SetMapMesh(mapQuads, world.geometryVersion);
+      if (lockstep && streamer) {
+        TraceLog(LOG_WARNING, "Lockstep: streamed maps are not played in lockstep, playing locally");
+        lockstep = false;
+        world.humanSeats = 1;
+        world.playerID = 0;
+      }
+      if (!lockstep)   // an edit on one peer only would desync the rest
+        hotReload.Start(loadJob.Path());
+      mapInstalled = true;
+      startup.Milestone("map_ms");
+    } else if (mapInstalled && menu.currentState != AppState::LOADING) {
+      // ── Map hot reload: swap edits in between ticks ───────────────────
+      MinimapBake minimap;
+      std::vector<MeshQuad> mapQuads;
+      if (hotReload.Update(world, md, streamer, minimap, mapQuads) & RELOAD_SOLIDS) {
+        renderer.SetMinimap(std::move(minimap));
+        renderer.SetMapMesh(mapQuads, world.geometryVersion);
+      }
+    }
+    bool uploaded = mapInstalled && renderer.UploadMinimapRows(MINIMAP_UPLOAD_ROWS);
+    if (audio.Ready())
+      startup.Milestone("audio_ms");
+
+    // ── Loading: once the map is up, calibrate if needed and start ────
+    if (menu.currentState == AppState::LOADING) {
+      if (uploaded && calibrate && calibrationShown) {
+        // Blocks for about a second behind the "Calibrating" frame
+        bool msaaWas = quality.settings.msaa;
+        quality.settings = RunCalibration(world, md, renderer, quality.calibration);
+        quality.fingerprint = fingerprint;
+        quality.Save(QUALITY_FILE);
+        ApplyQualityCaps(quality.settings, world);
+        if (quality.settings.msaa != msaaWas)
+          TraceLog(LOG_INFO, "Quality: MSAA %s from the next launch",
+                   quality.settings.msaa ? "on" : "off");
+        calibrate = false;
+        startup.Milestone("calibrated_ms");
+      }
+      calibrationShown = uploaded && calibrate;
+      if (uploaded && !calibrate) {
+        startMatch();
+        menu.currentState = AppState::PLAYING;
+        DisableCursor();
+      }
+    }
+
     // ── Update Logic ──────────────────────────────────────────────────
+    // Fixed SIM_DT ticks catch the simulation up to now; each tick gets the
+    // input events stamped inside it.  Time beyond SIM_MAX_TICKS is dropped.
+    double now = InputClock();
+    bool lockLive = lockstep && menu.currentState != AppState::LOADING &&
+                    menu.currentState != AppState::MAIN_MENU;
+    if (lockLive)
+      lockLink.Receive(now, lockSession);
     if (menu.currentState == AppState::PLAYING) {
-      ProcessInput(world, dt, audio);
-      UpdateRound(world, md, dt);
-      if (world.roundState == RoundState::ACTIVE) {
-        UpdateBots(world, dt);
-        UpdateUtility(world, dt);
+      if (streamer) {
+        streamer->Update(world);
+        std::vector<MeshQuad> mapQuads;
+        uint32_t meshVersion = 0;
+        if (streamer->TakeMesh(mapQuads, meshVersion))
+          renderer.SetMapMesh(mapQuads, meshVersion);
       }
 
+      bool focused = IsWindowFocused();
+      if (!input.Available() && focused) {
+        // raylib only knows per-frame state; the next tick takes its edges
+        InputSnapshot f = PollRaylibInput();
+        carried.down     = f.down;
+        carried.pressed |= f.pressed;
+        carried.look     = Vector2Add(carried.look, f.look);
+        carried.wheel   += f.wheel;
+        if (carried.fireTime == 0.0)
+          carried.fireTime = f.fireTime;
+      }
+
+      for (int tick = 0; tick < SIM_MAX_TICKS && simClock + SIM_DT <= now; tick++) {
+        if (lockstep && !lockSession.CanSubmit())
+          break;   // stalled on a peer: the game waits, input with it
+        simClock += SIM_DT;
+        simTick++;
+        InputSnapshot in;
+        if (!focused) {
+          input.Discard(simClock);
+        } else if (input.Available()) {
+          input.Collect(simClock, in);
+        } else {
+          in = carried;
+          carried = InputSnapshot{};
+          carried.down = in.down;
+        }
+        if (probe.SelfTest())
+          probe.InjectSelfTest(in, simClock);
+
+        PlayerCommand cmd = BuildPlayerCommand(viewPawn(), in, simTick);
+        if (commandLog.Replaying())
+          commandLog.Read(cmd);
+        commandLog.Write(cmd);
+        if (lockstep) {
+          lockView = cmd;
+          lockSession.SubmitLocal(cmd);
+          stepLockstep();
+          if (world.roundState == RoundState::MATCH_OVER)
+            break;
+          continue;
+        }
+        const WeaponState &held = world.player().weapon;
+        WeaponID heldId = held.id;
+        int magBefore = held.ammoMag;
+        holdTickState();
+        ApplyPlayerCommand(world, world.player(), cmd, SIM_DT);
+        probe.Consumed(in, InputClock(), held.id == heldId && held.ammoMag < magBefore);
+        StepWorld(world, md, simTick, SIM_DT);
+        if (remoteView) {
+          UpdateInterest(viewInterest, world.playerID, world, SIM_DT);
+          viewPacket.size = (uint16_t)WriteSnapshot(world, simTick, world.playerID, viewInterest, viewPacket.bytes);
+          if (ReadSnapshot(viewPacket.bytes, viewPacket.size, viewSnapshot))
+            remotePawns.Push(viewSnapshot, InputClock(), SIM_TICK_HZ);
+        }
+        if (world.roundState == RoundState::MATCH_OVER)
+          break;
+      }
+      if (now - simClock > SIM_DT)
+        simClock = now - SIM_DT;   // behind by more than a tick: don't spiral
+      if (lockstep)
+        stepLockstep();   // commands that came in with no local tick due
+
       // Check if game transitioned to match over internally
       if (world.roundState == RoundState::MATCH_OVER) {
         menu.currentState = AppState::MATCH_OVER;
@@ -146,21 +406,42 @@ int main() {
         EnableCursor();
       }
 
-      renderer.SyncCamera(world.player(), dt);
+      tickAlpha = (float)std::clamp((now - simClock) / SIM_DT, 0.0, 1.0);
+      Pawn view = viewPawn();
+      renderer.SyncCamera(view, tickEye, tickAlpha, dt);
+      audio.Update(world, view.eyePos(), view.lookDir(), dt);
     } else if (menu.currentState == AppState::MATCH_OVER) {
       // Handle Match Over logic -> "Play Again" button overrides
       if (IsKeyPressed(KEY_ENTER) || menu.playAgainRequested) {
         menu.playAgainRequested = false;
-        world.scoreAttack = 0;
-        world.scoreDefend = 0;
-        world.roundNumber = 1;
-        ResetRound(world, md);
+        audio.StopAll();
+        if (lockstep)
+          lockLink.Restart();
+        startMatch();
         menu.currentState = AppState::PLAYING;
         DisableCursor();
       }
     }
 
+    if (lockLive)
+      lockLink.Flush(now, lockSession);
+
+    if (menu.currentState != AppState::PLAYING) {
+      input.Discard(now);
+      simClock = now;
+      carried = InputSnapshot{};
+    }
+
     // ── FPS counter ───────────────────────────────────────────────────
+    profiler.Update();
+    profiler.AddFrame(GetFrameTime());
+    if (IsKeyPressed(KEY_F5) && lockstep) {
+      profiler.Log("Tuning: reload is off in lockstep play");
+    } else if (IsKeyPressed(KEY_F5)) {
+      int changed = LoadTuning(TUNING_FILE);
+      profiler.Log(changed < 0 ? TextFormat("Tuning: cannot read %s", TUNING_FILE)
+                               : TextFormat("Tuning: %d value(s) changed", changed));
+    }
     frameTimeAccum += dt;
     frameCount++;
     if (frameTimeAccum >= 0.5) {
@@ -176,6 +457,16 @@ int main() {
     if (menu.currentState == AppState::PLAYING ||
         menu.currentState == AppState::PAUSED ||
         menu.currentState == AppState::MATCH_OVER) {
+      renderer.renderScale    = quality.settings.renderScale * pacer.Level().renderScale;
+      renderer.reducedEffects = pacer.Level().reducedEffects;
+      renderer.mapEdges       = quality.settings.mapEdges;
+      renderer.smokeLayers    = quality.settings.smokeLayers;
+      if (remoteView) {
+        remotePawns.Sample(InputClock(), dt, remotePoses);
+        renderer.remotePawns = &remotePoses;
+      }
+      renderer.tickPawns = &tickPoses;
+      renderer.tickAlpha = tickAlpha;
       renderer.DrawFrame(world, sw, sh);
 
       // FPS overlay (top-left, small)
@@ -200,7 +491,15 @@ int main() {
     }
 
     // Draw menus over the screen
-    if (menu.currentState == AppState::MAIN_MENU) {
+    if (menu.currentState == AppState::LOADING) {
+      float progress = mapInstalled
+          ? 1.0f - LOAD_SHARE_UPLOAD * (1.0f - renderer.MinimapUploadProgress())
+          : loadJob.Progress();
+      menu.DrawLoadingScreen(sw, sh, progress,
+                             calibrationShown ? "Calibrating"
+                             : mapInstalled   ? "Uploading"
+                                              : loadJob.StageName());
+    } else if (menu.currentState == AppState::MAIN_MENU) {
       menu.DrawMainMenu(sw, sh, quitIntent);
     } else if (menu.currentState == AppState::PAUSED) {
       DrawRectangle(0, 0, sw, sh,
@@ -210,13 +509,26 @@ int main() {
       DrawRectangle(0, 0, sw, sh, {0, 0, 0, 200});
       menu.DrawMatchOverScreen(sw, sh, world);
     }
+    profiler.Draw(probe, pacer, 8, 52);
     EndDrawing();
+    probe.Presented(InputClock(), renderer.renderTarget);
+    if (menu.currentState == AppState::MAIN_MENU)
+      startup.Milestone("menu_ms");
+    if (menu.currentState == AppState::PLAYING && startup.Milestone("playable_ms")) {
+      startup.Report();
+      quitIntent |= startupBench;
+    }
+
+    // ── Pace: hold the ladder's rate, shedding load before the SoC throttles
+    if (pacer.Govern())
+      profiler.Log(pacer.Decision());
+    pacer.Pace();
   }
 
   // ── Cleanup ───────────────────────────────────────────────────────────
   renderer.Shutdown();
+  input.Shutdown();
   audio.Shutdown();
-  CloseAudioDevice();
   CloseWindow();
   return 0;
 }
\ No newline at end of file
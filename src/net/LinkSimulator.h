@@ -0,0 +1,103 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  LinkSimulator.h  –  One direction of a lossy, laggy loopback link
+//
+//  Send() drops a datagram with probability lossPct, or holds it for
+//  latencyMs plus a uniform 0..jitterMs, so packets can overtake each
+//  other.  With duplicatePct a packet also arrives a second time.
+//  Receive() hands out whatever is due, oldest deadline first.  Time is
+//  whatever clock the caller passes, so a soak test can run faster than
+//  real time.  Draws come from its own SimRandom, so a seed replays the
+//  same losses.  The in-flight pool is sized once; a full pool drops.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../SimRandom.h"
+#include "NetChannel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+constexpr int LINK_MAX_IN_FLIGHT = 1024;
+
+struct LinkConfig {
+    float lossPct      = 0.0f;
+    float latencyMs    = 0.0f;   // one way
+    float jitterMs     = 0.0f;   // extra 0..jitterMs per packet
+    float duplicatePct = 0.0f;
+};
+
+struct LinkStats {
+    uint64_t sent       = 0;
+    uint64_t dropped    = 0;
+    uint64_t duplicated = 0;
+    uint64_t delivered  = 0;
+    uint64_t reordered  = 0;   // delivered after a packet sent later
+};
+
+class LinkSimulator {
+public:
+    explicit LinkSimulator(LinkConfig cfg = {}, uint64_t seed = 1) : cfg(cfg), pool(LINK_MAX_IN_FLIGHT) {
+        rng.Seed(seed);
+    }
+
+    void Send(double now, const uint8_t* data, int size) {
+        stats.sent++;
+        if(size > NET_MTU || rng.Float() * 100.0f < cfg.lossPct) {
+            stats.dropped++;
+            return;
+        }
+        Queue(now, data, size);
+        if(rng.Float() * 100.0f < cfg.duplicatePct) {
+            stats.duplicated++;
+            Queue(now, data, size);
+        }
+    }
+
+    // Copies the next due datagram to out (NET_MTU bytes); its size, or 0.
+    int Receive(double now, uint8_t* out) {
+        int best = -1;
+        for(int i = 0; i < inFlight; i++)
+            if(pool[i].due <= now && (best < 0 || pool[i].due < pool[best].due ||
+                                      (pool[i].due == pool[best].due && pool[i].order < pool[best].order)))
+                best = i;
+        if(best < 0) return 0;
+        Packet& p = pool[best];
+        int size = p.size;
+        memcpy(out, p.bytes, size);
+        if(p.order < lastOrder) stats.reordered++;
+        lastOrder = std::max(lastOrder, p.order);
+        p = pool[--inFlight];
+        stats.delivered++;
+        return size;
+    }
+
+    const LinkStats& Stats() const { return stats; }
+
+private:
+    struct Packet {
+        double   due   = 0.0;
+        uint64_t order = 0;
+        int      size  = 0;
+        uint8_t  bytes[NET_MTU];
+    };
+
+    void Queue(double now, const uint8_t* data, int size) {
+        if(inFlight == LINK_MAX_IN_FLIGHT) {
+            stats.dropped++;
+            return;
+        }
+        Packet& p = pool[inFlight++];
+        p.due   = now + (cfg.latencyMs + rng.Float() * cfg.jitterMs) / 1000.0;
+        p.order = nextOrder++;
+        p.size  = size;
+        memcpy(p.bytes, data, size);
+    }
+
+    LinkConfig          cfg;
+    SimRandom           rng;
+    std::vector<Packet> pool;   // first inFlight are live
+    int                 inFlight  = 0;
+    uint64_t            nextOrder = 0;
+    uint64_t            lastOrder = 0;
+    LinkStats           stats;
+};
@@ -0,0 +1,406 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  Lockstep.h  –  Peer-to-peer play where only commands cross the wire
+//
+//  For LAN games between Pis a server is overkill.  Every peer runs the
+//  whole World.  The only thing sent is each peer's own 16-byte
+//  PlayerCommand per tick.  Tick t runs once every human seat's command
+//  for t is in, applied in seat order and then StepWorld, the same as
+//  MatchHost.  Bots are simulated on every peer from the shared seed.
+//  Local commands are stamped LOCKSTEP_INPUT_DELAY ticks ahead, so a
+//  peer's command normally arrives before anyone needs it.  A late one
+//  stalls every peer rather than letting them drift apart.
+//
+//  Commands ride as each NetChannel's unreliable payload.  Each packet
+//  carries every command the peer has not acked yet, up to
+//  LOCKSTEP_MAX_SEND, so a lost packet is covered by the next one with no
+//  resend timer.  The other direction acks by saying how far its
+//  contiguous run of commands reaches.
+//
+//  Before tick 0 each peer sends every other a reliable hello: the
+//  MatchEvents hello (version, tick rate, MapHash, tuning values) plus
+//  the match seed and seat mask.  Nothing runs until every peer's hello has arrived and
+//  matches our own.  One that differs stops the session for good
+//  (Refused()), since those peers would desync from the first tick.
+//
+//  Every LOCKSTEP_HASH_EVERY ticks each peer hashes its World (WorldHash)
+//  and sends the hash reliably.  A hash that differs from the local one
+//  for the same tick is a desync.  It is reported once with the tick and
+//  seat, and the peers play on.  A desync means the World or a float path
+//  is not deterministic: see SimMath.h and -ffp-contract=off.
+//
+//  Commands and hashes are kept in fixed rings, one NetChannel per seat.
+//  At about 0.5 MB the session is too large for the stack, so keep it
+//  static.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../World.h"
+#include "../game/InputSystem.h"
+#include "../game/MapLoader.h"
+#include "../game/PlayerCommand.h"
+#include "../game/RoundManager.h"
+#include "../game/WorldHash.h"
+#include "MatchEvents.h"
+#include "NetChannel.h"
+#include "UdpSocket.h"
+#include <raylib.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+constexpr uint32_t LOCKSTEP_INPUT_DELAY = 4;     // ticks between sampling and running a command
+constexpr uint32_t LOCKSTEP_WINDOW      = 128;   // commands kept per seat (power of two)
+constexpr int      LOCKSTEP_MAX_SEND    = 48;    // commands per packet, oldest unacked first
+constexpr uint32_t LOCKSTEP_HASH_EVERY  = 25;    // ticks between World hashes
+constexpr int      LOCKSTEP_HASHES      = 16;    // hashes kept per seat (power of two)
+constexpr int      LOCKSTEP_HEADER      = 10;    // u8 seat, u32 ack, u32 first tick, u8 count
+constexpr uint8_t  LOCKSTEP_MSG_HASH    = 1;
+constexpr uint8_t  LOCKSTEP_MSG_HELLO   = 2;   // u8 type, WriteHello, u64 seed, u8 seats
+
+static_assert((LOCKSTEP_WINDOW & (LOCKSTEP_WINDOW - 1)) == 0, "LOCKSTEP_WINDOW must be a power of two");
+static_assert((LOCKSTEP_HASHES & (LOCKSTEP_HASHES - 1)) == 0, "LOCKSTEP_HASHES must be a power of two");
+static_assert(LOCKSTEP_HEADER + LOCKSTEP_MAX_SEND * (int)sizeof(PlayerCommand) <= NET_MAX_UNRELIABLE,
+              "a command window must fit one datagram");
+static_assert(LOCKSTEP_HASHES * LOCKSTEP_HASH_EVERY > LOCKSTEP_WINDOW,
+              "a peer can run LOCKSTEP_WINDOW ticks ahead; keep its hashes until ours catch up");
+
+struct LockstepStats {
+    uint64_t ticks          = 0;
+    uint64_t stalls         = 0;   // Ready() false: a peer's command was missing
+    uint64_t hashesCompared = 0;
+    uint64_t commandsSent   = 0;   // including repeats
+};
+
+class LockstepSession {
+public:
+    // seats: bit per seat a peer plays (World::humanSeats); local is ours.
+    // Call with the World as StartLockstepMatch(seed) left it, identical on
+    // every peer; the hello checks that the peers agree.
+    void Start(int local, uint8_t seats, const World& world, uint64_t seed, const char* mapName) {
+        localSeat = local;
+        seatMask  = seats;
+        tick      = 0;
+        desyncTick = 0;
+        desyncSeat = -1;
+        helloWait  = (uint8_t)(seats & ~(1u << local));
+        refusedSeat = -1;
+        matchSeed  = seed;
+        mapHash    = MapHash(world);
+        stats     = LockstepStats{};
+        for(int s = 0; s < MAX_PAWNS; s++) {
+            Seat& seat = seatState[s];
+            seat.channel.Reset();
+            seat.have  = LOCKSTEP_INPUT_DELAY;
+            seat.acked = LOCKSTEP_INPUT_DELAY;
+            seat.hashes.fill(HashAt{});
+            // The first ticks, before anyone's input lands, hold the spawn view
+            for(uint32_t t = 0; t < LOCKSTEP_INPUT_DELAY; t++) {
+                PlayerCommand& c = seat.cmds[t];
+                c       = PlayerCommand{};
+                c.tick  = t;
+                c.yaw   = QuantizeYaw(world.pawns[s].xform.yaw);
+                c.pitch = QuantizePitch(world.pawns[s].xform.pitch);
+            }
+        }
+        localHashes.fill(HashAt{});
+
+        uint8_t msg[NET_MAX_MESSAGE];
+        msg[0] = LOCKSTEP_MSG_HELLO;
+        int n = 1 + WriteHello(msg + 1, SIM_TICK_HZ, world, mapName);
+        memcpy(msg + n, &seed, 8);
+        msg[n + 8] = seats;
+        for(int s = 0; s < MAX_PAWNS; s++)
+            if(IsPeer(s)) seatState[s].channel.SendReliable(msg, n + 9);
+    }
+
+    // ── Local input ──────────────────────────────────────────────────────────
+    // The tick the next local command is for.
+    uint32_t InputTick() const { return seatState[localSeat].have; }
+
+    // False while the simulation is stalled on a peer (our commands already
+    // reach LOCKSTEP_INPUT_DELAY ticks past it) or a peer has acked nothing
+    // for LOCKSTEP_WINDOW ticks.  Input waits, so a stall freezes the game
+    // instead of piling up delay.
+    bool CanSubmit() const {
+        const Seat& me = seatState[localSeat];
+        if(me.have - tick > LOCKSTEP_INPUT_DELAY) return false;
+        for(int s = 0; s < MAX_PAWNS; s++)
+            if(IsPeer(s) && me.have - seatState[s].acked >= LOCKSTEP_WINDOW) return false;
+        return true;
+    }
+
+    bool SubmitLocal(PlayerCommand cmd) {
+        if(!CanSubmit()) return false;
+        Seat& me = seatState[localSeat];
+        cmd.tick = me.have;
+        me.cmds[me.have++ & (LOCKSTEP_WINDOW - 1)] = cmd;
+        return true;
+    }
+
+    // ── Simulation ───────────────────────────────────────────────────────────
+    uint32_t Tick() const { return tick; }
+
+    bool Ready() const {
+        if(helloWait) return false;
+        for(int s = 0; s < MAX_PAWNS; s++)
+            if((seatMask & (1u << s)) && seatState[s].have <= tick) return false;
+        return true;
+    }
+
+    // Runs tick Tick(); the caller checks Ready() first.  Returns false (and
+    // counts a stall) when a command is missing.
+    bool Step(World& world, const MapData& md) {
+        if(!Ready()) {
+            stats.stalls++;
+            return false;
+        }
+        for(int s = 0; s < MAX_PAWNS; s++) {
+            if(!(seatMask & (1u << s))) continue;
+            ApplyPlayerCommand(world, world.pawns[s], seatState[s].cmds[tick & (LOCKSTEP_WINDOW - 1)], SIM_DT);
+        }
+        StepWorld(world, md, tick, SIM_DT);
+        tick++;
+        stats.ticks++;
+
+        if(tick % LOCKSTEP_HASH_EVERY == 0) {
+            HashAt mine = { tick, WorldHash(world), true };
+            localHashes[(tick / LOCKSTEP_HASH_EVERY) & (LOCKSTEP_HASHES - 1)] = mine;
+            uint8_t msg[13];
+            msg[0] = LOCKSTEP_MSG_HASH;
+            memcpy(msg + 1, &mine.tick, 4);
+            memcpy(msg + 5, &mine.hash, 8);
+            for(int s = 0; s < MAX_PAWNS; s++) {
+                if(!IsPeer(s)) continue;
+                seatState[s].channel.SendReliable(msg, sizeof(msg));
+                Compare(s, mine);
+            }
+        }
+        return true;
+    }
+
+    // ── Transport ────────────────────────────────────────────────────────────
+    // Once per frame after submitting; send(int seat, const uint8_t*, int)
+    // gets each datagram for that seat's peer.
+    template<class SendFn>
+    void Flush(double now, SendFn&& send) {
+        const Seat& me = seatState[localSeat];
+        for(int s = 0; s < MAX_PAWNS; s++) {
+            if(!IsPeer(s)) continue;
+            Seat&    peer  = seatState[s];
+            uint32_t first = peer.acked;
+            int      count = (int)std::min<uint32_t>(me.have - first, LOCKSTEP_MAX_SEND);
+            uint8_t  buf[LOCKSTEP_HEADER + LOCKSTEP_MAX_SEND * sizeof(PlayerCommand)];
+            buf[0] = (uint8_t)localSeat;
+            memcpy(buf + 1, &peer.have, 4);   // their commands we hold: the ack
+            memcpy(buf + 5, &first, 4);
+            buf[9] = (uint8_t)count;
+            for(int i = 0; i < count; i++)
+                memcpy(buf + LOCKSTEP_HEADER + i * sizeof(PlayerCommand),
+                       &me.cmds[(first + i) & (LOCKSTEP_WINDOW - 1)], sizeof(PlayerCommand));
+            stats.commandsSent += count;
+            peer.channel.Flush(now, buf, LOCKSTEP_HEADER + count * (int)sizeof(PlayerCommand),
+                               [&](const uint8_t* d, int n) { send(s, d, n); });
+        }
+    }
+
+    // A datagram from seat's peer.
+    void Receive(double now, int seat, const uint8_t* data, int size) {
+        if(!IsPeer(seat)) return;
+        Seat& peer = seatState[seat];
+        peer.channel.Receive(now, data, size, [&](const uint8_t* p, int n) {
+            if(n < LOCKSTEP_HEADER || p[0] != seat) return;
+            uint32_t ack, first;
+            memcpy(&ack, p + 1, 4);
+            memcpy(&first, p + 5, 4);
+            int count = p[9];
+            if(n < LOCKSTEP_HEADER + count * (int)sizeof(PlayerCommand)) return;
+            if((int32_t)(ack - peer.acked) > 0 && ack <= seatState[localSeat].have) peer.acked = ack;
+            for(int i = 0; i < count; i++) {
+                uint32_t t = first + i;
+                if(t != peer.have) continue;                      // repeat, or a gap
+                if(t - tick >= LOCKSTEP_WINDOW) break;            // would overwrite a tick not run yet
+                PlayerCommand& c = peer.cmds[t & (LOCKSTEP_WINDOW - 1)];
+                memcpy(&c, p + LOCKSTEP_HEADER + i * sizeof(PlayerCommand), sizeof(PlayerCommand));
+                c.tick = t;
+                peer.have++;
+            }
+        });
+        uint8_t msg[NET_MAX_MESSAGE];
+        for(int n; (n = peer.channel.PopReliable(msg)) >= 0; ) {
+            if(n > 10 && msg[0] == LOCKSTEP_MSG_HELLO) {
+                CheckHello(seat, msg + 1, n - 10);
+                continue;
+            }
+            if(n != 13 || msg[0] != LOCKSTEP_MSG_HASH) continue;
+            HashAt theirs;
+            memcpy(&theirs.tick, msg + 1, 4);
+            memcpy(&theirs.hash, msg + 5, 8);
+            theirs.valid = true;
+            peer.hashes[(theirs.tick / LOCKSTEP_HASH_EVERY) & (LOCKSTEP_HASHES - 1)] = theirs;
+            Compare(seat, localHashes[(theirs.tick / LOCKSTEP_HASH_EVERY) & (LOCKSTEP_HASHES - 1)]);
+        }
+    }
+
+    // A peer's hello did not match ours; the session never starts.
+    bool     Refused()     const { return refusedSeat >= 0; }
+    int      RefusedSeat() const { return refusedSeat; }
+    bool     Desynced()   const { return desyncSeat >= 0; }
+    uint32_t DesyncTick() const { return desyncTick; }
+    int      DesyncSeat() const { return desyncSeat; }
+    bool     IsPeer(int s) const { return s != localSeat && (seatMask & (1u << s)); }
+    const LockstepStats&   Stats() const { return stats; }
+    const NetChannelStats& ChannelStats(int seat) const { return seatState[seat].channel.Stats(); }
+    float                  RttMs(int seat) const { return seatState[seat].channel.RttMs(); }
+
+private:
+    struct HashAt {
+        uint32_t tick  = 0;
+        uint64_t hash  = 0;
+        bool     valid = false;
+    };
+
+    struct Seat {
+        std::array<PlayerCommand, LOCKSTEP_WINDOW> cmds{};
+        uint32_t   have  = 0;   // commands held for every tick below this
+        uint32_t   acked = 0;   // this peer holds ours below this
+        NetChannel channel;
+        std::array<HashAt, LOCKSTEP_HASHES> hashes{};
+    };
+
+    // in: the WriteHello bytes, then the seed and seat mask
+    void CheckHello(int seat, const uint8_t* in, int size) {
+        MatchHello h;
+        uint64_t   seed;
+        memcpy(&seed, in + size, 8);
+        uint8_t    seats = in[size + 8];
+        const char* what = nullptr;
+        if(!ReadHello(in, size, h) || h.version != NET_GAME_VERSION) what = "game version";
+        else if(h.tickHz != SIM_TICK_HZ)                             what = "tick rate";
+        else if(h.mapHash != mapHash)                                what = "map";
+        else if(seed != matchSeed)                                   what = "seed";
+        else if(seats != seatMask)                                   what = "peer list";
+        else
+            for(const TuningField& f : TUNING_FIELDS)
+                if(memcmp(&(h.tuning.*f.member), &(Tune().*f.member), sizeof(float)) != 0) what = f.key;
+        if(!what) {
+            helloWait &= (uint8_t)~(1u << seat);
+            return;
+        }
+        if(refusedSeat < 0) {
+            refusedSeat = seat;
+            TraceLog(LOG_WARNING, "Lockstep: seat %d (%s) differs in %s, not starting", seat, h.map, what);
+        }
+    }
+
+    // mine is the local hash for some tick; check seat's for the same tick
+    void Compare(int seat, const HashAt& mine) {
+        const HashAt& theirs = seatState[seat].hashes[(mine.tick / LOCKSTEP_HASH_EVERY) & (LOCKSTEP_HASHES - 1)];
+        if(!mine.valid || !theirs.valid || theirs.tick != mine.tick) return;
+        stats.hashesCompared++;
+        if(theirs.hash != mine.hash && desyncSeat < 0) {
+            desyncSeat = seat;
+            desyncTick = mine.tick;
+            TraceLog(LOG_WARNING, "Lockstep: desync with seat %d at tick %u (%016llx vs %016llx)", seat,
+                     mine.tick, (unsigned long long)mine.hash, (unsigned long long)theirs.hash);
+        }
+    }
+
+    std::array<Seat, MAX_PAWNS>         seatState{};
+    std::array<HashAt, LOCKSTEP_HASHES> localHashes{};
+    int      localSeat  = 0;
+    uint8_t  seatMask   = 0;
+    uint32_t tick       = 0;   // next tick to run
+    uint32_t desyncTick = 0;
+    int      desyncSeat = -1;
+    uint8_t  helloWait  = 0;   // peers whose matching hello has not come in
+    int      refusedSeat = -1;
+    uint64_t matchSeed  = 0;
+    uint64_t mapHash    = 0;
+    LockstepStats stats;
+};
+
+// ─── Match start ────────────────────────────────────────────────────────────
+// Every peer calls this with the same seed for every match, so they all
+// start from the same World.  It also clears what ResetRound leaves alone
+// (pawn stride timers, the noise ring), which calibration or an earlier
+// match may have left different on each peer.
+inline void StartLockstepMatch(World& world, const MapData& md, uint64_t seed) {
+    for(Pawn& p : world.pawns) p = Pawn{};
+    world.noises      = NoiseRing{};
+    world.rng.Seed(seed);
+    world.scoreAttack = 0;
+    world.scoreDefend = 0;
+    world.roundNumber = 1;
+    ResetRound(world, md);
+}
+
+// ─── UDP between peers ──────────────────────────────────────────────────────
+// The game's transport: one socket and a fixed address per seat.  Each
+// datagram starts with the match epoch, which counts "play again"
+// restarts, so packets left over from the last match are dropped.
+class LockstepLink {
+public:
+    // list: one entry per seat from seat 0, "a.b.c.d:port" for a peer or
+    // "-" for a bot; seats past the end are bots.  Our own entry's port is
+    // the one we bind.
+    bool Open(int seat, const char* list) {
+        localSeat = seat;
+        seatMask  = 0;
+        const char* at = list;
+        for(int s = 0; ; s++) {
+            const char* end = strchr(at, ',');
+            size_t len = end ? (size_t)(end - at) : strlen(at);
+            char entry[32] = "";
+            bool ok = s < MAX_PAWNS && len < sizeof(entry);
+            if(ok) memcpy(entry, at, len);
+            if(ok && strcmp(entry, "-") != 0) {
+                ok = UdpAddress::Parse(entry, peers[s]);
+                seatMask |= (uint8_t)(1u << s);
+            }
+            if(!ok) {
+                TraceLog(LOG_WARNING, "Lockstep: cannot read peer list \"%s\"", list);
+                return false;
+            }
+            if(!end) break;
+            at = end + 1;
+        }
+        if(seat < 0 || seat >= MAX_PAWNS || !(seatMask & (1u << seat))) {
+            TraceLog(LOG_WARNING, "Lockstep: seat %d has no address in \"%s\"", seat, list);
+            return false;
+        }
+        if(!socket.Open(peers[seat].port)) return false;
+        TraceLog(LOG_INFO, "Lockstep: seat %d of seats 0x%02x, port %u", seat, seatMask, socket.Port());
+        return true;
+    }
+
+    int     Seat()  const { return localSeat; }
+    uint8_t Seats() const { return seatMask; }
+    uint8_t Epoch() const { return epoch; }
+    void    Restart()     { epoch++; }
+
+    void Receive(double now, LockstepSession& session) {
+        uint8_t    buf[NET_MTU + 1];
+        UdpAddress from;
+        while(int n = socket.Receive(buf, sizeof(buf), from)) {
+            if(n < 2 || buf[0] != epoch) continue;
+            for(int s = 0; s < MAX_PAWNS; s++)
+                if(session.IsPeer(s) && peers[s] == from) session.Receive(now, s, buf + 1, n - 1);
+        }
+    }
+
+    void Flush(double now, LockstepSession& session) {
+        session.Flush(now, [&](int seat, const uint8_t* data, int size) {
+            uint8_t buf[NET_MTU + 1];
+            buf[0] = epoch;
+            memcpy(buf + 1, data, size);
+            socket.Send(peers[seat], buf, size + 1);
+        });
+    }
+
+private:
+    UdpSocket  socket;
+    std::array<UdpAddress, MAX_PAWNS> peers{};
+    int        localSeat = 0;
+    uint8_t    seatMask  = 0;
+    uint8_t    epoch     = 0;
+};
@@ -0,0 +1,208 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MatchEvents.h  –  What a client must not miss, as reliable messages
+//
+//  Snapshots can be lost because the next one replaces them.  A kill, a
+//  score or a round change seen in a lost snapshot would go unnoticed, so
+//  each goes on NetChannel's reliable stream as well.  MatchEventWatcher
+//  compares the World with its last look once per tick and emits one
+//  message per change: kills first, then the score, then the round state.
+//
+//  The hello opens a connection.  It carries the protocol version, the
+//  tick rate, a hash of the map geometry so a client with a different
+//  map file refuses to play, and the server's tuning values in
+//  TUNING_FIELDS order, so a client can predict with the server's numbers
+//  rather than its own tuning.ini.
+//
+//  Every message starts with u8 MatchEventType and u32 tick.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Hash.h"
+#include "../Tuning.h"
+#include "../World.h"
+#include "../server/Snapshot.h"
+#include "NetChannel.h"
+#include <cstdint>
+#include <cstring>
+
+constexpr uint16_t NET_GAME_VERSION = 1;
+constexpr int      NET_MAP_NAME     = 64;
+constexpr int      TUNING_FIELD_COUNT = (int)(sizeof(TUNING_FIELDS) / sizeof(TUNING_FIELDS[0]));
+
+static_assert(SNAPSHOT_MAX_BYTES <= NET_MAX_UNRELIABLE, "a snapshot must fit one datagram");
+
+enum class MatchEventType : uint8_t { HELLO = 1, ROUND, KILL, SCORE };
+
+struct MatchEvent {
+    MatchEventType type   = MatchEventType::ROUND;
+    uint32_t   tick        = 0;
+    RoundState round       = RoundState::WAITING;   // ROUND
+    uint8_t    roundNumber = 0;
+    Team       winner      = Team::NONE;
+    int8_t     victim      = -1;                    // KILL
+    int8_t     killer      = -1;                    // -1: unknown
+    uint8_t    scoreAttack = 0, scoreDefend = 0;    // SCORE
+};
+
+struct MatchHello {
+    uint16_t     version = 0;
+    uint16_t     tickHz  = 0;
+    uint64_t     mapHash = 0;
+    TuningValues tuning  = TUNING_DEFAULTS;
+    char         map[NET_MAP_NAME] = "";
+};
+
+// Geometry, waypoints and objective: everything a map file decides.
+inline uint64_t MapHash(const World& world) {
+    Fnv1a h;
+    h.U32((uint32_t)world.solids.size());
+    for(const MapSolid& s : world.solids) {
+        h.Vec(s.bounds.min);
+        h.Vec(s.bounds.max);
+        h.U8(s.isFloor);
+    }
+    h.U32((uint32_t)world.waypoints.size());
+    for(const Waypoint& w : world.waypoints) {
+        h.Vec(w.pos);
+        for(int n : w.neighbours) h.U32((uint32_t)n);
+    }
+    h.Vec(world.objective.pos);
+    h.F32(world.objective.radius);
+    return h.value;
+}
+
+// ─── Encode / decode ────────────────────────────────────────────────────────
+// out holds NET_MAX_MESSAGE; returns the bytes written.
+inline int WriteHello(uint8_t* out, int tickHz, const World& world, const char* mapName) {
+    SnapWriter w{ out };
+    w.U8((uint8_t)MatchEventType::HELLO);
+    w.U32(0);
+    w.U16(NET_GAME_VERSION);
+    w.U16((uint32_t)tickHz);
+    uint64_t hash = MapHash(world);
+    w.U32((uint32_t)hash);
+    w.U32((uint32_t)(hash >> 32));
+    w.U8(TUNING_FIELD_COUNT);
+    for(const TuningField& f : TUNING_FIELDS) w.F32(Tune().*f.member);
+    int len = (int)strnlen(mapName, NET_MAP_NAME - 1);
+    w.U8((uint32_t)len);
+    for(int i = 0; i < len; i++) w.U8((uint8_t)mapName[i]);
+    return w.size;
+}
+
+inline bool ReadHello(const uint8_t* in, int size, MatchHello& h) {
+    SnapReader r{ in, size };
+    if(r.U8() != (uint32_t)MatchEventType::HELLO) return false;
+    r.U32();
+    h.version = (uint16_t)r.U16();
+    h.tickHz  = (uint16_t)r.U16();
+    uint64_t lo = r.U32();
+    h.mapHash = lo | ((uint64_t)r.U32() << 32);
+    if(r.U8() != (uint32_t)TUNING_FIELD_COUNT) return false;   // built from another table
+    for(const TuningField& f : TUNING_FIELDS) h.tuning.*f.member = r.F32();
+    int len = (int)r.U8();
+    for(int i = 0; i < len && i < NET_MAP_NAME - 1; i++) h.map[i] = (char)r.U8();
+    h.map[std::min(len, NET_MAP_NAME - 1)] = '\0';
+    return r.ok && r.at == size;
+}
+
+inline int WriteMatchEvent(uint8_t* out, const MatchEvent& e) {
+    SnapWriter w{ out };
+    w.U8((uint8_t)e.type);
+    w.U32(e.tick);
+    switch(e.type) {
+        case MatchEventType::ROUND: w.U8((uint8_t)e.round); w.U8(e.roundNumber); w.U8((uint8_t)e.winner); break;
+        case MatchEventType::KILL:  w.U8((uint8_t)e.victim); w.U8((uint8_t)e.killer);                    break;
+        case MatchEventType::SCORE: w.U8(e.scoreAttack); w.U8(e.scoreDefend);                            break;
+        case MatchEventType::HELLO: break;
+    }
+    return w.size;
+}
+
+inline bool ReadMatchEvent(const uint8_t* in, int size, MatchEvent& e) {
+    SnapReader r{ in, size };
+    e.type = (MatchEventType)r.U8();
+    e.tick = r.U32();
+    switch(e.type) {
+        case MatchEventType::ROUND:
+            e.round       = (RoundState)r.U8();
+            e.roundNumber = (uint8_t)r.U8();
+            e.winner      = (Team)r.U8();
+            break;
+        case MatchEventType::KILL:
+            e.victim = (int8_t)r.U8();
+            e.killer = (int8_t)r.U8();
+            break;
+        case MatchEventType::SCORE:
+            e.scoreAttack = (uint8_t)r.U8();
+            e.scoreDefend = (uint8_t)r.U8();
+            break;
+        default:
+            return false;   // HELLO goes through ReadHello
+    }
+    return r.ok && r.at == size;
+}
+
+// ─── Server side ────────────────────────────────────────────────────────────
+class MatchEventWatcher {
+public:
+    void Reset(const World& world) {
+        round       = world.roundState;
+        roundNumber = world.roundNumber;
+        scoreAttack = world.scoreAttack;
+        scoreDefend = world.scoreDefend;
+        alive       = AliveMask(world);
+    }
+
+    // After each tick; emit(const uint8_t*, int) gets each encoded event.
+    template<class EmitFn>
+    void Poll(const World& world, uint32_t tick, EmitFn&& emit) {
+        uint8_t buf[32];
+        uint8_t now = AliveMask(world);
+        for(int i = 0; i < MAX_PAWNS; i++) {
+            if(!(alive & ~now & (1u << i))) continue;
+            MatchEvent e;
+            e.type   = MatchEventType::KILL;
+            e.tick   = tick;
+            e.victim = (int8_t)i;
+            e.killer = (int8_t)world.pawns[i].lastAttacker;
+            emit((const uint8_t*)buf, WriteMatchEvent(buf, e));
+        }
+        alive = now;
+
+        if(world.scoreAttack != scoreAttack || world.scoreDefend != scoreDefend) {
+            scoreAttack = world.scoreAttack;
+            scoreDefend = world.scoreDefend;
+            MatchEvent e;
+            e.type        = MatchEventType::SCORE;
+            e.tick        = tick;
+            e.scoreAttack = (uint8_t)scoreAttack;
+            e.scoreDefend = (uint8_t)scoreDefend;
+            emit((const uint8_t*)buf, WriteMatchEvent(buf, e));
+        }
+
+        if(world.roundState != round || world.roundNumber != roundNumber) {
+            round       = world.roundState;
+            roundNumber = world.roundNumber;
+            MatchEvent e;
+            e.type        = MatchEventType::ROUND;
+            e.tick        = tick;
+            e.round       = round;
+            e.roundNumber = (uint8_t)roundNumber;
+            e.winner      = world.roundWinner;
+            emit((const uint8_t*)buf, WriteMatchEvent(buf, e));
+        }
+    }
+
+private:
+    static uint8_t AliveMask(const World& world) {
+        uint8_t m = 0;
+        for(int i = 0; i < MAX_PAWNS; i++)
+            if(world.pawns[i].alive) m |= (uint8_t)(1u << i);
+        return m;
+    }
+
+    RoundState round       = RoundState::WAITING;
+    int        roundNumber = 0;
+    int        scoreAttack = 0, scoreDefend = 0;
+    uint8_t    alive       = 0;
+};
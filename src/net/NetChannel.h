@@ -0,0 +1,324 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  NetChannel.h  –  One peer's end of a UDP connection: acks, reliable
+//                   ordered messages, fragments and unreliable payloads
+//
+//  Every packet carries a 16-bit sequence number, the newest sequence
+//  received from the peer, and a 32-bit field acking the 32 before it.
+//  Acks ride on packets that go out anyway, so a lost ack is covered by
+//  the next packet.
+//
+//  Reliable messages (round changes, kills, scores, the hello) are split
+//  into NET_FRAGMENT_BYTES pieces.  Each piece gets a 16-bit message id
+//  and waits in a fixed window of NET_WINDOW slots until a packet that
+//  carried it is acked.  An unacked piece goes out again after about 1.5
+//  RTTs.  The receiver keeps pieces in the same window by id and hands
+//  out whole messages strictly in order (PopReliable).  Its window starts
+//  at the oldest message not yet popped, which can be behind the sender's
+//  oldest unacked piece.  A packet carrying a piece past it is left
+//  unacked, so the sender resends that piece once there is room.
+//
+//  The unreliable payload (the tick's snapshot) goes in the first packet
+//  of each Flush and reaches the callback in Receive at once.  It never
+//  waits behind a missing reliable piece, and it is never resent: the next
+//  tick's snapshot replaces it.
+//
+//  Packet:  u16 NET_PROTOCOL_ID, u16 seq, u16 ack, u32 ackBits, then
+//  records.  Unreliable record: u8 NET_REC_UNRELIABLE, u16 len, bytes.
+//  Reliable record: u8 NET_REC_RELIABLE (| NET_REC_MORE before the last
+//  piece), u16 id, u16 len, bytes.  All little-endian.
+//
+//  The channel does no I/O.  Flush hands finished packets to a callback,
+//  and Receive takes whatever the socket (UdpSocket) or link simulator
+//  (LinkSimulator) delivered.  Allocation-free.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+constexpr uint16_t NET_PROTOCOL_ID    = 0x4C54;   // "TL"
+constexpr int      NET_MTU            = 1200;     // bytes per datagram, under any path MTU
+constexpr int      NET_HEADER         = 10;
+constexpr int      NET_RECORD_HEADER  = 5;        // reliable; unreliable records use 3
+constexpr int      NET_FRAGMENT_BYTES = 512;
+constexpr int      NET_WINDOW         = 64;       // reliable pieces in flight (power of two)
+constexpr int      NET_MAX_MESSAGE    = NET_FRAGMENT_BYTES * 32;
+constexpr int      NET_MAX_UNRELIABLE = NET_MTU - NET_HEADER - 3;
+constexpr int      NET_PACKET_HISTORY = 256;      // sent packets remembered for acks
+constexpr int      NET_PIECES_PER_PACKET = 8;
+constexpr int      NET_FLUSH_PACKETS  = 4;        // most datagrams one Flush sends
+constexpr float    NET_RESEND_MIN     = 0.03f;    // seconds before an unacked piece goes again
+constexpr float    NET_RESEND_RTTS    = 1.5f;
+
+constexpr uint8_t  NET_REC_UNRELIABLE = 1;
+constexpr uint8_t  NET_REC_RELIABLE   = 2;
+constexpr uint8_t  NET_REC_MORE       = 0x80;     // another piece of this message follows
+
+static_assert((NET_WINDOW & (NET_WINDOW - 1)) == 0, "NET_WINDOW must be a power of two");
+static_assert(NET_MAX_MESSAGE / NET_FRAGMENT_BYTES <= NET_WINDOW, "a whole message must fit the window");
+static_assert(NET_HEADER + NET_RECORD_HEADER + NET_FRAGMENT_BYTES <= NET_MTU, "a piece must fit a packet");
+
+// a is newer than b, allowing for wrap
+inline bool SeqNewer(uint16_t a, uint16_t b) { return (int16_t)(a - b) > 0; }
+
+struct NetChannelStats {
+    uint64_t packetsSent     = 0;
+    uint64_t packetsReceived = 0;
+    uint64_t packetsAcked    = 0;
+    uint64_t packetsLost     = 0;   // fell out of the history unacked
+    uint64_t bytesSent       = 0;
+    uint64_t piecesSent      = 0;
+    uint64_t piecesResent    = 0;
+    uint64_t messagesQueued  = 0;
+    uint64_t messagesPopped  = 0;
+    uint64_t badPackets      = 0;   // wrong protocol id or truncated
+};
+
+class NetChannel {
+public:
+    void Reset() { *this = NetChannel{}; }
+
+    // Queues a reliable message; false if it is too large or the window
+    // has no room for its pieces (the caller retries or gives up).
+    bool SendReliable(const void* data, int size) {
+        int pieces = std::max(1, (size + NET_FRAGMENT_BYTES - 1) / NET_FRAGMENT_BYTES);
+        if(size < 0 || size > NET_MAX_MESSAGE) return false;
+        if((uint16_t)(sendNext - sendHead) + pieces > NET_WINDOW) return false;
+        const uint8_t* src = (const uint8_t*)data;
+        for(int i = 0; i < pieces; i++) {
+            OutPiece& p = sendWindow[sendNext & (NET_WINDOW - 1)];
+            p.id       = sendNext++;
+            p.size     = (uint16_t)std::min(NET_FRAGMENT_BYTES, size - i * NET_FRAGMENT_BYTES);
+            p.more     = i + 1 < pieces;
+            p.acked    = false;
+            p.lastSent = -1.0;
+            memcpy(p.bytes, src + i * NET_FRAGMENT_BYTES, p.size);
+        }
+        stats.messagesQueued++;
+        return true;
+    }
+
+    // Builds this tick's packets and hands each to send(const uint8_t*, int).
+    // unreliable may be null.  Sends nothing when there is nothing new to
+    // say and no ack owed.
+    template<class SendFn>
+    void Flush(double now, const uint8_t* unreliable, int unreliableSize, SendFn&& send) {
+        float resendAfter = std::max(NET_RESEND_MIN, rtt * NET_RESEND_RTTS);
+        uint16_t next = sendHead;   // first piece not yet looked at this flush
+        for(int n = 0; n < NET_FLUSH_PACKETS; n++) {
+            uint8_t    buf[NET_MTU];
+            int        at  = NET_HEADER;
+            SentPacket rec = { localSeq, now, true, false, 0, {} };
+
+            if(n == 0 && unreliable && unreliableSize > 0 && unreliableSize <= NET_MAX_UNRELIABLE) {
+                buf[at] = NET_REC_UNRELIABLE;
+                Put16(buf + at + 1, (uint16_t)unreliableSize);
+                memcpy(buf + at + 3, unreliable, unreliableSize);
+                at += 3 + unreliableSize;
+            }
+            for(; next != sendNext && rec.count < NET_PIECES_PER_PACKET; next++) {
+                OutPiece& p = sendWindow[next & (NET_WINDOW - 1)];
+                if(p.acked || (p.lastSent >= 0.0 && now - p.lastSent < resendAfter)) continue;
+                if(at + NET_RECORD_HEADER + p.size > NET_MTU) break;   // next packet
+                buf[at] = NET_REC_RELIABLE | (p.more ? NET_REC_MORE : 0);
+                Put16(buf + at + 1, p.id);
+                Put16(buf + at + 3, p.size);
+                memcpy(buf + at + NET_RECORD_HEADER, p.bytes, p.size);
+                at += NET_RECORD_HEADER + p.size;
+                if(p.lastSent >= 0.0) stats.piecesResent++;
+                stats.piecesSent++;
+                p.lastSent = now;
+                rec.pieces[rec.count++] = p.id;
+            }
+            if(at == NET_HEADER && (n > 0 || !ackOwed)) break;   // nothing to carry
+
+            SentPacket& slot = history[localSeq % NET_PACKET_HISTORY];
+            if(slot.valid && !slot.acked) stats.packetsLost++;
+            slot = rec;
+            Put16(buf + 0, NET_PROTOCOL_ID);
+            Put16(buf + 2, localSeq++);
+            Put16(buf + 4, remoteSeq);
+            Put32(buf + 6, ackBits);
+            ackOwed = false;
+            stats.packetsSent++;
+            stats.bytesSent += at;
+            send((const uint8_t*)buf, at);
+        }
+    }
+
+    // One datagram from the peer.  The unreliable payload, if any, goes to
+    // onUnreliable(const uint8_t*, int) at once; reliable pieces wait for
+    // PopReliable.  False for a packet that is not ours or is malformed.
+    template<class UnreliableFn>
+    bool Receive(double now, const uint8_t* data, int size, UnreliableFn&& onUnreliable) {
+        if(size < NET_HEADER || Get16(data) != NET_PROTOCOL_ID) {
+            stats.badPackets++;
+            return false;
+        }
+        uint16_t seq  = Get16(data + 2);
+        uint16_t ack  = Get16(data + 4);
+        uint32_t bits = Get32(data + 6);
+        stats.packetsReceived++;
+
+        ProcessAcks(now, ack, bits);
+        if(Seen(seq)) return true;   // duplicate: acks were all it had
+
+        bool stored = true;   // every reliable piece fit the window
+        for(int at = NET_HEADER; at < size; ) {
+            uint8_t kind = data[at];
+            if((kind & ~NET_REC_MORE) == NET_REC_UNRELIABLE && at + 3 <= size) {
+                int len = Get16(data + at + 1);
+                if(at + 3 + len > size) break;
+                onUnreliable(data + at + 3, len);
+                at += 3 + len;
+            } else if((kind & ~NET_REC_MORE) == NET_REC_RELIABLE && at + NET_RECORD_HEADER <= size) {
+                uint16_t id  = Get16(data + at + 1);
+                int      len = Get16(data + at + 3);
+                if(len > NET_FRAGMENT_BYTES || at + NET_RECORD_HEADER + len > size) break;
+                uint16_t ahead = (uint16_t)(id - recvNext);
+                if(ahead >= 0x8000) {
+                    // already delivered
+                } else if(ahead >= NET_WINDOW) {
+                    stored = false;   // past the window: must not be acked
+                } else {
+                    InPiece& p = recvWindow[id & (NET_WINDOW - 1)];
+                    if(!p.present || p.id != id) {
+                        p.id      = id;
+                        p.present = true;
+                        p.more    = kind & NET_REC_MORE;
+                        p.size    = (uint16_t)len;
+                        memcpy(p.bytes, data + at + NET_RECORD_HEADER, len);
+                    }
+                }
+                at += NET_RECORD_HEADER + len;
+            } else {
+                stats.badPackets++;
+                return false;
+            }
+        }
+        // Unacked, its pieces come again; a duplicate of it may hand the
+        // unreliable payload over twice, which snapshots and commands
+        // already drop by tick.
+        if(stored) {
+            MarkReceived(seq);
+            ackOwed = true;
+        }
+        return true;
+    }
+
+    // The next whole reliable message, in send order, copied to out (which
+    // holds NET_MAX_MESSAGE); its size, or -1 while it is incomplete.
+    int PopReliable(uint8_t* out) {
+        int size = 0, pieces = 0;
+        for(;;) {
+            const InPiece& p = recvWindow[(uint16_t)(recvNext + pieces) & (NET_WINDOW - 1)];
+            if(!p.present || p.id != (uint16_t)(recvNext + pieces) || pieces == NET_WINDOW) return -1;
+            pieces++;
+            if(!p.more) break;
+        }
+        for(int i = 0; i < pieces; i++) {
+            InPiece& p = recvWindow[recvNext++ & (NET_WINDOW - 1)];
+            memcpy(out + size, p.bytes, p.size);
+            size += p.size;
+            p.present = false;
+        }
+        stats.messagesPopped++;
+        return size;
+    }
+
+    float RttMs()           const { return rtt * 1000.0f; }
+    int   PendingReliable() const { return (uint16_t)(sendNext - sendHead); }
+    const NetChannelStats& Stats() const { return stats; }
+
+private:
+    struct OutPiece {
+        uint16_t id       = 0;
+        uint16_t size     = 0;
+        bool     more     = false;
+        bool     acked    = true;
+        double   lastSent = -1.0;   // -1: never sent
+        uint8_t  bytes[NET_FRAGMENT_BYTES];
+    };
+
+    struct InPiece {
+        uint16_t id      = 0;
+        uint16_t size    = 0;
+        bool     present = false;
+        bool     more    = false;
+        uint8_t  bytes[NET_FRAGMENT_BYTES];
+    };
+
+    struct SentPacket {
+        uint16_t seq   = 0;
+        double   time  = 0.0;
+        bool     valid = false;
+        bool     acked = false;
+        int      count = 0;
+        std::array<uint16_t, NET_PIECES_PER_PACKET> pieces{};
+    };
+
+    void ProcessAcks(double now, uint16_t ack, uint32_t bits) {
+        for(int i = 0; i <= 32; i++) {
+            if(i > 0 && !(bits & (1u << (i - 1)))) continue;
+            uint16_t    seq = (uint16_t)(ack - i);
+            SentPacket& rec = history[seq % NET_PACKET_HISTORY];
+            if(!rec.valid || rec.acked || rec.seq != seq) continue;
+            rec.acked = true;
+            stats.packetsAcked++;
+            float sample = (float)(now - rec.time);
+            rtt = (rtt == 0.0f) ? sample : rtt + (sample - rtt) * 0.1f;
+            for(int k = 0; k < rec.count; k++) {
+                OutPiece& p = sendWindow[rec.pieces[k] & (NET_WINDOW - 1)];
+                if(p.id == rec.pieces[k]) p.acked = true;
+            }
+        }
+        while(sendHead != sendNext && sendWindow[sendHead & (NET_WINDOW - 1)].acked) sendHead++;
+    }
+
+    // seq was already received (and acked)
+    bool Seen(uint16_t seq) const {
+        if(!anyReceived || SeqNewer(seq, remoteSeq)) return false;
+        uint16_t back = (uint16_t)(remoteSeq - seq);
+        if(back == 0) return true;
+        if(back > 32) return false;   // too old to ack; pieces in it are deduplicated by id
+        return ackBits & (1u << (back - 1));
+    }
+
+    // Updates remoteSeq / ackBits for a packet not Seen.
+    void MarkReceived(uint16_t seq) {
+        if(!anyReceived) {
+            anyReceived = true;
+            remoteSeq   = seq;
+            ackBits     = 0;
+            return;
+        }
+        if(SeqNewer(seq, remoteSeq)) {
+            uint16_t shift = (uint16_t)(seq - remoteSeq);
+            ackBits = (shift > 32) ? 0 : ((shift == 32 ? 0 : ackBits << shift) | (1u << (shift - 1)));
+            remoteSeq = seq;
+            return;
+        }
+        uint16_t back = (uint16_t)(remoteSeq - seq);
+        if(back <= 32) ackBits |= 1u << (back - 1);
+    }
+
+    static void     Put16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+    static void     Put32(uint8_t* p, uint32_t v) { Put16(p, (uint16_t)v); Put16(p + 2, (uint16_t)(v >> 16)); }
+    static uint16_t Get16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+    static uint32_t Get32(const uint8_t* p) { return Get16(p) | ((uint32_t)Get16(p + 2) << 16); }
+
+    std::array<OutPiece, NET_WINDOW>           sendWindow{};
+    std::array<InPiece, NET_WINDOW>            recvWindow{};
+    std::array<SentPacket, NET_PACKET_HISTORY> history{};
+    uint16_t sendHead    = 0;   // oldest unacked piece
+    uint16_t sendNext    = 0;   // id of the next piece queued
+    uint16_t recvNext    = 0;   // id of the next piece to deliver
+    uint16_t localSeq    = 0;
+    uint16_t remoteSeq   = 0;
+    uint32_t ackBits     = 0;
+    bool     anyReceived = false;
+    bool     ackOwed     = false;
+    float    rtt         = 0.0f;   // smoothed, seconds
+    NetChannelStats stats;
+};
@@ -0,0 +1,189 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  PawnInterpolator.h  –  Client jitter buffer for remote pawns
+//
+//  Snapshots arrive unevenly, so a client that drew each one as it landed
+//  would show other players stuttering.  Each pawn keeps a fixed ring of
+//  the last INTERP_RING states from the snapshots, stamped with server
+//  time (tick / tick rate).  Frames render at a point a little in the past:
+//  the newest server time seen, less a delay that covers the jitter.  The
+//  pose is lerped between the two states around that point, with yaw taken
+//  the short way round.
+//
+//  The delay adapts.  Each arrival records receive time minus server time.
+//  The spread between the fastest packet and the 95th percentile of the
+//  last INTERP_OFFSET_SAMPLES packets is the jitter, and one snapshot
+//  interval on top of it is the target.  The delay slews toward the target
+//  at INTERP_SLEW, as does any drift in the fastest offset, so remote
+//  pawns speed up or slow down slightly rather than jumping.
+//
+//  When the render point passes the newest state (packets lost or late),
+//  the pawn is extrapolated along its last velocity for at most
+//  INTERP_EXTRAPOLATE_SEC and then held.  A pawn with no state for
+//  INTERP_STALE_SEC, e.g. one that dropped out of relevancy, is hidden.
+//  Teleports (respawn) and long gaps between states snap instead of
+//  sliding.
+//
+//  Allocation-free; nothing here writes to World.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Entity.h"
+#include "../RollingStats.h"
+#include "../game/PlayerCommand.h"
+#include "../server/Snapshot.h"
+#include <raymath.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+constexpr int   INTERP_RING             = 32;      // states per pawn (power of two)
+constexpr int   INTERP_OFFSET_SAMPLES   = 128;     // arrivals the jitter is measured over
+constexpr float INTERP_RETARGET_SEC     = 0.1f;    // server time between delay targets
+constexpr float INTERP_MIN_DELAY        = 0.010f;
+constexpr float INTERP_MAX_DELAY        = 0.250f;
+constexpr float INTERP_SLEW             = 0.05f;   // delay change per second of render time
+constexpr float INTERP_EXTRAPOLATE_SEC  = 0.10f;
+constexpr float INTERP_STALE_SEC        = 0.5f;
+constexpr float INTERP_SNAP_DIST        = 2.0f;    // metres between states that count as a teleport
+
+static_assert((INTERP_RING & (INTERP_RING - 1)) == 0, "INTERP_RING must be a power of two");
+
+class PawnInterpolator {
+public:
+    void Reset() { *this = PawnInterpolator{}; }
+
+    // A decoded snapshot received at recvTime (InputClock seconds) from a
+    // server ticking at tickHz.  Duplicates and reordered snapshots are dropped.
+    void Push(const Snapshot& snap, double recvTime, int tickHz) {
+        double serverTime = (double)snap.tick / tickHz;
+        if(!haveBase) {
+            haveBase      = true;
+            offsetBase    = recvTime - serverTime;
+            interval      = 1.0f / tickHz;
+            lag = targetLag = std::max(INTERP_MIN_DELAY, interval);
+            nextRetarget  = serverTime;
+            newestServer  = serverTime - interval;
+        }
+        // Late packets count toward the jitter even though their states are stale
+        offsets.Add((float)(recvTime - serverTime - offsetBase));
+        if(serverTime <= newestServer) return;
+        float gap = (float)(serverTime - newestServer);
+        interval += (std::min(gap, INTERP_MAX_DELAY) - interval) * 0.1f;
+        newestServer = serverTime;
+
+        if(serverTime >= nextRetarget) {
+            nextRetarget = serverTime + INTERP_RETARGET_SEC;
+            minOffset    = offsets.Percentile(0.0f);
+            jitter       = offsets.Percentile(0.95f) - minOffset;
+            targetLag    = minOffset + std::clamp(interval + jitter, INTERP_MIN_DELAY, INTERP_MAX_DELAY);
+        }
+
+        for(int i = 0; i < snap.pawnCount; i++) {
+            const SnapshotPawn& p = snap.pawns[i];
+            if(p.id >= MAX_PAWNS) continue;
+            Track& t = tracks[p.id];
+            State& s = t.ring[t.count++ & (INTERP_RING - 1)];
+            s.time   = serverTime;
+            s.pos    = p.pos;
+            s.yaw    = DequantizeYaw(p.yaw);
+            s.pitch  = DequantizePitch(p.pitch);
+            s.alive  = p.alive;
+            s.crouch = p.crouch;
+            s.team   = p.team;
+        }
+    }
+
+    // Poses at the current render point; now is InputClock() and dt the
+    // frame time.  The client's own seat comes from prediction, not here.
+    void Sample(double now, float dt, std::array<PawnPose, MAX_PAWNS>& out) {
+        extrapolating = 0;
+        out.fill(PawnPose{});
+        if(!haveBase) return;
+
+        float step = INTERP_SLEW * dt;
+        lag += std::clamp(targetLag - lag, -step, step);
+        double renderTime = now - offsetBase - lag;
+
+        for(int i = 0; i < MAX_PAWNS; i++) {
+            const Track& t = tracks[i];
+            if(t.count == 0) continue;
+            const State& newest = t.At(0);
+            if(renderTime - newest.time > INTERP_STALE_SEC) continue;
+
+            State s = newest;
+            if(renderTime > newest.time) {
+                if(t.count > 1 && Continuous(t.At(1), newest)) {
+                    const State& prev = t.At(1);
+                    float ahead = (float)std::min(renderTime - newest.time, (double)INTERP_EXTRAPOLATE_SEC);
+                    float f     = ahead / (float)(newest.time - prev.time);
+                    s.pos = Vector3Add(newest.pos, Vector3Scale(Vector3Subtract(newest.pos, prev.pos), f));
+                    extrapolating++;
+                }
+            } else {
+                uint32_t held = std::min<uint32_t>(t.count, INTERP_RING);
+                uint32_t k    = 1;
+                while(k < held && t.At(k).time > renderTime) k++;
+                if(k < held) {
+                    const State& a = t.At(k);
+                    const State& b = t.At(k - 1);
+                    if(!Continuous(a, b) && renderTime - a.time > INTERP_STALE_SEC) continue;  // a gap in relevancy
+                    s = Between(a, b, renderTime);
+                } else {
+                    s = t.At(held - 1);   // older than the ring: hold the oldest
+                }
+            }
+            if(!s.alive) continue;
+            out[i] = { true, s.team, s.pos, s.yaw, s.pitch, s.crouch };
+        }
+    }
+
+    float DelayMs()       const { return (lag - minOffset) * 1000.0f; }
+    float JitterMs()      const { return jitter * 1000.0f; }
+    int   Extrapolating() const { return extrapolating; }
+
+private:
+    struct State {
+        double  time   = 0.0;   // server seconds
+        Vector3 pos    = {};
+        float   yaw    = 0.0f;
+        float   pitch  = 0.0f;
+        bool    alive  = false;
+        bool    crouch = false;
+        Team    team   = Team::NONE;
+    };
+
+    struct Track {
+        std::array<State, INTERP_RING> ring{};
+        uint32_t count = 0;   // states ever pushed
+
+        const State& At(uint32_t back) const { return ring[(count - 1 - back) & (INTERP_RING - 1)]; }
+    };
+
+    static bool Continuous(const State& a, const State& b) {
+        return a.alive == b.alive && b.time - a.time <= INTERP_STALE_SEC &&
+               Vector3DistanceSqr(a.pos, b.pos) <= INTERP_SNAP_DIST * INTERP_SNAP_DIST;
+    }
+
+    // a.time <= t <= b.time
+    static State Between(const State& a, const State& b, double t) {
+        if(!Continuous(a, b)) return (t < b.time) ? a : b;
+        float f = (b.time > a.time) ? (float)((t - a.time) / (b.time - a.time)) : 1.0f;
+        State s = (f < 0.5f) ? a : b;   // discrete fields from the nearer state
+        s.pos   = Vector3Lerp(a.pos, b.pos, f);
+        s.yaw   = a.yaw + remainderf(b.yaw - a.yaw, 2.0f * PI) * f;
+        s.pitch = a.pitch + (b.pitch - a.pitch) * f;
+        return s;
+    }
+
+    std::array<Track, MAX_PAWNS> tracks{};
+    RollingStats<INTERP_OFFSET_SAMPLES> offsets;
+    bool   haveBase      = false;
+    double offsetBase    = 0.0;   // first receive-minus-server offset; keeps samples small
+    double newestServer  = 0.0;
+    double nextRetarget  = 0.0;
+    float  minOffset     = 0.0f;
+    float  interval      = 0.0f;  // smoothed server time between snapshots
+    float  jitter        = 0.0f;
+    float  lag           = 0.0f;  // render point behind arrivals: minOffset + delay, slewed
+    float  targetLag     = 0.0f;
+    int    extrapolating = 0;
+};
@@ -0,0 +1,123 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  UdpSocket.h  –  Non-blocking IPv4 datagram socket (Linux only)
+//
+//  Just enough for NetChannel: bind, sendto, and a recvfrom that returns 0
+//  on EAGAIN so a frame can drain everything queued without blocking.
+//  Addresses are host-order IPv4 and port.  On other platforms the socket
+//  is inert and Open() fails.
+// ─────────────────────────────────────────────────────────────────────────────
+#include <raylib.h>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+struct UdpAddress {
+    uint32_t ip   = 0;   // host order
+    uint16_t port = 0;
+
+    static UdpAddress Loopback(uint16_t port) { return { 0x7F000001u, port }; }
+
+    // "a.b.c.d:port"
+    static bool Parse(const char* text, UdpAddress& out) {
+        unsigned a, b, c, d, port;
+        char     tail;
+        if(sscanf(text, "%u.%u.%u.%u:%u%c", &a, &b, &c, &d, &port, &tail) != 5) return false;
+        if(a > 255 || b > 255 || c > 255 || d > 255 || port == 0 || port > 65535) return false;
+        out = { (a << 24) | (b << 16) | (c << 8) | d, (uint16_t)port };
+        return true;
+    }
+    bool operator==(const UdpAddress& o) const { return ip == o.ip && port == o.port; }
+};
+
+class UdpSocket {
+public:
+    UdpSocket() = default;
+    UdpSocket(const UdpSocket&) = delete;
+    UdpSocket& operator=(const UdpSocket&) = delete;
+    ~UdpSocket() { Close(); }
+
+    // port 0 picks a free one; see Port()
+    bool Open(uint16_t port, bool loopbackOnly = false) {
+        Close();
+#if defined(__linux__)
+        fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if(fd < 0) {
+            TraceLog(LOG_WARNING, "UdpSocket: socket failed (%d)", errno);
+            return false;
+        }
+        sockaddr_in sa = ToSockaddr({ loopbackOnly ? 0x7F000001u : INADDR_ANY, port });
+        if(bind(fd, (const sockaddr*)&sa, sizeof(sa)) < 0) {
+            TraceLog(LOG_WARNING, "UdpSocket: cannot bind port %u (%d)", port, errno);
+            Close();
+            return false;
+        }
+        socklen_t len = sizeof(sa);
+        getsockname(fd, (sockaddr*)&sa, &len);
+        boundPort = ntohs(sa.sin_port);
+        return true;
+#else
+        (void)port; (void)loopbackOnly;
+        return false;
+#endif
+    }
+
+    bool Send(const UdpAddress& to, const uint8_t* data, int size) {
+#if defined(__linux__)
+        if(fd < 0) return false;
+        sockaddr_in sa = ToSockaddr(to);
+        return sendto(fd, data, size, 0, (const sockaddr*)&sa, sizeof(sa)) == size;
+#else
+        (void)to; (void)data; (void)size;
+        return false;
+#endif
+    }
+
+    // One queued datagram into out; its size, or 0 when none is waiting.
+    int Receive(uint8_t* out, int capacity, UdpAddress& from) {
+#if defined(__linux__)
+        if(fd < 0) return 0;
+        sockaddr_in sa;
+        socklen_t   len = sizeof(sa);
+        ssize_t n = recvfrom(fd, out, capacity, 0, (sockaddr*)&sa, &len);
+        if(n <= 0) return 0;   // EAGAIN: drained
+        from = { ntohl(sa.sin_addr.s_addr), ntohs(sa.sin_port) };
+        return (int)n;
+#else
+        (void)out; (void)capacity; (void)from;
+        return 0;
+#endif
+    }
+
+    bool     IsOpen() const { return fd >= 0; }
+    uint16_t Port()   const { return boundPort; }
+
+private:
+    int      fd        = -1;
+    uint16_t boundPort = 0;
+
+#if defined(__linux__)
+    static sockaddr_in ToSockaddr(UdpAddress a) {
+        sockaddr_in sa{};
+        sa.sin_family      = AF_INET;
+        sa.sin_addr.s_addr = htonl(a.ip);
+        sa.sin_port        = htons(a.port);
+        return sa;
+    }
+#endif
+
+    void Close() {
+#if defined(__linux__)
+        if(fd >= 0) close(fd);
+#endif
+        fd = -1;
+        boundPort = 0;
+    }
+};
@@ -0,0 +1,218 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  FramePacer.h  –  Steady frame rate the Pi can hold without throttling
+//
+//  Running flat out heats the SoC until the firmware caps the clock at
+//  80 °C, and frame times go ragged.  Instead the pacer holds one rung of a
+//  ladder: a frame rate (90, 72 or 60), a render scale and an effects level.
+//  Once a second it reads the CPU temperature, clock and throttle flags from
+//  sysfs and looks at how long frames took to make.  It steps down when the
+//  temperature is heading for the limit, the firmware reports throttling or
+//  frames overrun their budget; resolution and effects go first, the frame
+//  rate after.  It steps back up only after a long cool, comfortable spell.
+//  On a display slower than a rung's rate, that rung runs at the refresh
+//  rate and keeps its scale and effects, so a 60 Hz screen still starts
+//  at full resolution.
+//
+//  Pace() ends each frame: it sleeps until just short of the next deadline,
+//  then spins the rest, learning how late the OS wakes it.  Off the Pi the
+//  sensors are missing and only frame cost drives the ladder.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Constants.h"
+#include "../RollingStats.h"
+#include "../game/InputSnapshot.h"
+#include <raylib.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+constexpr float PACE_TEMP_LIMIT     = 80.0f;  // °C, firmware soft throttle
+constexpr float PACE_TEMP_HIGH      = 77.0f;  // step down when heading here
+constexpr float PACE_TEMP_LOW       = 68.0f;  // step up only below this
+constexpr float PACE_TEMP_LOOKAHEAD = 20.0f;  // s of current trend to project
+constexpr int   PACE_TEMP_HISTORY   = 16;     // 1 Hz samples for the trend
+constexpr float PACE_BUDGET         = 0.85f;  // work p95 over this × period: overrun
+constexpr float PACE_HEADROOM       = 0.60f;  // step up if it fits this × next period
+constexpr float PACE_HOLD_DOWN      = 3.0f;   // s between downward steps
+constexpr float PACE_HOLD_UP        = 10.0f;  // s of good readings before a step up
+constexpr double PACE_SPIN_MIN      = 0.0003; // s always spun, never slept
+constexpr double PACE_SPIN_MAX      = 0.004;
+
+struct PaceLevel { int fps; float renderScale; bool reducedEffects; };
+
+// Best first.  Each step down costs the least noticeable thing left.
+constexpr PaceLevel PACE_LADDER[] = {
+    { 90, 1.000f, false },
+    { 90, 0.875f, false },
+    { 72, 0.875f, false },
+    { 72, 0.750f, true  },
+    { 60, 0.750f, true  },
+    { 60, 0.625f, true  },
+};
+constexpr int PACE_LEVELS = sizeof(PACE_LADDER) / sizeof(PACE_LADDER[0]);
+static_assert(PACE_LADDER[0].fps == TARGET_FPS, "TARGET_FPS is the top of the pacing ladder");
+
+// ─── sysfs readings ─────────────────────────────────────────────────────────
+struct ThermalReading {
+    float tempC     = -1.0f;   // < 0: no sensor
+    int   freqMHz   = 0;       // 0: no cpufreq
+    int   maxMHz    = 0;
+    bool  throttled = false;   // firmware says the clock is capped right now
+};
+
+inline bool ReadSysfsLong(const char* path, long& out) {
+    FILE* f = fopen(path, "r");
+    if(!f) return false;
+    char buf[32] = {};
+    bool ok = fgets(buf, sizeof(buf), f) != nullptr;
+    fclose(f);
+    char* end = nullptr;
+    if(ok) out = strtol(buf, &end, 0);   // base 0: get_throttled is "0x…"
+    return ok && end != buf;
+}
+
+inline ThermalReading ReadThermal() {
+    ThermalReading r;
+    long v;
+    if(ReadSysfsLong("/sys/class/thermal/thermal_zone0/temp", v))                 r.tempC   = v / 1000.0f;
+    if(ReadSysfsLong("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", v)) r.freqMHz = (int)(v / 1000);
+    if(ReadSysfsLong("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq", v)) r.maxMHz  = (int)(v / 1000);
+    // Raspberry Pi kernels: bit 1 arm frequency capped, 2 throttled, 3 soft temp limit
+    if(ReadSysfsLong("/sys/devices/platform/soc/soc:firmware/get_throttled", v))  r.throttled = (v & 0xE) != 0;
+    return r;
+}
+
+// ─── Pacer ──────────────────────────────────────────────────────────────────
+class FramePacer {
+public:
+    // The ladder with each rate capped to the fastest one the display can
+    // show without judder; rungs the cap makes identical collapse to one.
+    void Init(int refreshHz) {
+        int capFps = PACE_LADDER[PACE_LEVELS - 1].fps;
+        for(const PaceLevel& l : PACE_LADDER)
+            if(refreshHz <= 0 || l.fps <= refreshHz + 1) capFps = std::max(capFps, l.fps);
+        rungCount = 0;
+        for(PaceLevel l : PACE_LADDER) {
+            l.fps = std::min(l.fps, capFps);
+            const PaceLevel* prev = rungCount ? &rungs[rungCount - 1] : nullptr;
+            if(prev && prev->fps == l.fps && prev->renderScale == l.renderScale &&
+               prev->reducedEffects == l.reducedEffects) continue;
+            rungs[rungCount++] = l;
+        }
+        level     = 0;
+        frameEnd  = InputClock();
+        frameBeg  = frameEnd;
+        nextCheck = frameEnd + 1.0;
+        changedAt = frameEnd;
+        thermal   = ReadThermal();
+        TraceLog(LOG_INFO, "FramePacer: %d fps at scale %.2f%s", Level().fps, Level().renderScale,
+                 thermal.tempC < 0 ? " (no thermal sensor)" : "");
+    }
+
+    const PaceLevel&      Level()   const { return rungs[level]; }
+    const ThermalReading& Thermal() const { return thermal; }
+    float WorkP95Ms() const { return workMs.Percentile(0.95f); }
+    const char* Decision() const { return decision; }
+
+    // Once a frame, after the swap.  True when the level changed; the reason
+    // is in Decision().
+    bool Govern() {
+        double now = InputClock();
+        workMs.Add((float)((now - frameBeg) * 1000.0));
+        if(now < nextCheck) return false;
+        nextCheck = now + 1.0;
+
+        thermal = ReadThermal();
+        if(thermal.tempC >= 0.0f) {
+            temps[tempHead] = thermal.tempC;
+            tempHead = (tempHead + 1) % PACE_TEMP_HISTORY;
+            if(tempCount < PACE_TEMP_HISTORY) tempCount++;
+        }
+        float projected = ProjectedTemp();
+        float p95       = WorkP95Ms();
+        float periodMs  = 1000.0f / Level().fps;
+        double held     = now - changedAt;
+
+        const char* down = nullptr;
+        if(thermal.throttled)                                  down = "firmware throttling";
+        else if(projected >= PACE_TEMP_HIGH)                   down = "heading for the thermal limit";
+        else if(workMs.Count() >= 30 && p95 > periodMs * PACE_BUDGET) down = "frames over budget";
+        if(down) {
+            goodSince = now;
+            bool urgent = thermal.throttled || thermal.tempC >= PACE_TEMP_LIMIT;
+            if(level + 1 < rungCount && (urgent || held >= PACE_HOLD_DOWN))
+                return Step(level + 1, now, down, projected, p95);
+            return false;
+        }
+
+        bool cool = thermal.tempC < 0.0f || (thermal.tempC < PACE_TEMP_LOW && projected < PACE_TEMP_LOW);
+        bool fits = level > 0 && p95 < 1000.0f / rungs[level - 1].fps * PACE_HEADROOM;
+        if(!cool || !fits) { goodSince = now; return false; }
+        if(now - goodSince >= PACE_HOLD_UP && held >= PACE_HOLD_UP)
+            return Step(level - 1, now, "cool with headroom", projected, p95);
+        return false;
+    }
+
+    // Last thing in the frame: sleep, then spin, to the next deadline.
+    void Pace() {
+        double period   = 1.0 / Level().fps;
+        double deadline = frameEnd + period;
+        double now      = InputClock();
+        if(now > deadline) {            // missed it: start again from here
+            frameEnd = frameBeg = now;
+            return;
+        }
+        double sleepFor = deadline - now - spinMargin;
+        if(sleepFor > 0.0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(sleepFor));
+            double late = InputClock() - (now + sleepFor);
+            // Jump up to a late wake at once, creep back down over ~100 frames
+            spinMargin = std::clamp(std::max(late * 1.5, spinMargin * 0.99), PACE_SPIN_MIN, PACE_SPIN_MAX);
+        }
+        while(InputClock() < deadline) {}
+        frameEnd = frameBeg = deadline;
+    }
+
+private:
+    PaceLevel rungs[PACE_LEVELS] = {};   // PACE_LADDER capped to the display
+    int    rungCount  = 0;
+    int    level      = 0;
+    double frameEnd   = 0.0;     // last deadline
+    double frameBeg   = 0.0;     // when this frame's work started
+    double nextCheck  = 0.0;
+    double changedAt  = 0.0;
+    double goodSince  = 0.0;
+    double spinMargin = 0.001;
+    ThermalReading thermal;
+    RollingStats<128> workMs;    // swap-to-swap minus the pacing wait
+    float  temps[PACE_TEMP_HISTORY] = {};
+    int    tempHead = 0, tempCount = 0;
+    char   decision[128] = "";
+
+    // Latest temperature plus the rising part of the recent trend.
+    float ProjectedTemp() const {
+        if(tempCount == 0) return -1.0f;
+        float newest = temps[(tempHead + PACE_TEMP_HISTORY - 1) % PACE_TEMP_HISTORY];
+        if(tempCount < 4) return newest;
+        float oldest = temps[(tempHead + PACE_TEMP_HISTORY - tempCount) % PACE_TEMP_HISTORY];
+        float slope  = (newest - oldest) / (tempCount - 1);   // °C per second
+        return newest + std::max(slope, 0.0f) * PACE_TEMP_LOOKAHEAD;
+    }
+
+    bool Step(int to, double now, const char* why, float projected, float p95) {
+        const PaceLevel& a = rungs[level];
+        const PaceLevel& b = rungs[to];
+        snprintf(decision, sizeof(decision), "%d fps x%.2f%s -> %d fps x%.2f%s: %s (%.1f C, %.1f ms p95)",
+                 a.fps, a.renderScale, a.reducedEffects ? " lowfx" : "",
+                 b.fps, b.renderScale, b.reducedEffects ? " lowfx" : "",
+                 why, projected, p95);
+        TraceLog(LOG_INFO, "FramePacer: %s", decision);
+        level     = to;
+        changedAt = now;
+        goodSince = now;
+        workMs.Clear();   // the old rung's costs say little about the new one
+        return true;
+    }
+};
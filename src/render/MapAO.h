@@ -0,0 +1,212 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MapAO.h  –  Baked per-vertex ambient occlusion for the static map mesh
+//
+//  The renderer has no fragment lighting, so corners and depth are baked into
+//  vertex colours instead.  Each visible face is split into cells of about
+//  AO_CELL metres; every cell corner casts AO_RAYS cosine-distributed rays
+//  over its hemisphere, and boxes hit within AO_RADIUS darken it (closer hits
+//  darker).  Runs of cells that one larger quad reproduces within
+//  AO_TOLERANCE are merged back, so open floors and straight gradients up
+//  walls stay cheap and only corners add vertices.  Faces are independent,
+//  so they are baked on all hardware threads; output keeps face order and
+//  matches a serial bake exactly.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../game/MapOptimizer.h"
+#include "../game/Physics.h"
+#include "../game/SolidGrid.h"
+#include "MapMesh.h"
+#include <raylib.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+constexpr float AO_CELL        = 1.0f;    // target cell edge, metres
+constexpr int   AO_MAX_DIV     = 128;     // cells per face edge, at most
+constexpr int   AO_RAYS        = 16;      // hemisphere samples per vertex
+constexpr float AO_RADIUS      = 2.0f;    // metres; farther boxes don't darken
+constexpr float AO_STRENGTH    = 0.6f;    // fully enclosed vertex keeps 40 %
+constexpr float AO_BIAS        = 0.02f;   // ray start off the face plane
+constexpr int   AO_TOLERANCE   = 4;       // shade error allowed when merging, of 255
+constexpr int   AO_MAX_THREADS = 8;
+
+struct MapAOStats {
+    int    vertices = 0;   // AO samples taken
+    int    quads    = 0;   // after merging
+    int    threads  = 0;
+    double ms       = 0.0;
+};
+
+namespace ao_detail {
+    // Direction in face space: (u, v) along the face, n along its normal.
+    struct Dir { float u, v, n; };
+
+    // Cosine-weighted Fibonacci spiral: equal-weight samples, so the hit
+    // fraction is the usual cosine-weighted occlusion.
+    inline const std::array<Dir, AO_RAYS>& Hemisphere() {
+        static const std::array<Dir, AO_RAYS> dirs = []{
+            std::array<Dir, AO_RAYS> d{};
+            const float golden = PI * (3.0f - sqrtf(5.0f));
+            for(int i = 0; i < AO_RAYS; i++) {
+                float r   = sqrtf((i + 0.5f) / AO_RAYS);
+                float phi = i * golden;
+                d[i] = { r * cosf(phi), r * sinf(phi), sqrtf(1.0f - r * r) };
+            }
+            return d;
+        }();
+        return dirs;
+    }
+
+    // Light reaching (u, v) on the face, 255 = nothing within AO_RADIUS.
+    inline uint8_t Exposure(const MapFace& f, float u, float v,
+                            const std::vector<MapSolid>& solids, const SolidGrid& grid,
+                            std::vector<int>& cand) {
+        const int ua = (f.axis + 1) % 3, va = (f.axis + 2) % 3;
+        float p[3];
+        p[f.axis] = f.plane + f.sign * AO_BIAS;
+        p[ua]     = u;
+        p[va]     = v;
+
+        // Every ray from p stays inside this box, so the grid is asked once.
+        BoundingBox q = { { p[0] - AO_RADIUS, p[1] - AO_RADIUS, p[2] - AO_RADIUS },
+                          { p[0] + AO_RADIUS, p[1] + AO_RADIUS, p[2] + AO_RADIUS } };
+        cand.clear();
+        grid.ForEachCandidate(q, [&](int j) {
+            if(CheckCollisionBoxes(q, solids[j].bounds)) cand.push_back(j);
+        });
+        if(cand.empty()) return 255;
+
+        float occ = 0.0f;
+        for(const Dir& d : Hemisphere()) {
+            float dir[3];
+            dir[ua]     = d.u * AO_RADIUS;
+            dir[va]     = d.v * AO_RADIUS;
+            dir[f.axis] = d.n * AO_RADIUS * f.sign;
+            float nearest = 1.0f;
+            for(int j : cand) {
+                const BoundingBox& b = solids[j].bounds;
+                const float lo[3] = { b.min.x, b.min.y, b.min.z };
+                const float hi[3] = { b.max.x, b.max.y, b.max.z };
+                float t0, t1;
+                // t1 > 0: a box the point merely touches does not shadow
+                // rays leaving away from it.
+                if(sweep_detail::SegmentBox(p, dir, lo, hi, t0, t1) && t1 > 1e-4f && t0 < nearest)
+                    nearest = t0;
+            }
+            occ += 1.0f - nearest;   // 0 for a miss
+        }
+        float light = 1.0f - AO_STRENGTH * occ / AO_RAYS;
+        return (uint8_t)lroundf(light * 255.0f);
+    }
+
+    inline Color Shade(Color c, int light) {
+        return { (unsigned char)(c.r * light / 255), (unsigned char)(c.g * light / 255),
+                 (unsigned char)(c.b * light / 255), c.a };
+    }
+
+    struct Scratch {
+        std::vector<int>     cand;
+        std::vector<uint8_t> light, used;
+    };
+
+    // Sample one face's vertex grid and emit its quads; returns samples taken.
+    inline int BakeFace(const MapFace& f, const std::vector<MapSolid>& solids,
+                        const SolidGrid& grid, Scratch& s, std::vector<MeshQuad>& out) {
+        const int nu = std::clamp((int)ceilf((f.u1 - f.u0) / AO_CELL), 1, AO_MAX_DIV);
+        const int nv = std::clamp((int)ceilf((f.v1 - f.v0) / AO_CELL), 1, AO_MAX_DIV);
+        const float su = (f.u1 - f.u0) / nu, sv = (f.v1 - f.v0) / nv;
+        auto U = [&](int i) { return i == nu ? f.u1 : f.u0 + i * su; };
+        auto V = [&](int j) { return j == nv ? f.v1 : f.v0 + j * sv; };
+
+        const int stride = nu + 1;
+        s.light.resize((size_t)stride * (nv + 1));
+        for(int j = 0; j <= nv; j++)
+            for(int i = 0; i <= nu; i++)
+                s.light[j * stride + i] = Exposure(f, U(i), V(j), solids, grid, s.cand);
+
+        auto L = [&](int i, int j) { return (int)s.light[j * stride + i]; };
+
+        // The GPU splits each quad along its (u0,v0)-(u1,v1) diagonal, so a
+        // rectangle may stand in for the cells it covers if those two
+        // triangles reproduce every sample inside it within AO_TOLERANCE.
+        auto fits = [&](int i0, int j0, int i1, int j1) {
+            const int l00 = L(i0, j0), l10 = L(i1, j0), l11 = L(i1, j1), l01 = L(i0, j1);
+            for(int b = j0; b <= j1; b++)
+                for(int a = i0; a <= i1; a++) {
+                    float x = (float)(a - i0) / (i1 - i0), y = (float)(b - j0) / (j1 - j0);
+                    float fit = x >= y ? l00 + x * (l10 - l00) + y * (l11 - l10)
+                                       : l00 + y * (l01 - l00) + x * (l11 - l01);
+                    if(fabsf(fit - L(a, b)) > AO_TOLERANCE) return false;
+                }
+            return true;
+        };
+
+        // Greedy: grow along u, then along v, while the fit holds.
+        s.used.assign((size_t)nu * nv, 0);
+        for(int j = 0; j < nv; j++)
+            for(int i = 0; i < nu; i++) {
+                if(s.used[j * nu + i]) continue;
+                int i1 = i + 1;
+                while(i1 < nu && !s.used[j * nu + i1] && fits(i, j, i1 + 1, j + 1)) i1++;
+                int j1 = j + 1;
+                for(; j1 < nv; j1++) {
+                    bool free = true;
+                    for(int a = i; a < i1 && free; a++) free = !s.used[j1 * nu + a];
+                    if(!free || !fits(i, j, i1, j1 + 1)) break;
+                }
+                for(int b = j; b < j1; b++)
+                    for(int a = i; a < i1; a++) s.used[b * nu + a] = 1;
+                out.push_back(FaceRectQuad(f, U(i), V(j), U(i1), V(j1),
+                                           Shade(f.col, L(i, j)),   Shade(f.col, L(i1, j)),
+                                           Shade(f.col, L(i1, j1)), Shade(f.col, L(i, j1))));
+            }
+        return stride * (nv + 1);
+    }
+}
+
+// ─── Bake every face; the grid must be built over the same solids ───────────
+inline std::vector<MeshQuad> BakeMapAO(const std::vector<MapFace>& faces,
+                                       const std::vector<MapSolid>& solids,
+                                       const SolidGrid& grid, MapAOStats* stats = nullptr) {
+    using namespace ao_detail;
+    auto t0 = std::chrono::steady_clock::now();
+    ao_detail::Hemisphere();   // build the table before the workers race for it
+
+    std::vector<std::vector<MeshQuad>> perFace(faces.size());
+    std::atomic<size_t> next{ 0 };
+    std::atomic<int>    samples{ 0 };
+    auto work = [&] {
+        Scratch s;
+        int taken = 0;
+        for(size_t k; (k = next.fetch_add(1, std::memory_order_relaxed)) < faces.size(); )
+            taken += BakeFace(faces[k], solids, grid, s, perFace[k]);
+        samples.fetch_add(taken, std::memory_order_relaxed);
+    };
+
+    int threads = (int)std::min<size_t>(faces.size(),
+                  std::clamp((int)std::thread::hardware_concurrency(), 1, AO_MAX_THREADS));
+    std::vector<std::thread> pool;
+    for(int t = 1; t < threads; t++) pool.emplace_back(work);
+    work();
+    for(auto& th : pool) th.join();
+
+    std::vector<MeshQuad> quads;
+    size_t total = 0;
+    for(const auto& q : perFace) total += q.size();
+    quads.reserve(total);
+    for(const auto& q : perFace) quads.insert(quads.end(), q.begin(), q.end());
+
+    if(stats) {
+        stats->vertices = samples.load();
+        stats->quads    = (int)quads.size();
+        stats->threads  = std::max(threads, 1);
+        stats->ms       = std::chrono::duration<double, std::milli>(
+                              std::chrono::steady_clock::now() - t0).count();
+    }
+    return quads;
+}
@@ -0,0 +1,110 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MapMesh.h  –  Static GPU mesh for the map's visible faces
+//
+//  Replaces one DrawCube per solid per frame with a handful of pre-uploaded
+//  vertex buffers.  Geometry comes in as coloured quads; chunks are split
+//  below 65536 vertices because GLES2 indices are 16-bit.  Rebuilt only
+//  when World::geometryVersion changes (load, streaming, hot reload).
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../game/MapOptimizer.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <cstdint>
+#include <vector>
+
+constexpr int MAP_MESH_MAX_QUADS = 65536 / 4;   // per chunk, 16-bit indices
+
+// One quad, corners counter-clockwise seen from the front
+struct MeshQuad {
+    Vector3 p[4];
+    Color   c[4];
+};
+
+// Corners of the (u0,v0)-(u1,v1) part of a face in front-facing order.
+// Colours are given at (u0,v0), (u1,v0), (u1,v1), (u0,v1).
+inline MeshQuad FaceRectQuad(const MapFace& f, float u0, float v0, float u1, float v1,
+                             Color c00, Color c10, Color c11, Color c01) {
+    auto at = [&](float u, float v) -> Vector3 {
+        float w[3];
+        w[f.axis]           = f.plane;
+        w[(f.axis + 1) % 3] = u;
+        w[(f.axis + 2) % 3] = v;
+        return { w[0], w[1], w[2] };
+    };
+    MeshQuad q;
+    Vector3 a = at(u0, v0), b = at(u1, v0), c = at(u1, v1), d = at(u0, v1);
+    if(f.sign > 0) {
+        q.p[0] = a;   q.p[1] = b;   q.p[2] = c;   q.p[3] = d;
+        q.c[0] = c00; q.c[1] = c10; q.c[2] = c11; q.c[3] = c01;
+    } else {
+        q.p[0] = a;   q.p[1] = d;   q.p[2] = c;   q.p[3] = b;
+        q.c[0] = c00; q.c[1] = c01; q.c[2] = c11; q.c[3] = c10;
+    }
+    return q;
+}
+
+// A whole culled face, one flat colour.
+inline MeshQuad FaceQuad(const MapFace& f) {
+    return FaceRectQuad(f, f.u0, f.v0, f.u1, f.v1, f.col, f.col, f.col, f.col);
+}
+
+struct MapMesh {
+    std::vector<Mesh> chunks;
+    Material          material = {};
+    bool              hasMaterial = false;
+    uint32_t          version = UINT32_MAX;   // geometryVersion last built
+    int               quadCount = 0;
+
+    void Build(const std::vector<MeshQuad>& quads, uint32_t geometryVersion) {
+        Unload();
+        if(!hasMaterial) { material = LoadMaterialDefault(); hasMaterial = true; }
+        version   = geometryVersion;
+        quadCount = (int)quads.size();
+
+        for(size_t first = 0; first < quads.size(); first += MAP_MESH_MAX_QUADS) {
+            int n = (int)std::min<size_t>(MAP_MESH_MAX_QUADS, quads.size() - first);
+            Mesh m = {};
+            m.vertexCount   = n * 4;
+            m.triangleCount = n * 2;
+            // UnloadMesh frees these with RL_FREE, so they must come from MemAlloc.
+            m.vertices = (float*)MemAlloc(m.vertexCount * 3 * sizeof(float));
+            m.colors   = (unsigned char*)MemAlloc(m.vertexCount * 4);
+            m.indices  = (unsigned short*)MemAlloc(m.triangleCount * 3 * sizeof(unsigned short));
+            for(int k = 0; k < n; k++) {
+                const MeshQuad& q = quads[first + k];
+                for(int c = 0; c < 4; c++) {
+                    int v = k * 4 + c;
+                    m.vertices[v * 3 + 0] = q.p[c].x;
+                    m.vertices[v * 3 + 1] = q.p[c].y;
+                    m.vertices[v * 3 + 2] = q.p[c].z;
+                    m.colors[v * 4 + 0] = q.c[c].r;
+                    m.colors[v * 4 + 1] = q.c[c].g;
+                    m.colors[v * 4 + 2] = q.c[c].b;
+                    m.colors[v * 4 + 3] = q.c[c].a;
+                }
+                unsigned short base = (unsigned short)(k * 4);
+                unsigned short* ix = m.indices + k * 6;
+                ix[0] = base; ix[1] = base + 1; ix[2] = base + 2;
+                ix[3] = base; ix[4] = base + 2; ix[5] = base + 3;
+            }
+            UploadMesh(&m, false);
+            chunks.push_back(m);
+        }
+    }
+
+    void Draw() const {
+        for(const Mesh& m : chunks) DrawMesh(m, material, MatrixIdentity());
+    }
+
+    void Unload() {
+        for(Mesh& m : chunks) UnloadMesh(m);
+        chunks.clear();
+        quadCount = 0;
+    }
+
+    void Shutdown() {
+        Unload();
+        if(hasMaterial) { UnloadMaterial(material); hasMaterial = false; }
+    }
+};
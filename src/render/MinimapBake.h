@@ -0,0 +1,50 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MinimapBake.h  –  Top-down minimap image rasterised on the CPU
+//
+//  Baked once per map (on the loader thread) so the HUD minimap is one
+//  textured quad instead of a per-frame walk over every solid.  Pixels are
+//  plain RGBA rows; the renderer uploads them in chunks on the main thread.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Entity.h"
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+constexpr int MINIMAP_TEX_SIZE = 256;   // pixels per edge
+
+struct MinimapBake {
+    int   size    = MINIMAP_TEX_SIZE;
+    float centerX = 0.0f, centerZ = 0.0f;
+    float span    = 50.0f;               // metres covered by the square
+    std::vector<Color> pixels;           // row-major, row 0 = min Z
+
+    // Fit the square around the map's XZ extent and clear to transparent.
+    void Begin(float minX, float maxX, float minZ, float maxZ) {
+        centerX = 0.5f * (minX + maxX);
+        centerZ = 0.5f * (minZ + maxZ);
+        span    = std::max({ 1.0f, maxX - minX, maxZ - minZ });
+        pixels.assign((size_t)size * size, Color{ 0, 0, 0, 0 });
+    }
+
+    // Walls and cover only; floors are left to the panel background.  Taller
+    // solids are drawn brighter so chokepoints read at a glance.
+    void Rasterize(const std::vector<MapSolid>& solids) {
+        const float scale = size / span;
+        for(const auto& s : solids) {
+            if(s.isFloor || s.bounds.max.y <= 0.2f) continue;
+            int x0 = std::max(0,        (int)floorf((s.bounds.min.x - centerX) * scale + size * 0.5f));
+            int x1 = std::min(size - 1, (int)ceilf ((s.bounds.max.x - centerX) * scale + size * 0.5f) - 1);
+            int z0 = std::max(0,        (int)floorf((s.bounds.min.z - centerZ) * scale + size * 0.5f));
+            int z1 = std::min(size - 1, (int)ceilf ((s.bounds.max.z - centerZ) * scale + size * 0.5f) - 1);
+            float lift = std::clamp(s.bounds.max.y / 4.0f, 0.3f, 1.0f);
+            Color c = { (unsigned char)(s.col.r * lift + 60 * (1.0f - lift)),
+                        (unsigned char)(s.col.g * lift + 60 * (1.0f - lift)),
+                        (unsigned char)(s.col.b * lift + 60 * (1.0f - lift)), 200 };
+            for(int z = z0; z <= z1; z++)
+                std::fill(pixels.begin() + (size_t)z * size + x0,
+                          pixels.begin() + (size_t)z * size + x1 + 1, c);
+        }
+    }
+};
@@ -0,0 +1,157 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  QualitySettings.h  –  Quality presets and the calibrated config file
+//
+//  A preset fixes the costs that scale with the machine: window MSAA, the
+//  share of the render target the scene fills, the wire edges drawn over
+//  every map solid, smoke layers and the impact/tracer caps.  Which one a
+//  machine gets is decided once by Calibration.h and kept in QUALITY_FILE
+//  with a fingerprint of the CPU, GPU renderer and driver version; when the
+//  fingerprint changes (new board, Mesa update) the game calibrates again.
+//  Hand edits to the [quality] values stick until then.
+//
+//  MSAA belongs to the window, so a new value applies from the next launch.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../IniFile.h"
+#include "../World.h"
+#include <raylib.h>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+
+constexpr const char* QUALITY_FILE        = "tacticallite.ini";
+constexpr int         CALIBRATION_VERSION = 1;   // bump when the benchmark changes
+
+enum class QualityPreset : uint8_t { LOW, MEDIUM, HIGH, COUNT };
+
+struct QualitySettings {
+    QualityPreset preset     = QualityPreset::HIGH;
+    bool  msaa               = true;
+    float renderScale        = 1.0f;
+    bool  mapEdges           = true;    // wire outline around each solid
+    int   smokeLayers        = 2;       // shell + dense core
+    int   maxImpacts         = MAX_IMPACTS;
+    int   maxTracers         = MAX_TRACERS;
+};
+
+// Best last; HIGH is what every machine got before calibration existed.
+constexpr QualitySettings QUALITY_PRESETS[(int)QualityPreset::COUNT] = {
+    { QualityPreset::LOW,    false, 0.750f, false, 1, 32,  16 },
+    { QualityPreset::MEDIUM, false, 0.875f, true,  1, 64,  32 },
+    { QualityPreset::HIGH,   true,  1.000f, true,  2, MAX_IMPACTS, MAX_TRACERS },
+};
+
+inline const char* QualityPresetName(QualityPreset p) {
+    static const char* NAMES[] = { "low", "medium", "high" };
+    return (int)p < (int)QualityPreset::COUNT ? NAMES[(int)p] : "custom";
+}
+
+// What the benchmark measured, kept in the file for reference.
+struct CalibrationResult {
+    float cpuTickMs   = 0.0f;   // one simulation tick with a full match
+    float fillMpixS   = 0.0f;   // blended full-target quads
+    float sceneMs[(int)QualityPreset::COUNT] = {};   // scripted scene per preset
+};
+
+// ─── GL driver identity ─────────────────────────────────────────────────────
+// raylib prints the GL renderer and version while InitWindow runs but has no
+// call that returns them, so a log callback picks them out on the way past.
+inline std::string g_glRenderer, g_glVersion;
+
+inline void CaptureGLInfo(int level, const char* fmt, va_list args) {
+    char text[512];
+    vsnprintf(text, sizeof(text), fmt, args);
+    auto grab = [&](const char* tag, std::string& out) {
+        if(const char* p = strstr(text, tag)) out = IniFile::Trim(p + strlen(tag));
+    };
+    grab("> Renderer:", g_glRenderer);
+    grab("> Version:",  g_glVersion);
+    static const char* PREFIX[] = { "", "TRACE: ", "DEBUG: ", "INFO: ", "WARNING: ", "ERROR: ", "FATAL: " };
+    printf("%s%s\n", level >= 0 && level <= LOG_FATAL ? PREFIX[level] : "", text);
+}
+
+inline std::string CpuModel() {
+    std::ifstream in("/proc/cpuinfo");
+    std::string line, model;
+    while(std::getline(in, line)) {
+        size_t colon = line.find(':');
+        if(colon == std::string::npos) continue;
+        std::string key = IniFile::Trim(line.substr(0, colon));
+        if(key == "Model" || (key == "model name" && model.empty()))
+            model = IniFile::Trim(line.substr(colon + 1));
+    }
+    return model.empty() ? "unknown cpu" : model;
+}
+
+// Call after InitWindow.
+inline std::string HardwareFingerprint() {
+    char buf[512];
+    snprintf(buf, sizeof(buf), "v%d | %s x%u | %s | %s", CALIBRATION_VERSION,
+             CpuModel().c_str(), std::thread::hardware_concurrency(),
+             g_glRenderer.empty() ? "unknown gpu" : g_glRenderer.c_str(),
+             g_glVersion.empty()  ? "unknown driver" : g_glVersion.c_str());
+    return buf;
+}
+
+// ─── Config file ────────────────────────────────────────────────────────────
+struct QualityConfig {
+    QualitySettings   settings;
+    CalibrationResult calibration;
+    std::string       fingerprint;   // empty: never calibrated
+    bool              loaded = false;
+
+    bool Load(const char* path) {
+        IniFile ini;
+        loaded = ini.Load(path) && ini.Has("calibration.fingerprint");
+        if(!loaded) return false;
+        fingerprint = ini.Get("calibration.fingerprint");
+
+        std::string name = ini.Get("quality.preset", "high");
+        settings = QUALITY_PRESETS[(int)QualityPreset::HIGH];
+        for(int p = 0; p < (int)QualityPreset::COUNT; p++)
+            if(name == QualityPresetName((QualityPreset)p)) settings = QUALITY_PRESETS[p];
+        settings.msaa        = ini.GetBool ("quality.msaa",         settings.msaa);
+        settings.renderScale = std::clamp(ini.GetFloat("quality.render_scale", settings.renderScale), 0.25f, 1.0f);
+        settings.mapEdges    = ini.GetBool ("quality.map_edges",    settings.mapEdges);
+        settings.smokeLayers = std::clamp(ini.GetInt("quality.smoke_layers", settings.smokeLayers), 1, 2);
+        settings.maxImpacts  = std::clamp(ini.GetInt("quality.max_impacts",  settings.maxImpacts), 0, MAX_IMPACTS);
+        settings.maxTracers  = std::clamp(ini.GetInt("quality.max_tracers",  settings.maxTracers), 0, MAX_TRACERS);
+
+        calibration.cpuTickMs = ini.GetFloat("calibration.cpu_tick_ms", 0.0f);
+        calibration.fillMpixS = ini.GetFloat("calibration.fill_mpix_s", 0.0f);
+        for(int p = 0; p < (int)QualityPreset::COUNT; p++)
+            calibration.sceneMs[p] = ini.GetFloat(std::string("calibration.scene_ms_") +
+                                                  QualityPresetName((QualityPreset)p), 0.0f);
+        return true;
+    }
+
+    bool Save(const char* path) const {
+        FILE* f = fopen(path, "w");
+        if(!f) {
+            TraceLog(LOG_WARNING, "QualityConfig: cannot write %s", path);
+            return false;
+        }
+        fprintf(f, "; Written by the quality calibration.  Edit [quality] freely;\n"
+                   "; delete this file or run with --calibrate to measure again.\n\n");
+        fprintf(f, "[quality]\npreset = %s\nmsaa = %d\nrender_scale = %.3f\nmap_edges = %d\n"
+                   "smoke_layers = %d\nmax_impacts = %d\nmax_tracers = %d\n\n",
+                QualityPresetName(settings.preset), settings.msaa ? 1 : 0, settings.renderScale,
+                settings.mapEdges ? 1 : 0, settings.smokeLayers, settings.maxImpacts, settings.maxTracers);
+        fprintf(f, "[calibration]\nfingerprint = %s\ncpu_tick_ms = %.3f\nfill_mpix_s = %.0f\n",
+                fingerprint.c_str(), calibration.cpuTickMs, calibration.fillMpixS);
+        for(int p = 0; p < (int)QualityPreset::COUNT; p++)
+            fprintf(f, "scene_ms_%s = %.2f\n", QualityPresetName((QualityPreset)p), calibration.sceneMs[p]);
+        fclose(f);
+        return true;
+    }
+};
+
+// Caps live in World so WeaponFire can honour them without the renderer.
+inline void ApplyQualityCaps(const QualitySettings& q, World& world) {
+    world.maxImpacts = q.maxImpacts;
+    world.maxTracers = q.maxTracers;
+}
@@ -5,7 +5,12 @@
 //  No shadow maps, no PBR; straight flat/unshaded colours → fast on Pi 4.
 // ─────────────────────────────────────────────────────────────────────────────
 #include "../World.h"
+#include "../Tuning.h"
 #include "../weapons/WeaponSystem.h"
+#include "../utility/TrajectoryPreview.h"
+#include "MinimapBake.h"
+#include "MapAO.h"
+#include "MapMesh.h"
 #include <raylib.h>
 #include <raymath.h>
 #include <rlgl.h>
@@ -14,9 +19,26 @@
 
 struct Renderer {
     RenderTexture2D renderTarget;   // 1280×720 offscreen
+    float           renderScale = 1.0f;       // share of it the scene fills (FramePacer)
+    bool            reducedEffects = false;   // cheaper smoke, no impact marks
+    bool            mapEdges    = true;       // QualitySettings
+    int             smokeLayers = 2;
     Camera3D        cam3D;
     Font            uiFont;
-    Model           viewmodelGun;
+    Model           viewmodelGun = {};   // built on first draw
+    TrajectoryPreview throwPreview;  // cached arc for the held utility key
+    // Network client: other pawns drawn from these instead of world.pawns
+    const std::array<PawnPose, MAX_PAWNS>* remotePawns = nullptr;
+    // Local play: poses before the last tick, lerped to world.pawns by tickAlpha
+    const std::array<PawnPose, MAX_PAWNS>* tickPawns = nullptr;
+    float           tickAlpha = 1.0f;
+
+    MapMesh         mapMesh;        // baked visible faces of world.solids
+
+    // Baked minimap; rows go up to the GPU a few per frame after a load
+    MinimapBake     minimap;
+    Texture2D       minimapTex = {};
+    int             minimapRowsUploaded = 0;
 
     void Init() {
         renderTarget = LoadRenderTexture(RENDER_W, RENDER_H);
@@ -24,21 +46,69 @@ struct Renderer {
 
         cam3D = {};
         cam3D.up         = {0,1,0};
-        cam3D.fovy       = CAM_FOV;
+        cam3D.fovy       = Tune().camFov;
         cam3D.projection = CAMERA_PERSPECTIVE;
 
         uiFont = GetFontDefault();
-        viewmodelGun = LoadModelFromMesh(GenMeshCube(0.1f, 0.15f, 0.4f));
     }
 
     void Shutdown() {
-        UnloadModel(viewmodelGun);
+        if(minimapTex.id) UnloadTexture(minimapTex);
+        mapMesh.Shutdown();
+        if(viewmodelGun.meshCount) UnloadModel(viewmodelGun);
         UnloadRenderTexture(renderTarget);
     }
 
+    // Upload map quads culled and baked off the main thread by the load job,
+    // hot reload or streamer.  DrawMap keeps the old mesh until they arrive.
+    void SetMapMesh(const std::vector<MeshQuad>& quads, uint32_t geometryVersion) {
+        if(!quads.empty()) mapMesh.Build(quads, geometryVersion);
+    }
+
+    // Replace the baked minimap; UploadMinimapRows then streams it in.
+    void SetMinimap(MinimapBake&& bake) {
+        minimap = std::move(bake);
+        minimapRowsUploaded = 0;
+    }
+
+    // ── Chunked GPU upload of the baked minimap ────────────────────────────
+    // Allocates the texture empty, then sends at most maxRows rows per call so
+    // a loading frame never blocks on one large transfer.  True when done.
+    bool UploadMinimapRows(int maxRows) {
+        if(minimap.pixels.empty()) return true;
+        if(minimapTex.id == 0 || minimapTex.width != minimap.size) {
+            if(minimapTex.id) UnloadTexture(minimapTex);
+            minimapTex = {};
+            minimapTex.id      = rlLoadTexture(nullptr, minimap.size, minimap.size,
+                                               PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+            minimapTex.width   = minimap.size;
+            minimapTex.height  = minimap.size;
+            minimapTex.mipmaps = 1;
+            minimapTex.format  = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+            SetTextureFilter(minimapTex, TEXTURE_FILTER_BILINEAR);
+        }
+        int rows = std::min(maxRows, minimap.size - minimapRowsUploaded);
+        UpdateTextureRec(minimapTex,
+                         { 0, (float)minimapRowsUploaded, (float)minimap.size, (float)rows },
+                         minimap.pixels.data() + (size_t)minimapRowsUploaded * minimap.size);
+        minimapRowsUploaded += rows;
+        if(minimapRowsUploaded < minimap.size) return false;
+        minimap.pixels.clear();
+        minimap.pixels.shrink_to_fit();
+        return true;
+    }
+
+    float MinimapUploadProgress() const {
+        if(minimap.pixels.empty()) return 1.0f;
+        return (float)minimapRowsUploaded / (float)minimap.size;
+    }
+
     // ── Sync camera to player ──────────────────────────────────────────────
-    void SyncCamera(const Pawn& player, float dt) {
-        float targetFov = CAM_FOV;
+    // The eye moves from prevEye (before the last tick) toward the player's
+    // by alpha, the share of the next tick already elapsed.  Orientation is
+    // the latest command's, so mouse look gains no delay.
+    void SyncCamera(const Pawn& player, Vector3 prevEye, float alpha, float dt) {
+        float targetFov = Tune().camFov;
         if(player.alive && player.weapon.isADS) {
             targetFov = (player.weapon.id == WeaponID::SNIPER) ? 28.0f : 58.0f;
         }
@@ -46,15 +116,37 @@ struct Renderer {
         float fovLerp = std::clamp(dt * 14.0f, 0.0f, 1.0f);
         cam3D.fovy = Lerp1(cam3D.fovy, targetFov, fovLerp);
 
-        cam3D.position = player.eyePos();
+        Vector3 eye = player.eyePos();
+        if(Vector3DistanceSqr(prevEye, eye) <= POSE_SNAP_DIST * POSE_SNAP_DIST)
+            eye = Vector3Lerp(prevEye, eye, alpha);
+        cam3D.position = eye;
         cam3D.target   = Vector3Add(cam3D.position, player.lookDir());
     }
 
     // ── Draw everything ─────────────────────────────────────────────────────
     void DrawFrame(const World& world, int screenW, int screenH) {
-        // ── 1. Render 3D scene to offscreen texture ─────────────────────────
+        DrawScene(world);
+
+        // ── 2. Blit scaled to screen ─────────────────────────────────────────
+        // Source flipped on Y because OpenGL textures are bottom-up
+        Rectangle src = { 0, 0, (float)SceneWidth(), -(float)SceneHeight() };
+        Rectangle dst = { 0, 0, (float)screenW,  (float)screenH   };
+        DrawTexturePro(renderTarget.texture, src, dst, {0,0}, 0, WHITE);
+
+        // ── 3. HUD (drawn at native resolution) ──────────────────────────────
+        DrawHUD(world, screenW, screenH);
+    }
+
+    int SceneWidth()  const { return (int)(RENDER_W * renderScale); }
+    int SceneHeight() const { return (int)(RENDER_H * renderScale); }
+
+    // ── 1. Render 3D scene to offscreen texture ─────────────────────────────
+    void DrawScene(const World& world) {
+        // Dynamic resolution: the scene fills the bottom-left renderScale of
+        // the target (GL rows start at the bottom) and only that is blitted.
         BeginTextureMode(renderTarget);
         ClearBackground(COL_SKY);
+        rlViewport(0, 0, SceneWidth(), SceneHeight());
 
         BeginMode3D(cam3D);
 
@@ -65,6 +157,7 @@ struct Renderer {
             DrawTracers(world);
             DrawImpacts(world);
             DrawObjective(world);
+            DrawThrowPreview(world);
 
         EndMode3D();
 
@@ -75,15 +168,6 @@ struct Renderer {
         rlEnableDepthTest();
         EndMode3D();
         EndTextureMode();
-
-        // ── 2. Blit scaled to screen ─────────────────────────────────────────
-        // Source flipped on Y because OpenGL textures are bottom-up
-        Rectangle src = { 0, 0, (float)RENDER_W, -(float)RENDER_H };
-        Rectangle dst = { 0, 0, (float)screenW,  (float)screenH   };
-        DrawTexturePro(renderTarget.texture, src, dst, {0,0}, 0, WHITE);
-
-        // ── 3. HUD (drawn at native resolution) ──────────────────────────────
-        DrawHUD(world, screenW, screenH);
     }
 
     // ─── Draw local player Viewmodel ─────────────────────────────────────────
@@ -91,6 +175,8 @@ struct Renderer {
         const Pawn& p = world.player();
         if(!p.alive) return;
 
+        if(!viewmodelGun.meshCount)
+            viewmodelGun = LoadModelFromMesh(GenMeshCube(0.1f, 0.15f, 0.4f));
         Vector3 eye = p.eyePos();
 
         rlPushMatrix();
@@ -116,6 +202,23 @@ struct Renderer {
 private:
     // ─── Map geometry ────────────────────────────────────────────────────────
     void DrawMap(const World& world) {
+        if(mapMesh.version == UINT32_MAX) RebuildMapMesh(world);   // nothing baked yet
+        mapMesh.Draw();
+
+        if(mapEdges) DrawMapEdges(world);
+
+        // Waypoint debug dots (disable in release)
+#if defined(SHOW_WAYPOINTS)
+        for(auto& wp : world.waypoints) {
+            DrawSphere(wp.pos, 0.15f, YELLOW);
+            for(int nb : wp.neighbours)
+                DrawLine3D(wp.pos, world.waypoints[nb].pos, { 255,255,0,100 });
+        }
+#endif
+    }
+
+    // Wire outline a little outside each solid for edge definition
+    void DrawMapEdges(const World& world) {
         for(auto& s : world.solids) {
             Vector3 center = {
                 (s.bounds.min.x + s.bounds.max.x) * 0.5f,
@@ -127,29 +230,35 @@ private:
                 s.bounds.max.y - s.bounds.min.y,
                 s.bounds.max.z - s.bounds.min.z
             };
-            DrawCube(center, size.x, size.y, size.z, s.col);
             // Draw wire slightly larger to give edge definition (increased offset to stop Z-fighting jitter)
             DrawCubeWires(center, size.x + 0.04f, size.y + 0.04f, size.z + 0.04f,
                           { (unsigned char)(s.col.r/2),
                             (unsigned char)(s.col.g/2),
                             (unsigned char)(s.col.b/2), 120 });
         }
+    }
 
-        // Waypoint debug dots (disable in release)
-#if defined(SHOW_WAYPOINTS)
-        for(auto& wp : world.waypoints) {
-            DrawSphere(wp.pos, 0.15f, YELLOW);
-            for(int nb : wp.neighbours)
-                DrawLine3D(wp.pos, world.waypoints[nb].pos, { 255,255,0,100 });
-        }
-#endif
+    // Faces hidden behind touching solids are culled before upload.  Only a
+    // fallback now: every map change hands over pre-baked quads.
+    void RebuildMapMesh(const World& world) {
+        int facesIn = 0;
+        std::vector<MapFace> faces = BuildVisibleFaces(world.solids, &facesIn);
+        MapAOStats ao;
+        std::vector<MeshQuad> quads = BakeMapAO(faces, world.solids, world.solidGrid, &ao);
+        mapMesh.Build(quads, world.geometryVersion);
+        TraceLog(LOG_INFO, "Renderer: map mesh %d faces -> %d visible -> %d AO quads, %d chunk(s)",
+                 facesIn, (int)faces.size(), ao.quads, (int)mapMesh.chunks.size());
+        TraceLog(LOG_INFO, "Renderer: AO bake %d samples on %d thread(s) in %.1f ms",
+                 ao.vertices, ao.threads, ao.ms);
     }
 
     // ─── Pawns (capsule-like: cylinder body + sphere head) ──────────────────
     void DrawPawns(const World& world) {
         for(int i = 0; i < MAX_PAWNS; i++) {
-            const Pawn& p = world.pawns[i];
-            if(!p.alive || i == world.playerID) continue;  // skip dead & self
+            const PawnPose p = remotePawns ? (*remotePawns)[i]
+                             : tickPawns   ? PawnPose::Lerp((*tickPawns)[i], PawnPose::Of(world.pawns[i]), tickAlpha)
+                             :               PawnPose::Of(world.pawns[i]);
+            if(!p.visible || i == world.playerID) continue;  // skip dead & self
 
             Color bodyCol = (p.team == Team::ATTACK) ? COL_ATTACK : COL_DEFEND;
             Color darkCol = { (unsigned char)(bodyCol.r/2),
@@ -157,18 +266,18 @@ private:
                               (unsigned char)(bodyCol.b/2), 255 };
 
             // Body
-            DrawCylinder(p.xform.pos, PLAYER_RADIUS, PLAYER_RADIUS,
+            DrawCylinder(p.pos, PLAYER_RADIUS, PLAYER_RADIUS,
                          p.height() * 0.8f, 6, bodyCol);
             // Head
-            Vector3 headPos = { p.xform.pos.x,
-                                p.xform.pos.y + p.height() * 0.9f,
-                                p.xform.pos.z };
+            Vector3 headPos = { p.pos.x,
+                                p.pos.y + p.height() * 0.9f,
+                                p.pos.z };
             DrawSphere(headPos, 0.22f, darkCol);
             // "Gun" stub
-            Vector3 gunFwd = { sinf(p.xform.yaw) * 0.6f, 0.0f, cosf(p.xform.yaw) * 0.6f };
-            Vector3 gunEnd = Vector3Add(Vector3Add(p.xform.pos,
+            Vector3 gunFwd = { sinf(p.yaw) * 0.6f, 0.0f, cosf(p.yaw) * 0.6f };
+            Vector3 gunEnd = Vector3Add(Vector3Add(p.pos,
                                 Vector3{0, p.height()*0.55f, 0}), gunFwd);
-            DrawLine3D(Vector3Add(p.xform.pos, {0, p.height()*0.55f, 0}),
+            DrawLine3D(Vector3Add(p.pos, {0, p.height()*0.55f, 0}),
                        gunEnd, RAYWHITE);
 
             // HP bar above head
@@ -195,9 +304,11 @@ private:
             float alpha = std::min(1.0f, s.lifeLeft / 2.0f); // fade out at the end
             // Full opacity during main lifetime (255) instead of transparent
             Color c = { 155, 155, 155, (unsigned char)(255 * alpha) };
+            if(reducedEffects) { DrawSphereEx(s.pos, s.radius, 8, 8, c); continue; }
             DrawSphere(s.pos, s.radius, c);
             // Inner denser core
-            DrawSphere(s.pos, s.radius * 0.6f, { 130,130,130,(unsigned char)(255 * alpha) });
+            if(smokeLayers > 1)
+                DrawSphere(s.pos, s.radius * 0.6f, { 130,130,130,(unsigned char)(255 * alpha) });
         }
     }
 
@@ -212,6 +323,7 @@ private:
 
     // ─── Bullet holes / Impacts ──────────────────────────────────────────────
     void DrawImpacts(const World& world) {
+        if(reducedEffects) return;
         for(auto& imp : world.impacts) {
             float alpha = std::min(1.0f, imp.lifeSec); // Fade out last second
             Color c = { 10, 10, 10, (unsigned char)(255 * alpha) };
@@ -220,6 +332,37 @@ private:
         }
     }
 
+    // ─── Held-utility arc (one batched line list) ────────────────────────────
+    void DrawThrowPreview(const World& world) {
+        const Pawn& p = world.player();
+        if(!p.alive || p.primedUtility < 0) { throwPreview.Reset(); return; }
+
+        throwPreview.Update(p, (UtilityID)p.primedUtility, world);
+        if(throwPreview.count < 2) return;
+
+        Color c = (p.primedUtility == (int)UtilityID::FRAG)  ? Color{ 60,200,60,255 }
+                : (p.primedUtility == (int)UtilityID::SMOKE) ? Color{ 200,200,200,255 }
+                : Color{ 240,240,60,255 };
+
+        // Skip the first few points so the line doesn't start inside the eye.
+        const int first = std::min(2, throwPreview.count - 2);
+        rlBegin(RL_LINES);
+        for(int i = first; i + 1 < throwPreview.count; i++) {
+            unsigned char a = (unsigned char)(220 - 140 * i / throwPreview.count);
+            rlColor4ub(c.r, c.g, c.b, a);
+            const Vector3& s0 = throwPreview.points[i];
+            const Vector3& s1 = throwPreview.points[i + 1];
+            rlVertex3f(s0.x, s0.y, s0.z);
+            rlVertex3f(s1.x, s1.y, s1.z);
+        }
+        rlEnd();
+
+        if(throwPreview.complete) {
+            Vector3 end = throwPreview.points[throwPreview.count - 1];
+            DrawCircle3D(end, 0.3f, {1,0,0}, 90.0f, c);
+        }
+    }
+
     // ─── Objective zone ──────────────────────────────────────────────────────
     void DrawObjective(const World& world) {
         Color c = world.objective.captured ? Color{80,255,80,180} : Color{220,180,40,140};
@@ -349,30 +492,19 @@ private:
 
     // ─── Mini-map ─────────────────────────────────────────────────────────────
     void DrawMinimap(const World& world, int ox, int oy, int size) {
-        float minX = -25.0f, maxX = 25.0f;
-        float minZ = -25.0f, maxZ = 25.0f;
-        if(!world.solids.empty()) {
-            minX = world.solids[0].bounds.min.x;
-            maxX = world.solids[0].bounds.max.x;
-            minZ = world.solids[0].bounds.min.z;
-            maxZ = world.solids[0].bounds.max.z;
-            for(const auto& s : world.solids) {
-                minX = std::min(minX, s.bounds.min.x);
-                maxX = std::max(maxX, s.bounds.max.x);
-                minZ = std::min(minZ, s.bounds.min.z);
-                maxZ = std::max(maxZ, s.bounds.max.z);
-            }
-        }
-
-        float spanX = std::max(1.0f, maxX - minX);
-        float spanZ = std::max(1.0f, maxZ - minZ);
-        float worldSpan = std::max(spanX, spanZ);
+        float worldSpan = minimap.span;
         float mapScale = (size - 10.0f) / worldSpan;
-        float centerX = (minX + maxX) * 0.5f;
-        float centerZ = (minZ + maxZ) * 0.5f;
+        float centerX = minimap.centerX;
+        float centerZ = minimap.centerZ;
 
         DrawRectangle(ox, oy, size, size, {0,0,0,160});
         DrawRectangleLines(ox, oy, size, size, GRAY);
+        if(minimapTex.id) {
+            float inner = size - 10.0f;
+            DrawTexturePro(minimapTex,
+                           { 0, 0, (float)minimapTex.width, (float)minimapTex.height },
+                           { ox + 5.0f, oy + 5.0f, inner, inner }, { 0, 0 }, 0.0f, WHITE);
+        }
 
         auto wToMap = [&](float wx, float wz) -> Vector2 {
             return { ox + size/2.0f + (wx - centerX) * mapScale,
@@ -0,0 +1,334 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  MatchHost.h  –  Many independent matches in one process on a worker pool
+//
+//  Each Match owns its World (pawns, bot brains, rng, a copy of the map
+//  geometry) and its MapData, and ticks at its own fixed rate against
+//  InputClock.  Add() deals matches to the least loaded of a fixed set of
+//  workers.  A worker runs its own due matches, earliest deadline first;
+//  when none of its own are due it steals one that has waited
+//  MATCH_STEAL_AFTER of a period because its owner is still busy.  A match is only ever claimed under its owner's
+//  lock and runs on one thread at a time, so the simulation needs no locks.
+//
+//  Human seats (MatchConfig::humanSeats) are fed through Match::Submit, one
+//  producer thread per seat; a seat with nothing queued repeats its last
+//  command.  Each tick every seat in MatchConfig::snapshotSeats gets a
+//  Snapshot filtered by its ClientInterest (Relevancy.h), queued for
+//  Match::TakeSnapshot.  Tuning is process-wide: load it before Start()
+//  and leave it.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../SpscRing.h"
+#include "../World.h"
+#include "../game/InputSnapshot.h"
+#include "../game/InputSystem.h"
+#include "../game/MapLoader.h"
+#include "../game/PlayerCommand.h"
+#include "../game/RoundManager.h"
+#include "Relevancy.h"
+#include "Snapshot.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+constexpr uint32_t MATCH_COMMAND_QUEUE = 32;     // per human seat, power of two
+constexpr uint32_t MATCH_SNAPSHOT_QUEUE = 4;     // per client seat; newest dropped when full
+constexpr double   MATCH_IDLE_SLEEP    = 0.001;  // longest nap with nothing due, s
+constexpr double   MATCH_STEAL_AFTER   = 0.25;   // periods overdue before another worker takes it
+constexpr int      MATCH_MIN_TICK_HZ   = 10;
+constexpr int      MATCH_MAX_TICK_HZ   = 128;
+
+struct MatchConfig {
+    int      tickHz     = SIM_TICK_HZ;
+    uint8_t  humanSeats = 0;       // bit per pawn fed by Submit; bots take the rest
+    uint8_t  snapshotSeats = 0;    // bit per pawn whose client gets snapshots; 0: humanSeats
+    uint64_t seed       = 1;
+    bool     effects    = false;   // tracers and impacts: nobody draws them here
+};
+
+struct MatchSummary {
+    int      id          = 0;
+    uint32_t ticks       = 0;
+    int      rounds      = 0;   // played
+    int      scoreAttack = 0;
+    int      scoreDefend = 0;
+};
+
+struct Match {
+    int      id       = 0;
+    World    world;
+    MapData  md;
+    double   period   = SIM_DT;   // seconds per tick
+    double   nextTick = 0.0;      // InputClock time the next tick is due
+    uint32_t tick     = 0;
+
+    // Producer: the thread that owns that seat's connection.  Stop once the
+    // match id has come back from TakeFinished.
+    bool Submit(int seat, const PlayerCommand& cmd) { return commands[seat].TryPush(cmd); }
+
+    // Consumer: the thread sending that seat's snapshots.  Oldest first.
+    bool TakeSnapshot(int seat, SnapshotPacket& out) { return snapshots[seat].TryPop(out); }
+
+private:
+    friend class MatchHost;
+    std::atomic<bool> claimed{ false };    // a worker is ticking it
+    std::atomic<bool> finished{ false };   // reached MATCH_OVER
+    std::atomic<bool> retired{ false };    // summary taken, owner may free it
+    std::array<SpscRing<PlayerCommand, MATCH_COMMAND_QUEUE>, MAX_PAWNS> commands;
+    std::array<PlayerCommand, MAX_PAWNS> lastCommand{};
+    uint8_t snapshotSeats = 0;
+    std::array<ClientInterest, MAX_PAWNS> interest;
+    std::array<SpscRing<SnapshotPacket, MATCH_SNAPSHOT_QUEUE>, MAX_PAWNS> snapshots;
+};
+
+// Counters since the previous TakeStats.
+struct MatchHostStats {
+    uint64_t ticks   = 0;
+    uint64_t stolen  = 0;   // ticks run by a worker that did not own the match
+    uint64_t late    = 0;   // ticks started over half a period after they were due
+    uint64_t dropped = 0;   // ticks skipped after falling SIM_MAX_TICKS behind
+    uint64_t snapshotBytes = 0;
+    double   snapshotClientSec = 0.0;   // client-seconds those bytes covered
+    uint32_t snapshotLargest   = 0;     // bytes, one packet
+
+    double BytesPerClientSec() const {
+        return snapshotClientSec > 0.0 ? snapshotBytes / snapshotClientSec : 0.0;
+    }
+    std::vector<double> busySec;   // per worker
+};
+
+class MatchHost {
+public:
+    MatchHost() = default;
+    MatchHost(const MatchHost&) = delete;
+    MatchHost& operator=(const MatchHost&) = delete;
+    ~MatchHost() { Stop(); }
+
+    void Start(int workerCount) {
+        Stop();
+        workerCount = std::max(1, workerCount);
+        workers.clear();
+        for(int i = 0; i < workerCount; i++) workers.push_back(std::make_unique<Worker>());
+        running.store(true);
+        for(int i = 0; i < workerCount; i++)
+            workers[i]->thread = std::thread([this, i] { Run(i); });
+    }
+
+    void Stop() {
+        running.store(false);
+        for(auto& w : workers)
+            if(w->thread.joinable()) w->thread.join();
+    }
+
+    // After Start().  map is a World holding only installed geometry, as
+    // MapLoadJob builds it.  The pointer is valid until TakeFinished
+    // returns the match's id.
+    Match* Add(const World& map, const MapData& md, const MatchConfig& cfg) {
+        auto m = std::make_unique<Match>();
+        m->id = nextId.fetch_add(1);
+        World& world = m->world;
+        world.solids          = map.solids;
+        world.solidGrid       = map.solidGrid;
+        world.waypoints       = map.waypoints;
+        world.objective       = map.objective;
+        world.geometryVersion = map.geometryVersion;
+        world.humanSeats      = cfg.humanSeats;
+        world.rng.Seed(cfg.seed);
+        if(!cfg.effects) world.maxTracers = world.maxImpacts = 0;
+        m->snapshotSeats = cfg.snapshotSeats ? cfg.snapshotSeats : cfg.humanSeats;
+        m->md     = md;
+        m->period = 1.0 / std::clamp(cfg.tickHz, MATCH_MIN_TICK_HZ, MATCH_MAX_TICK_HZ);
+        ResetRound(world, m->md);
+        for(int i = 0; i < MAX_PAWNS; i++) {   // seats hold their spawn view until heard from
+            m->lastCommand[i].yaw   = QuantizeYaw(world.pawns[i].xform.yaw);
+            m->lastCommand[i].pitch = QuantizePitch(world.pawns[i].xform.pitch);
+            m->interest[i].Reset(i, world);
+        }
+        m->nextTick = InputClock() + m->period;
+
+        Worker* target = workers.front().get();
+        size_t  fewest = SIZE_MAX;
+        for(auto& w : workers) {
+            std::lock_guard<std::mutex> hold(w->lock);
+            if(w->matches.size() < fewest) { fewest = w->matches.size(); target = w.get(); }
+        }
+        Match* out = m.get();
+        std::lock_guard<std::mutex> hold(target->lock);
+        target->matches.push_back(std::move(m));
+        active.fetch_add(1);
+        return out;
+    }
+
+    int Active() const { return active.load(); }
+    int WorkerCount() const { return (int)workers.size(); }
+
+    // Matches that reached MATCH_OVER since the last call.
+    void TakeFinished(std::vector<MatchSummary>& out) {
+        std::lock_guard<std::mutex> hold(finishedLock);
+        for(const Done& d : done) {
+            out.push_back(d.summary);
+            d.match->retired.store(true, std::memory_order_release);
+        }
+        done.clear();
+    }
+
+    MatchHostStats TakeStats() {
+        MatchHostStats s;
+        for(auto& w : workers) {
+            s.ticks   += w->ticks.exchange(0);
+            s.stolen  += w->stolen.exchange(0);
+            s.late    += w->late.exchange(0);
+            s.dropped += w->dropped.exchange(0);
+            s.busySec.push_back(w->busyNs.exchange(0) * 1e-9);
+            s.snapshotBytes     += w->snapBytes.exchange(0);
+            s.snapshotClientSec += w->snapClientNs.exchange(0) * 1e-9;
+            s.snapshotLargest    = std::max(s.snapshotLargest, (uint32_t)w->snapLargest.exchange(0));
+        }
+        return s;
+    }
+
+private:
+    struct Worker {
+        std::thread                         thread;
+        std::mutex                          lock;      // guards matches and claims
+        std::vector<std::unique_ptr<Match>> matches;
+        std::atomic<uint64_t> ticks{ 0 }, stolen{ 0 }, late{ 0 }, dropped{ 0 }, busyNs{ 0 };
+        std::atomic<uint64_t> snapBytes{ 0 }, snapClientNs{ 0 }, snapLargest{ 0 };
+    };
+    struct Done {
+        Match*       match;
+        MatchSummary summary;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<bool> running{ false };
+    std::atomic<int>  active{ 0 };
+    std::atomic<int>  nextId{ 1 };
+    std::mutex        finishedLock;
+    std::vector<Done> done;
+
+    void Run(int self) {
+        Worker& own = *workers[self];
+        const int n = (int)workers.size();
+        while(running.load(std::memory_order_relaxed)) {
+            double now  = InputClock();
+            double wake = now + MATCH_IDLE_SLEEP;
+            Match* m = Claim(own, now, 0.0, &wake);
+            bool stolen = false;
+            for(int k = 1; !m && k < n; k++) {
+                m = Claim(*workers[(self + k) % n], now, MATCH_STEAL_AFTER, nullptr);
+                stolen = m != nullptr;
+            }
+            if(m) {
+                RunDue(*m, own, stolen);
+                continue;
+            }
+            std::this_thread::sleep_for(std::chrono::duration<double>(std::max(0.0, wake - now)));
+        }
+    }
+
+    // Earliest match in w's list due grace periods ago, claimed; the owner
+    // (wake set) also frees retired matches and learns when its next is due.
+    Match* Claim(Worker& w, double now, double grace, double* wake) {
+        std::lock_guard<std::mutex> hold(w.lock);
+        Match* best = nullptr;
+        for(size_t i = 0; i < w.matches.size();) {
+            Match& m = *w.matches[i];
+            if(m.claimed.load(std::memory_order_acquire)) { i++; continue; }
+            if(m.finished.load(std::memory_order_relaxed)) {
+                if(wake && m.retired.load(std::memory_order_acquire)) {
+                    w.matches[i] = std::move(w.matches.back());
+                    w.matches.pop_back();
+                } else {
+                    i++;
+                }
+                continue;
+            }
+            if(m.nextTick + m.period * grace <= now && (!best || m.nextTick < best->nextTick)) best = &m;
+            else if(wake) *wake = std::min(*wake, m.nextTick);
+            i++;
+        }
+        if(best) best->claimed.store(true, std::memory_order_relaxed);
+        return best;
+    }
+
+    void RunDue(Match& m, Worker& w, bool stolen) {
+        auto   t0  = std::chrono::steady_clock::now();
+        double now = InputClock();
+        uint64_t ran = 0, late = 0;
+        while(m.nextTick <= now && ran < (uint64_t)SIM_MAX_TICKS &&
+              m.world.roundState != RoundState::MATCH_OVER) {
+            if(InputClock() - m.nextTick > m.period * 0.5) late++;
+            Tick(m);
+            SendSnapshots(m, w);
+            m.nextTick += m.period;
+            ran++;
+        }
+        if(m.nextTick <= now) {   // too far behind: skip the time, don't spiral
+            w.dropped.fetch_add((uint64_t)((now - m.nextTick) / m.period) + 1, std::memory_order_relaxed);
+            m.nextTick = now + m.period;
+        }
+        w.ticks.fetch_add(ran, std::memory_order_relaxed);
+        w.late.fetch_add(late, std::memory_order_relaxed);
+        if(stolen) w.stolen.fetch_add(ran, std::memory_order_relaxed);
+
+        if(m.world.roundState == RoundState::MATCH_OVER) {
+            const World& world = m.world;
+            {
+                std::lock_guard<std::mutex> hold(finishedLock);
+                done.push_back({ &m, { m.id, m.tick, world.roundNumber - 1,
+                                       world.scoreAttack, world.scoreDefend } });
+            }
+            active.fetch_sub(1);
+            m.finished.store(true, std::memory_order_relaxed);
+        }
+        w.busyNs.fetch_add((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - t0).count(),
+                           std::memory_order_relaxed);
+        m.claimed.store(false, std::memory_order_release);   // last touch
+    }
+
+    static void Tick(Match& m) {
+        World&      world = m.world;
+        const float dt    = (float)m.period;
+        m.tick++;
+        for(int i = 0; i < MAX_PAWNS; i++) {
+            if(!(world.humanSeats & (1u << i))) continue;
+            PlayerCommand cmd;
+            if(m.commands[i].TryPop(cmd)) {
+                m.lastCommand[i] = cmd;
+            } else {
+                cmd      = m.lastCommand[i];
+                cmd.tick = m.tick;
+            }
+            ApplyPlayerCommand(world, world.pawns[i], cmd, dt);
+        }
+        StepWorld(world, m.md, m.tick, dt);
+        world.soundEvents.Clear();   // no mixer here; bots hear World::noises
+    }
+
+    static void SendSnapshots(Match& m, Worker& w) {
+        if(!m.snapshotSeats) return;
+        SnapshotPacket packet;
+        uint64_t bytes = 0, clients = 0, largest = 0;
+        for(int i = 0; i < MAX_PAWNS; i++) {
+            if(!(m.snapshotSeats & (1u << i))) continue;
+            UpdateInterest(m.interest[i], i, m.world, (float)m.period);
+            packet.tick = m.tick;
+            packet.size = (uint16_t)WriteSnapshot(m.world, m.tick, i, m.interest[i], packet.bytes);
+            m.snapshots[i].TryPush(packet);
+            bytes  += packet.size;
+            largest = std::max<uint64_t>(largest, packet.size);
+            clients++;
+        }
+        w.snapBytes.fetch_add(bytes, std::memory_order_relaxed);
+        w.snapClientNs.fetch_add((uint64_t)(clients * m.period * 1e9), std::memory_order_relaxed);
+        uint64_t prev = w.snapLargest.load(std::memory_order_relaxed);
+        while(largest > prev && !w.snapLargest.compare_exchange_weak(prev, largest)) {}
+    }
+};
@@ -0,0 +1,132 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  Relevancy.h  –  Which entities one client's snapshots carry
+//
+//  Enemies are only sent to a client that could see or hear them, so a
+//  snapshot neither wastes bytes on pawns behind the map nor hands a
+//  wallhack their positions.  Per client and RELEVANCY_HZ times a second
+//  (seats staggered so they don't share a tick), enemies within
+//  RELEVANCY_FAR are ray-tested from the client's eye, and from where the
+//  eye will be RELEVANCY_LEAD_SEC ahead, against map solids (packet rays)
+//  and RayBlockedBySmoke.  A pawn that passes, comes within RELEVANCY_NEAR
+//  or makes a noise the client can hear stays relevant for
+//  RELEVANCY_HOLD_SEC.  That hold is the hysteresis: a pawn at a wall edge
+//  does not blink in and out between checks.  Teammates, dead pawns and
+//  the client's own pawn are always sent.
+//
+//  Grenades, smokes and tracers follow from that: smokes are sent to
+//  everyone within RELEVANCY_FAR, and grenades and tracers when their
+//  thrower or shooter is relevant or they land near the client.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../World.h"
+#include "../game/Physics.h"
+#include <raymath.h>
+#include <array>
+#include <cstdint>
+
+constexpr float RELEVANCY_HZ        = 10.0f;    // visibility passes per client per second
+constexpr float RELEVANCY_HOLD_SEC  = 0.6f;     // stays relevant after the last pass
+constexpr float RELEVANCY_LEAD_SEC  = 0.15f;    // eye extrapolated this far for peeks
+constexpr float RELEVANCY_NEAR      = 6.0f;     // always relevant inside, metres
+constexpr float RELEVANCY_FAR       = 120.0f;   // never relevant beyond, metres
+
+struct ClientInterest {
+    float    timer       = 0.0f;   // seconds to the next visibility pass
+    uint32_t noiseCursor = 0;      // World::noises already heard
+    uint8_t  pawns       = 0;      // bit per relevant pawn
+    std::array<float, MAX_PAWNS> heldFor{};   // seconds each pawn stays relevant
+
+    void Reset(int seat, const World& world) {
+        *this       = ClientInterest{};
+        timer       = seat / (RELEVANCY_HZ * MAX_PAWNS);   // stagger the seats
+        noiseCursor = world.noises.head;
+    }
+
+    bool Has(int pawn) const { return pawns & (1u << pawn); }
+};
+
+// Rays from eye to the chest of every pawn in candidates; a bit per pawn
+// with a clear line through solids and smoke.
+inline uint8_t PawnsVisibleFrom(Vector3 eye, uint8_t candidates, const World& world) {
+    RayQuery rays[MAX_PACKET_RAYS];
+    Vector3  targets[MAX_PACKET_RAYS];
+    int      ids[MAX_PACKET_RAYS];
+    int      n = 0;
+    for(int i = 0; i < MAX_PAWNS && n < MAX_PACKET_RAYS; i++) {
+        if(!(candidates & (1u << i))) continue;
+        const Pawn& p = world.pawns[i];
+        Vector3 chest = { p.xform.pos.x, p.xform.pos.y + p.height() * 0.6f, p.xform.pos.z };
+        Vector3 d     = Vector3Subtract(chest, eye);
+        float   dist  = Vector3Length(d);
+        if(dist < 0.01f) continue;
+        rays[n]    = { eye, Vector3Scale(d, 1.0f / dist), dist };
+        targets[n] = chest;
+        ids[n++]   = i;
+    }
+    HitResult hits[MAX_PACKET_RAYS];
+    RaycastSolidsPacket(rays, n, hits, world);
+    uint8_t visible = 0;
+    for(int r = 0; r < n; r++) {
+        if(hits[r].hit && hits[r].distance < rays[r].maxDist - 0.15f) continue;
+        if(RayBlockedBySmoke(eye, targets[r], world.smokeGrid)) continue;
+        visible |= (uint8_t)(1u << ids[r]);
+    }
+    return visible;
+}
+
+// Once per tick per client seat.
+inline void UpdateInterest(ClientInterest& ci, int seat, const World& world, float dt) {
+    const Pawn& self = world.pawns[seat];
+    for(float& h : ci.heldFor) h -= dt;
+
+    // What the client hears it may as well see
+    world.noises.ForEachSince(ci.noiseCursor, [&](const NoiseEvent& n) {
+        if(n.source < 0 || n.source == seat) return;
+        if(Vector3LengthSqr(Vector3Subtract(n.pos, self.xform.pos)) <= n.range * n.range)
+            ci.heldFor[n.source] = RELEVANCY_HOLD_SEC;
+    });
+
+    ci.timer -= dt;
+    if(ci.timer <= 0.0f) {
+        ci.timer += 1.0f / RELEVANCY_HZ;
+        uint8_t candidates = 0;
+        for(int i = 0; i < MAX_PAWNS; i++) {
+            const Pawn& p = world.pawns[i];
+            if(i == seat || !p.alive || p.team == self.team) continue;
+            float d2 = Vector3LengthSqr(Vector3Subtract(p.xform.pos, self.xform.pos));
+            if(d2 < RELEVANCY_NEAR * RELEVANCY_NEAR) ci.heldFor[i] = RELEVANCY_HOLD_SEC;
+            else if(d2 < RELEVANCY_FAR * RELEVANCY_FAR) candidates |= (uint8_t)(1u << i);
+        }
+        if(candidates && self.alive) {
+            Vector3 eye  = self.eyePos();
+            Vector3 lead = Vector3Add(eye, Vector3Scale(self.velocity, RELEVANCY_LEAD_SEC));
+            uint8_t seen = PawnsVisibleFrom(eye, candidates, world);
+            if(candidates & ~seen) seen |= PawnsVisibleFrom(lead, candidates & ~seen, world);
+            for(int i = 0; i < MAX_PAWNS; i++)
+                if(seen & (1u << i)) ci.heldFor[i] = RELEVANCY_HOLD_SEC;
+        }
+    }
+
+    ci.pawns = 0;
+    for(int i = 0; i < MAX_PAWNS; i++) {
+        const Pawn& p = world.pawns[i];
+        if(i == seat || !p.alive || p.team == self.team || ci.heldFor[i] > 0.0f)
+            ci.pawns |= (uint8_t)(1u << i);
+    }
+}
+
+inline bool NearClient(Vector3 pos, const Pawn& self, float radius) {
+    return Vector3LengthSqr(Vector3Subtract(pos, self.xform.pos)) < radius * radius;
+}
+
+inline bool GrenadeRelevant(const GrenadeEntity& g, const ClientInterest& ci, const Pawn& self) {
+    return (g.ownerID >= 0 && ci.Has(g.ownerID)) || NearClient(g.pos, self, RELEVANCY_FAR * 0.25f);
+}
+
+inline bool SmokeRelevant(const SmokeZone& s, const Pawn& self) {
+    return NearClient(s.pos, self, RELEVANCY_FAR);
+}
+
+inline bool TracerRelevant(const BulletTracer& t, const ClientInterest& ci, const Pawn& self) {
+    return (t.shooter >= 0 && ci.Has(t.shooter)) || NearClient(t.end, self, RELEVANCY_NEAR * 2.0f);
+}
@@ -0,0 +1,280 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  Snapshot.h  –  One tick of World as one client is allowed to see it
+//
+//  WriteSnapshot packs the round state, the client's own pawn in full and
+//  the pawns, grenades, smokes and tracers its ClientInterest lets through.
+//  Fields are quantised and written byte by byte, little-endian, so the
+//  format doesn't depend on struct layout:
+//
+//    header  16 B   tick, seat, round state/number, scores, round timer,
+//                   capture progress, entity counts
+//    self    25 B   exact position, velocity, hp, weapon, ammo, utility
+//    pawn    14 B   id/flags, position, yaw, pitch, hp, weapon
+//    grenade  7 B   type, position
+//    smoke    8 B   position, radius, time left
+//    tracer  13 B   shooter, origin, end
+//
+//  Positions are int16 at 1/SNAP_POS_SCALE m (±512 m); angles reuse the
+//  PlayerCommand quantisation.  ReadSnapshot decodes the same bytes.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../World.h"
+#include "../game/PlayerCommand.h"
+#include "Relevancy.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+constexpr float SNAP_POS_SCALE = 64.0f;    // steps per metre
+constexpr float SNAP_VEL_SCALE = 256.0f;   // steps per m/s
+constexpr int   SNAP_HEADER    = 16;
+constexpr int   SNAP_SELF      = 25;
+constexpr int   SNAP_PAWN      = 14;
+constexpr int   SNAP_GRENADE   = 7;
+constexpr int   SNAP_SMOKE     = 8;
+constexpr int   SNAP_TRACER    = 13;
+constexpr int   SNAPSHOT_MAX_BYTES = SNAP_HEADER + SNAP_SELF + SNAP_PAWN * (MAX_PAWNS - 1) +
+                                     SNAP_GRENADE * MAX_GRENADES + SNAP_SMOKE * MAX_SMOKES +
+                                     SNAP_TRACER * MAX_TRACERS;
+
+// Pawn record flags (high bits of the id byte)
+constexpr uint8_t SNAP_ALIVE  = 1 << 3;
+constexpr uint8_t SNAP_CROUCH = 1 << 4;
+constexpr uint8_t SNAP_DEFEND = 1 << 5;
+// Self record flags
+constexpr uint8_t SNAP_SELF_ALIVE     = 1 << 0;
+constexpr uint8_t SNAP_SELF_GROUND    = 1 << 1;
+constexpr uint8_t SNAP_SELF_CROUCH    = 1 << 2;
+constexpr uint8_t SNAP_SELF_ADS       = 1 << 3;
+constexpr uint8_t SNAP_SELF_RELOADING = 1 << 4;
+
+struct SnapshotPacket {
+    uint32_t tick = 0;
+    uint16_t size = 0;
+    uint8_t  bytes[SNAPSHOT_MAX_BYTES];
+};
+
+// ─── Decoded form ───────────────────────────────────────────────────────────
+struct SnapshotPawn {
+    uint8_t  id     = 0;
+    bool     alive  = false;
+    bool     crouch = false;
+    Team     team   = Team::NONE;
+    Vector3  pos    = {};
+    uint16_t yaw    = 0;
+    int16_t  pitch  = 0;
+    uint8_t  hp     = 0;
+    WeaponID weapon = WeaponID::PISTOL;
+};
+
+struct SnapshotSelf {
+    Vector3  pos      = {};
+    Vector3  velocity = {};
+    uint8_t  hp       = 0;
+    WeaponID weapon   = WeaponID::PISTOL;
+    uint8_t  ammoMag  = 0;
+    uint16_t ammoReserve = 0;
+    uint8_t  frags = 0, smokes = 0, stuns = 0;
+    uint8_t  flags = 0;   // SNAP_SELF_*
+};
+
+struct Snapshot {
+    uint32_t   tick        = 0;
+    uint8_t    seat        = 0;
+    RoundState roundState  = RoundState::WAITING;
+    uint8_t    roundNumber = 0;
+    uint8_t    scoreAttack = 0, scoreDefend = 0;
+    float      roundTimer  = 0.0f;
+    float      capture     = 0.0f;   // 0..1 of OBJECTIVE_CAPTURE_SEC
+    SnapshotSelf self;
+    int        pawnCount = 0, grenadeCount = 0, smokeCount = 0, tracerCount = 0;
+    SnapshotPawn pawns[MAX_PAWNS];
+    struct { UtilityID type; Vector3 pos; }                  grenades[MAX_GRENADES];
+    struct { Vector3 pos; float radius; float lifeLeft; }    smokes[MAX_SMOKES];
+    struct { int8_t shooter; Vector3 origin; Vector3 end; }  tracers[MAX_TRACERS];
+};
+
+// ─── Byte packing ───────────────────────────────────────────────────────────
+struct SnapWriter {
+    uint8_t* out;
+    int      size = 0;
+
+    void U8(uint32_t v)  { out[size++] = (uint8_t)v; }
+    void U16(uint32_t v) { U8(v); U8(v >> 8); }
+    void U32(uint32_t v) { U16(v); U16(v >> 16); }
+    void F32(float v)    { uint32_t u; memcpy(&u, &v, 4); U32(u); }
+    void Q16(float v, float scale) {
+        U16((uint16_t)(int16_t)std::clamp(lroundf(v * scale), -32767l, 32767l));
+    }
+    void Pos(Vector3 p) { Q16(p.x, SNAP_POS_SCALE); Q16(p.y, SNAP_POS_SCALE); Q16(p.z, SNAP_POS_SCALE); }
+};
+
+struct SnapReader {
+    const uint8_t* in;
+    int            size;
+    int            at = 0;
+    bool           ok = true;
+
+    uint32_t U8() {
+        if(at + 1 > size) { ok = false; return 0; }
+        return in[at++];
+    }
+    uint32_t U16() { uint32_t lo = U8(); return lo | (U8() << 8); }
+    uint32_t U32() { uint32_t lo = U16(); return lo | (U16() << 16); }
+    float    F32() { uint32_t u = U32(); float v; memcpy(&v, &u, 4); return v; }
+    float    Q16(float scale) { return (int16_t)U16() / scale; }
+    Vector3  Pos() {
+        float x = Q16(SNAP_POS_SCALE), y = Q16(SNAP_POS_SCALE);
+        return { x, y, Q16(SNAP_POS_SCALE) };
+    }
+};
+
+// ─── Encode ─────────────────────────────────────────────────────────────────
+// out must hold SNAPSHOT_MAX_BYTES; returns the bytes written.
+inline int WriteSnapshot(const World& world, uint32_t tick, int seat,
+                         const ClientInterest& ci, uint8_t* out) {
+    const Pawn& self = world.pawns[seat];
+    SnapWriter w{ out };
+
+    int pawns = 0, grenades = 0, smokes = 0, tracers = 0;
+    for(int i = 0; i < MAX_PAWNS; i++) pawns += i != seat && ci.Has(i);
+    for(const GrenadeEntity& g : world.grenades) grenades += !g.detonated && GrenadeRelevant(g, ci, self);
+    for(const SmokeZone& s : world.smokes)       smokes   += SmokeRelevant(s, self);
+    for(const BulletTracer& t : world.tracers)   tracers  += TracerRelevant(t, ci, self);
+    grenades = std::min(grenades, MAX_GRENADES);
+    smokes   = std::min(smokes, MAX_SMOKES);
+    tracers  = std::min(tracers, MAX_TRACERS);
+
+    // header
+    w.U32(tick);
+    w.U8(seat);
+    w.U8((uint8_t)world.roundState);
+    w.U8(std::min(world.roundNumber, 255));
+    w.U8(std::min(world.scoreAttack, 255));
+    w.U8(std::min(world.scoreDefend, 255));
+    w.U16((uint16_t)std::clamp(lroundf(world.roundTimer * 100.0f), 0l, 65535l));
+    w.U8((uint8_t)std::clamp(lroundf(world.objective.captureProgress / OBJECTIVE_CAPTURE_SEC * 255.0f), 0l, 255l));
+    w.U8(pawns);
+    w.U8(grenades);
+    w.U8(smokes);
+    w.U8(tracers);
+
+    // self
+    w.F32(self.xform.pos.x);
+    w.F32(self.xform.pos.y);
+    w.F32(self.xform.pos.z);
+    w.Q16(self.velocity.x, SNAP_VEL_SCALE);
+    w.Q16(self.velocity.y, SNAP_VEL_SCALE);
+    w.Q16(self.velocity.z, SNAP_VEL_SCALE);
+    w.U8(std::clamp(self.hp, 0, 255));
+    w.U8((uint8_t)self.weapon.id);
+    w.U8(std::clamp(self.weapon.ammoMag, 0, 255));
+    w.U16(std::clamp(self.weapon.ammoReserve, 0, 65535));
+    w.U8(std::min(self.fragCount, 3) | std::min(self.smokeCount, 3) << 2 | std::min(self.stunCount, 3) << 4);
+    w.U8((self.alive ? SNAP_SELF_ALIVE : 0) | (self.onGround ? SNAP_SELF_GROUND : 0) |
+         (self.isCrouching ? SNAP_SELF_CROUCH : 0) | (self.weapon.isADS ? SNAP_SELF_ADS : 0) |
+         (self.weapon.reloadTimer > 0.0f ? SNAP_SELF_RELOADING : 0));
+
+    for(int i = 0; i < MAX_PAWNS; i++) {
+        if(i == seat || !ci.Has(i)) continue;
+        const Pawn& p = world.pawns[i];
+        w.U8(i | (p.alive ? SNAP_ALIVE : 0) | (p.isCrouching ? SNAP_CROUCH : 0) |
+             (p.team == Team::DEFEND ? SNAP_DEFEND : 0));
+        w.Pos(p.xform.pos);
+        w.U16(QuantizeYaw(p.xform.yaw));
+        w.U16((uint16_t)QuantizePitch(p.xform.pitch));
+        w.U8(std::clamp(p.hp, 0, 255));
+        w.U8((uint8_t)p.weapon.id);
+    }
+    int n = 0;
+    for(const GrenadeEntity& g : world.grenades) {
+        if(n == grenades || g.detonated || !GrenadeRelevant(g, ci, self)) continue;
+        w.U8((uint8_t)g.type);
+        w.Pos(g.pos);
+        n++;
+    }
+    n = 0;
+    for(const SmokeZone& s : world.smokes) {
+        if(n == smokes || !SmokeRelevant(s, self)) continue;
+        w.Pos(s.pos);
+        w.U8((uint8_t)std::clamp(lroundf(s.radius * 16.0f), 0l, 255l));
+        w.U8((uint8_t)std::clamp(lroundf(s.lifeLeft * 4.0f), 0l, 255l));
+        n++;
+    }
+    n = 0;
+    for(const BulletTracer& t : world.tracers) {
+        if(n == tracers || !TracerRelevant(t, ci, self)) continue;
+        w.U8((uint8_t)t.shooter);
+        w.Pos(t.origin);
+        w.Pos(t.end);
+        n++;
+    }
+    return w.size;
+}
+
+// ─── Decode ─────────────────────────────────────────────────────────────────
+// False on a truncated packet or counts over the limits.
+inline bool ReadSnapshot(const uint8_t* in, int size, Snapshot& s) {
+    SnapReader r{ in, size };
+    s.tick        = r.U32();
+    s.seat        = r.U8();
+    s.roundState  = (RoundState)r.U8();
+    s.roundNumber = r.U8();
+    s.scoreAttack = r.U8();
+    s.scoreDefend = r.U8();
+    s.roundTimer  = r.U16() / 100.0f;
+    s.capture     = r.U8() / 255.0f;
+    s.pawnCount    = r.U8();
+    s.grenadeCount = r.U8();
+    s.smokeCount   = r.U8();
+    s.tracerCount  = r.U8();
+    if(s.seat >= MAX_PAWNS || s.pawnCount >= MAX_PAWNS || s.grenadeCount > MAX_GRENADES ||
+       s.smokeCount > MAX_SMOKES || s.tracerCount > MAX_TRACERS)
+        return false;
+
+    SnapshotSelf& me = s.self;
+    float x = r.F32(), y = r.F32();
+    me.pos = { x, y, r.F32() };
+    x = r.Q16(SNAP_VEL_SCALE); y = r.Q16(SNAP_VEL_SCALE);
+    me.velocity    = { x, y, r.Q16(SNAP_VEL_SCALE) };
+    me.hp          = r.U8();
+    me.weapon      = (WeaponID)std::min(r.U8(), (uint32_t)WeaponID::COUNT - 1);
+    me.ammoMag     = r.U8();
+    me.ammoReserve = r.U16();
+    uint32_t util  = r.U8();
+    me.frags  = util & 3;
+    me.smokes = (util >> 2) & 3;
+    me.stuns  = (util >> 4) & 3;
+    me.flags  = r.U8();
+
+    for(int i = 0; i < s.pawnCount; i++) {
+        SnapshotPawn& p = s.pawns[i];
+        uint32_t idf = r.U8();
+        p.id     = idf & 7;
+        p.alive  = idf & SNAP_ALIVE;
+        p.crouch = idf & SNAP_CROUCH;
+        p.team   = (idf & SNAP_DEFEND) ? Team::DEFEND : Team::ATTACK;
+        p.pos    = r.Pos();
+        p.yaw    = r.U16();
+        p.pitch  = (int16_t)r.U16();
+        p.hp     = r.U8();
+        p.weapon = (WeaponID)std::min(r.U8(), (uint32_t)WeaponID::COUNT - 1);
+        if(p.id >= MAX_PAWNS) return false;
+    }
+    for(int i = 0; i < s.grenadeCount; i++) {
+        s.grenades[i].type = (UtilityID)r.U8();
+        s.grenades[i].pos  = r.Pos();
+    }
+    for(int i = 0; i < s.smokeCount; i++) {
+        s.smokes[i].pos      = r.Pos();
+        s.smokes[i].radius   = r.U8() / 16.0f;
+        s.smokes[i].lifeLeft = r.U8() / 4.0f;
+    }
+    for(int i = 0; i < s.tracerCount; i++) {
+        s.tracers[i].shooter = (int8_t)r.U8();
+        s.tracers[i].origin  = r.Pos();
+        s.tracers[i].end     = r.Pos();
+    }
+    return r.ok && r.at == size;
+}
@@ -1,15 +1,15 @@
 #pragma once
 // ─────────────────────────────────────────────────────────────────────────────
-//  MenuSystem.h  –  Immediate mode UI for Main Menu, Pause menu, and Match Over
+//  MenuSystem.h  –  Immediate mode UI for Loading, Main Menu, Pause menu, and Match Over
 // ─────────────────────────────────────────────────────────────────────────────
 #include "../World.h"
 #include <raylib.h>
 
-enum class AppState { MAIN_MENU, PLAYING, PAUSED, MATCH_OVER };
+enum class AppState { LOADING, MAIN_MENU, PLAYING, PAUSED, MATCH_OVER };
 
 struct MenuSystem {
   // Shared state
-  AppState currentState = AppState::MAIN_MENU;
+  AppState currentState = AppState::MAIN_MENU;   // LOADING: waiting to start a match
   bool startMatchRequested = false;
   bool playAgainRequested = false;
 
@@ -38,6 +38,25 @@ struct MenuSystem {
     return clicked;
   }
 
+  // Draw the loading screen (map parse + bakes run on a worker meanwhile)
+  void DrawLoadingScreen(int sw, int sh, float progress, const char *stage) {
+    DrawRectangle(0, 0, sw, sh, {30, 30, 40, 255});
+
+    int titleW = MeasureText("TACTICAL LITE", 60);
+    DrawText("TACTICAL LITE", sw / 2 - titleW / 2, sh / 2 - 150, 60, WHITE);
+
+    int bw = 400, bh = 16;
+    int bx = sw / 2 - bw / 2;
+    int by = sh / 2;
+    DrawRectangle(bx, by, bw, bh, {50, 50, 60, 255});
+    DrawRectangle(bx, by, (int)(bw * progress), bh, {200, 200, 200, 255});
+    DrawRectangleLines(bx, by, bw, bh, {100, 100, 100, 255});
+
+    const char *label = TextFormat("%s  %d%%", stage, (int)(progress * 100.0f));
+    int labelW = MeasureText(label, 20);
+    DrawText(label, sw / 2 - labelW / 2, by + 30, 20, GRAY);
+  }
+
   // Draw the main menu
   void DrawMainMenu(int sw, int sh, bool &quitIntent) {
     playAgainRequested = false;
@@ -0,0 +1,81 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  ProfilerOverlay.h  –  F3 panel: frame time and input latency percentiles
+//
+//  Frame times are fed every frame whether the panel is shown or not; the
+//  percentiles are only worked out when it is drawn.  Latency lines appear
+//  once the LatencyProbe is enabled (--latency and friends).  Below them sit
+//  the FramePacer's rung and sensors and its last few decisions.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../RollingStats.h"
+#include "../game/LatencyProbe.h"
+#include "../render/FramePacer.h"
+#include <raylib.h>
+#include <cstdio>
+
+constexpr int PROFILER_FRAME_SAMPLES = 240;   // ~2–4 s of frames
+constexpr int PROFILER_LOG_LINES     = 4;
+constexpr int PROFILER_LOG_CHARS     = 160;   // "%6.1fs " plus a FramePacer decision
+
+struct ProfilerOverlay {
+    bool visible = false;
+    RollingStats<PROFILER_FRAME_SAMPLES> frameMs;
+
+    char log[PROFILER_LOG_LINES][PROFILER_LOG_CHARS] = {};
+    int  logHead = 0;
+
+    void AddFrame(float dt) { frameMs.Add(dt * 1000.0f); }
+
+    // Keeps the last PROFILER_LOG_LINES, stamped with the window clock.
+    void Log(const char* text) {
+        snprintf(log[logHead], sizeof(log[logHead]), "%6.1fs %s", GetTime(), text);
+        logHead = (logHead + 1) % PROFILER_LOG_LINES;
+    }
+
+    void Update() {
+        if(IsKeyPressed(KEY_F3)) visible = !visible;
+    }
+
+    void Draw(const LatencyProbe& probe, const FramePacer& pacer, int x, int y) const {
+        if(!visible) return;
+        constexpr int FONT = 16, LINE = 18;
+        int logLines = 0;
+        for(const auto& l : log) logLines += l[0] != 0;
+        int lines = 2 + logLines + (probe.Enabled() ? 3 : 0) + (probe.SelfTest() ? 1 : 0);
+        DrawRectangle(x - 6, y - 4, 520, lines * LINE + 8, {0, 0, 0, 150});
+
+        char buf[128];
+        snprintf(buf, sizeof(buf), "frame  p50 %.1f  p99 %.1f ms",
+                 frameMs.Percentile(0.50f), frameMs.Percentile(0.99f));
+        DrawText(buf, x, y, FONT, RAYWHITE);
+
+        const PaceLevel&      lv = pacer.Level();
+        const ThermalReading& th = pacer.Thermal();
+        snprintf(buf, sizeof(buf), "pace %d fps  x%.2f%s  work p95 %.1f ms  %.1f C  %d MHz%s",
+                 lv.fps, lv.renderScale, lv.reducedEffects ? " lowfx" : "", pacer.WorkP95Ms(),
+                 th.tempC, th.freqMHz, th.throttled ? "  THROTTLED" : "");
+        DrawText(buf, x, y += LINE, FONT, th.throttled ? RED : RAYWHITE);
+        for(int i = 0; i < PROFILER_LOG_LINES; i++) {
+            const char* l = log[(logHead + i) % PROFILER_LOG_LINES];
+            if(l[0]) DrawText(l, x, y += LINE, FONT, LIGHTGRAY);
+        }
+        if(!probe.Enabled()) return;
+
+        const auto& total = probe.Total();
+        snprintf(buf, sizeof(buf), "input->swap  p50 %.1f  p95 %.1f  p99 %.1f ms",
+                 total.Percentile(0.50f), total.Percentile(0.95f), total.Percentile(0.99f));
+        DrawText(buf, x, y += LINE, FONT, total.Count() ? RAYWHITE : GRAY);
+        snprintf(buf, sizeof(buf), "  to tick p50 %.1f   tick to swap p50 %.1f ms",
+                 probe.ToTick().Percentile(0.50f), probe.ToSwap().Percentile(0.50f));
+        DrawText(buf, x, y += LINE, FONT, LIGHTGRAY);
+        snprintf(buf, sizeof(buf), "  last %.1f ms over %d shots", total.Last(), total.Count());
+        DrawText(buf, x, y += LINE, FONT, LIGHTGRAY);
+
+        if(probe.SelfTest()) {
+            snprintf(buf, sizeof(buf), "self-test  on frame %d  late %d  missed %d",
+                     probe.SelfTestFirst(), probe.SelfTestLate(), probe.SelfTestMissed());
+            DrawText(buf, x, y += LINE, FONT,
+                     probe.SelfTestMissed() || probe.SelfTestLate() ? YELLOW : GREEN);
+        }
+    }
+};
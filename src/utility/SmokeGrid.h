@@ -0,0 +1,254 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  SmokeGrid.h  –  Voxel occupancy for smoke line-of-sight
+//
+//  Each smoke flood-fills the cells inside its radius at detonation.  The fill
+//  never enters a cell touched by a map solid, so smoke pools against walls
+//  instead of leaking through them.  Every slot owns a small grid covering
+//  just its sphere, so memory and build cost do not grow with the map and a
+//  streamed map can swap geometry under live smokes.
+//
+//  Line-of-sight tests clip the segment to each live smoke's stamped box and
+//  march only those spans with a 3D-DDA, exiting on the first smoky cell.
+//  With no smoke active the test is a single branch.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../Entity.h"
+#include "../game/SolidGrid.h"
+#include <raymath.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+constexpr float SMOKE_CELL       = 0.5f;   // metres per voxel edge (world-aligned)
+constexpr int   SMOKE_GRID_SLOTS = 8;      // concurrent smokes
+
+struct SmokeGrid {
+    // Cell-space box; cells are world-aligned, so x0 = floor(wx / SMOKE_CELL)
+    struct CellBox { int x0 = 0, y0 = 0, z0 = 0, x1 = -1, y1 = -1, z1 = -1; };
+
+    struct Slot {
+        CellBox              box;      // cells allocated around the sphere
+        CellBox              filled;   // tight box of smoky cells
+        BoundingBox          bounds;   // `filled` in world space
+        std::vector<uint8_t> cells;    // 1 = smoke; 2 = overlaps a solid
+        int sx() const { return box.x1 - box.x0 + 1; }
+        int sz() const { return box.z1 - box.z0 + 1; }
+        int Index(int x, int y, int z) const {
+            return ((y - box.y0) * sz() + (z - box.z0)) * sx() + (x - box.x0);
+        }
+        bool Contains(int x, int y, int z) const {
+            return x >= box.x0 && x <= box.x1 && y >= box.y0 && y <= box.y1 &&
+                   z >= box.z0 && z <= box.z1;
+        }
+    };
+    std::array<Slot, SMOKE_GRID_SLOTS> slots;
+    uint8_t              liveSlots = 0;
+    BoundingBox          liveBounds = {};      // union of live stamps (world)
+
+    std::vector<int>     fillQueue;            // reused BFS scratch
+
+    // ── Flood-fill a new smoke; returns its slot or -1 if none free ─────────
+    // Only solids near the sphere are rasterised, found through the grid.
+    int Stamp(Vector3 center, float radius,
+              const std::vector<MapSolid>& solids, const SolidGrid& grid) {
+        int slot = -1;
+        for(int i = 0; i < SMOKE_GRID_SLOTS; i++)
+            if(!(liveSlots & (1u << i))) { slot = i; break; }
+        if(slot < 0) return -1;
+        Slot& sl = slots[slot];
+
+        // Nothing below the ground plane; one spare cell around the sphere.
+        int reach = (int)ceilf(radius / SMOKE_CELL) + 1;
+        int cx = (int)floorf(center.x / SMOKE_CELL);
+        int cy = std::max(0, (int)floorf(center.y / SMOKE_CELL));
+        int cz = (int)floorf(center.z / SMOKE_CELL);
+        sl.box = { cx - reach, std::max(0, cy - reach), cz - reach,
+                   cx + reach, cy + reach,              cz + reach };
+        sl.cells.assign((size_t)sl.sx() * (sl.box.y1 - sl.box.y0 + 1) * sl.sz(), 0);
+
+        // Conservative: any strict overlap marks the cell, so walls thinner
+        // than a cell still seal it.  Floors ending at y = 0 mark nothing.
+        BoundingBox q = { { sl.box.x0 * SMOKE_CELL, sl.box.y0 * SMOKE_CELL, sl.box.z0 * SMOKE_CELL },
+                          { (sl.box.x1 + 1) * SMOKE_CELL, (sl.box.y1 + 1) * SMOKE_CELL,
+                            (sl.box.z1 + 1) * SMOKE_CELL } };
+        grid.ForEachCandidate(q, [&](int si) {
+            const BoundingBox& b = solids[si].bounds;
+            int x0 = std::max(sl.box.x0, (int)floorf(b.min.x / SMOKE_CELL));
+            int x1 = std::min(sl.box.x1, (int)ceilf (b.max.x / SMOKE_CELL) - 1);
+            int y0 = std::max(sl.box.y0, (int)floorf(b.min.y / SMOKE_CELL));
+            int y1 = std::min(sl.box.y1, (int)ceilf (b.max.y / SMOKE_CELL) - 1);
+            int z0 = std::max(sl.box.z0, (int)floorf(b.min.z / SMOKE_CELL));
+            int z1 = std::min(sl.box.z1, (int)ceilf (b.max.z / SMOKE_CELL) - 1);
+            for(int y = y0; y <= y1; y++)
+                for(int z = z0; z <= z1; z++)
+                    for(int x = x0; x <= x1; x++)
+                        sl.cells[sl.Index(x, y, z)] = 2;
+        });
+
+        // A grenade resting against a wall sits in a blocked cell; seed from
+        // the nearest open neighbour instead.
+        if(sl.cells[sl.Index(cx, cy, cz)]) {
+            bool found = false;
+            for(int r = 1; r <= 2 && !found; r++)
+                for(int dy = -r; dy <= r && !found; dy++)
+                    for(int dz = -r; dz <= r && !found; dz++)
+                        for(int dx = -r; dx <= r && !found; dx++) {
+                            int x = cx + dx, y = cy + dy, z = cz + dz;
+                            if(sl.Contains(x, y, z) && !sl.cells[sl.Index(x, y, z)]) {
+                                cx = x; cy = y; cz = z; found = true;
+                            }
+                        }
+            if(!found) return -1;
+        }
+
+        const float r2 = radius * radius;
+        CellBox st{ cx, cy, cz, cx, cy, cz };
+
+        fillQueue.clear();
+        fillQueue.push_back(sl.Index(cx, cy, cz));
+        sl.cells[fillQueue[0]] = 1;
+
+        static constexpr int DIRS[6][3] = {
+            {1,0,0}, {-1,0,0}, {0,1,0}, {0,-1,0}, {0,0,1}, {0,0,-1}
+        };
+        const int sx = sl.sx(), sz = sl.sz();
+        for(size_t head = 0; head < fillQueue.size(); head++) {
+            int idx = fillQueue[head];
+            int x = sl.box.x0 + idx % sx;
+            int z = sl.box.z0 + (idx / sx) % sz;
+            int y = sl.box.y0 + idx / (sx * sz);
+            for(auto& d : DIRS) {
+                int nxC = x + d[0], nyC = y + d[1], nzC = z + d[2];
+                if(!sl.Contains(nxC, nyC, nzC)) continue;
+                int n = sl.Index(nxC, nyC, nzC);
+                if(sl.cells[n]) continue;
+
+                float wx = (nxC + 0.5f) * SMOKE_CELL - center.x;
+                float wy = (nyC + 0.5f) * SMOKE_CELL - center.y;
+                float wz = (nzC + 0.5f) * SMOKE_CELL - center.z;
+                if(wx*wx + wy*wy + wz*wz > r2) continue;
+
+                sl.cells[n] = 1;
+                fillQueue.push_back(n);
+                st.x0 = std::min(st.x0, nxC); st.x1 = std::max(st.x1, nxC);
+                st.y0 = std::min(st.y0, nyC); st.y1 = std::max(st.y1, nyC);
+                st.z0 = std::min(st.z0, nzC); st.z1 = std::max(st.z1, nzC);
+            }
+        }
+
+        sl.filled = st;
+        sl.bounds = { { st.x0 * SMOKE_CELL, st.y0 * SMOKE_CELL, st.z0 * SMOKE_CELL },
+                      { (st.x1 + 1) * SMOKE_CELL, (st.y1 + 1) * SMOKE_CELL,
+                        (st.z1 + 1) * SMOKE_CELL } };
+        liveSlots |= (uint8_t)(1u << slot);
+        RefreshLiveBounds();
+        return slot;
+    }
+
+    // ── Remove one smoke (lifeLeft expired) ─────────────────────────────────
+    void Clear(int slot) {
+        if(slot < 0 || slot >= SMOKE_GRID_SLOTS || !(liveSlots & (1u << slot))) return;
+        slots[slot].filled = {};
+        liveSlots &= (uint8_t)~(1u << slot);
+        RefreshLiveBounds();
+    }
+
+    void ClearAll() {
+        for(int i = 0; i < SMOKE_GRID_SLOTS; i++) Clear(i);
+    }
+
+    // ── Does the segment from → to pass through any smoky cell? ─────────────
+    bool SegmentBlocked(Vector3 from, Vector3 to) const {
+        if(!liveSlots) return false;
+
+        const float o[3] = { from.x, from.y, from.z };
+        const float d[3] = { to.x - from.x, to.y - from.y, to.z - from.z };
+        float t0 = 0.0f, t1 = 1.0f;
+        if(!ClipSegment(o, d, liveBounds, t0, t1)) return false;
+
+        // March each smoke's own box so scattered smokes never turn a long
+        // sightline into a full-map walk.
+        for(int i = 0; i < SMOKE_GRID_SLOTS; i++) {
+            if(!(liveSlots & (1u << i))) continue;
+            float s0 = 0.0f, s1 = 1.0f;
+            if(!ClipSegment(o, d, slots[i].bounds, s0, s1)) continue;
+            if(March(o, d, s0, s1, slots[i])) return true;
+        }
+        return false;
+    }
+
+private:
+    // Slab test; narrows [t0, t1] (segment parameter) to the part inside box.
+    static bool ClipSegment(const float o[3], const float d[3],
+                            const BoundingBox& box, float& t0, float& t1) {
+        const float lo[3] = { box.min.x, box.min.y, box.min.z };
+        const float hi[3] = { box.max.x, box.max.y, box.max.z };
+        for(int a = 0; a < 3; a++) {
+            if(fabsf(d[a]) < 1e-8f) {
+                if(o[a] < lo[a] || o[a] > hi[a]) return false;
+                continue;
+            }
+            float inv = 1.0f / d[a];
+            float ta = (lo[a] - o[a]) * inv;
+            float tb = (hi[a] - o[a]) * inv;
+            if(ta > tb) std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+            if(t0 > t1) return false;
+        }
+        return true;
+    }
+
+    // 3D-DDA (Amanatides & Woo) over [t0, t1]; true on the first smoky cell.
+    static bool March(const float o[3], const float d[3], float t0, float t1,
+                      const Slot& sl) {
+        const int lo[3] = { sl.filled.x0, sl.filled.y0, sl.filled.z0 };
+        const int hi[3] = { sl.filled.x1, sl.filled.y1, sl.filled.z1 };
+        int   c[3], step[3];
+        float tMax[3], tDelta[3];
+        for(int a = 0; a < 3; a++) {
+            float g  = (o[a] + d[a] * t0) / SMOKE_CELL;
+            float gd = d[a] / SMOKE_CELL;
+            c[a] = std::clamp((int)floorf(g), lo[a], hi[a]);
+            if(gd > 0.0f) {
+                step[a]   = 1;
+                tDelta[a] = 1.0f / gd;
+                tMax[a]   = t0 + ((float)(c[a] + 1) - g) * tDelta[a];
+            } else if(gd < 0.0f) {
+                step[a]   = -1;
+                tDelta[a] = -1.0f / gd;
+                tMax[a]   = t0 + (g - (float)c[a]) * tDelta[a];
+            } else {
+                step[a]   = 0;
+                tDelta[a] = INFINITY;
+                tMax[a]   = INFINITY;
+            }
+        }
+
+        for(;;) {
+            if(sl.cells[sl.Index(c[0], c[1], c[2])] == 1) return true;
+            int a = (tMax[0] < tMax[1])
+                  ? (tMax[0] < tMax[2] ? 0 : 2)
+                  : (tMax[1] < tMax[2] ? 1 : 2);
+            if(tMax[a] > t1) return false;
+            c[a] += step[a];
+            if(c[a] < lo[a] || c[a] > hi[a]) return false;
+            tMax[a] += tDelta[a];
+        }
+    }
+
+    void RefreshLiveBounds() {
+        bool any = false;
+        for(int i = 0; i < SMOKE_GRID_SLOTS; i++) {
+            if(!(liveSlots & (1u << i))) continue;
+            const BoundingBox& b = slots[i].bounds;
+            if(!any) { liveBounds = b; any = true; }
+            else {
+                liveBounds.min = Vector3Min(liveBounds.min, b.min);
+                liveBounds.max = Vector3Max(liveBounds.max, b.max);
+            }
+        }
+    }
+};
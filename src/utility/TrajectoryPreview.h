@@ -0,0 +1,86 @@
+#pragma once
+// ─────────────────────────────────────────────────────────────────────────────
+//  TrajectoryPreview.h  –  Cached grenade arc shown while a utility key is held
+//
+//  Runs the same StepGrenade integrator, at the same SIM_DT step and with
+//  the same fuse countdown as the live grenades, so the arc shows exactly
+//  where the throw will bounce and where it goes off.  The path is cached and
+//  re-simulated only when the eye moves, the view turns past a threshold, or
+//  the map geometry changes (streaming or hot reload).
+//  Simulation is resumable and capped by a per-frame time budget: if a
+//  frame runs out, the partial arc is drawn and the rest continues next frame.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "../World.h"
+#include "../utility/UtilitySystem.h"
+#include "../weapons/WeaponSystem.h"
+#include <raymath.h>
+#include <array>
+#include <chrono>
+
+constexpr int    PREVIEW_MAX_POINTS   = 96;
+constexpr int    PREVIEW_STEPS_PER_PT = 3;        // record every 3rd SIM_DT step
+constexpr float  PREVIEW_MOVE_EPS     = 0.03f;    // metres of eye movement
+constexpr float  PREVIEW_LOOK_DOT     = 0.99995f; // ≈ 0.6° of view change
+constexpr double PREVIEW_BUDGET_SEC   = 0.00025;  // 0.25 ms per frame
+constexpr int    PREVIEW_CLOCK_EVERY  = 8;        // steps between clock reads
+
+struct TrajectoryPreview {
+    std::array<Vector3, PREVIEW_MAX_POINTS> points;
+    int           count    = 0;
+    bool          complete = false;   // reached fuse / rest / point cap
+    bool          active   = false;
+
+    GrenadeEntity sim      = {};
+    int           steps    = 0;
+    Vector3       cachedEye  = {};
+    Vector3       cachedLook = {};
+    UtilityID     cachedType = UtilityID::FRAG;
+    uint32_t      cachedGeometry = 0;
+
+    void Reset() { active = false; count = 0; complete = false; }
+
+    // ── Refresh the cache if the throw changed; advance within budget ───────
+    void Update(const Pawn& thrower, UtilityID type, const World& world) {
+        Vector3 eye  = thrower.eyePos();
+        Vector3 look = thrower.lookDir();
+        bool stale = !active || type != cachedType ||
+                     world.geometryVersion != cachedGeometry ||
+                     Vector3LengthSqr(Vector3Subtract(eye, cachedEye)) >
+                         PREVIEW_MOVE_EPS * PREVIEW_MOVE_EPS ||
+                     Vector3DotProduct(look, cachedLook) < PREVIEW_LOOK_DOT;
+        if(stale) {
+            active     = true;
+            complete   = false;
+            cachedEye  = eye;
+            cachedLook = look;
+            cachedType = type;
+            cachedGeometry = world.geometryVersion;
+            sim        = { type, eye, UtilityThrowVelocity(thrower),
+                           UtilityFuseSec(type), false, 0.0f, thrower.id };
+            steps      = 0;
+            points[0]  = eye;
+            count      = 1;
+        }
+        if(complete) return;
+
+        using Clock = std::chrono::steady_clock;
+        const auto deadline = Clock::now() +
+            std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(PREVIEW_BUDGET_SEC));
+
+        for(int n = 1; ; n++) {
+            // As UpdateUtility does it
+            sim.fuseTimer -= SIM_DT;
+            StepGrenade(sim, SIM_DT, world);
+            steps++;
+
+            bool atRest = sim.vel.x == 0.0f && sim.vel.y == 0.0f && sim.vel.z == 0.0f;
+            bool done   = sim.fuseTimer <= 0.0f || atRest;
+            if(steps % PREVIEW_STEPS_PER_PT == 0 || done)
+                points[count++] = sim.pos;
+            if(done || count >= PREVIEW_MAX_POINTS) { complete = true; return; }
+
+            if(n % PREVIEW_CLOCK_EVERY == 0 && Clock::now() >= deadline) return;
+        }
+    }
+};
@@ -4,165 +4,220 @@
 // ─────────────────────────────────────────────────────────────────────────────
 #include "../World.h"
 #include "../game/Physics.h"
+#include "../Tuning.h"
 #include <raymath.h>
 #include <cmath>
 #include <algorithm>
+#include <array>
 
 constexpr float GRENADE_BOUNCE = 0.45f;  // restitution
 constexpr float GRENADE_GRAVITY= -18.0f;
 constexpr float GRENADE_RADIUS = 0.10f;
 constexpr float GRENADE_STOP_SPEED = 0.35f;
+constexpr int   GRENADE_MAX_CONTACTS = 4;      // contacts resolved per step
+constexpr float GRENADE_CONTACT_SKIN = 0.001f; // gap left after a contact
+
+// ─── Grenade flight: continuous swept-sphere collision ───────────────────────
+// Resolves every contact along the step's path in time order, so no throw
+// speed can skip a thin wall.  Only solids in the grid cells swept by the
+// path are tested.  Reflection uses the exact contact normal; tangential
+// speed is damped harder on walls than on floors, as before.
+inline void StepGrenade(GrenadeEntity& g, float dt, const World& world) {
+    g.vel.y += GRENADE_GRAVITY * dt;
+
+    bool  landed    = false;   // touched an upward-facing surface this step
+    float remaining = dt;
+    for(int c = 0; c < GRENADE_MAX_CONTACTS && remaining > 0.0f; c++) {
+        Vector3 delta = Vector3Scale(g.vel, remaining);
+        float   bestT = 2.0f;
+        Vector3 bestN = {0, 1, 0};
+        float   friction = 1.0f;
+
+        // Ground plane at y = 0
+        if(delta.y < 0.0f) {
+            float t = (g.pos.y <= GRENADE_RADIUS) ? 0.0f
+                    : (GRENADE_RADIUS - g.pos.y) / delta.y;
+            if(t <= 1.0f) { bestT = t; bestN = {0, 1, 0}; friction = 0.80f; }
+        }
+
+        Vector3 end = Vector3Add(g.pos, delta);
+        BoundingBox sweptBox = {
+            { std::min(g.pos.x, end.x) - GRENADE_RADIUS,
+              std::min(g.pos.y, end.y) - GRENADE_RADIUS,
+              std::min(g.pos.z, end.z) - GRENADE_RADIUS },
+            { std::max(g.pos.x, end.x) + GRENADE_RADIUS,
+              std::max(g.pos.y, end.y) + GRENADE_RADIUS,
+              std::max(g.pos.z, end.z) + GRENADE_RADIUS }
+        };
+        world.solidGrid.ForEachCandidate(sweptBox, [&](int i) {
+            const BoundingBox& b = world.solids[i].bounds;
+            if(!CheckCollisionBoxes(sweptBox, b)) return;
+            float   t;
+            Vector3 n;
+            if(SweepSphereAABB(g.pos, delta, GRENADE_RADIUS, b, t, n) && t < bestT) {
+                bestT    = t;
+                bestN    = n;
+                friction = (fabsf(n.y) > 0.7f) ? 0.90f : 0.85f;
+            }
+        });
+
+        if(bestT > 1.0f) {
+            g.pos = end;
+            break;
+        }
+
+        // Advance to the contact, then reflect off the contact normal.
+        g.pos = Vector3Add(g.pos, Vector3Scale(delta, bestT));
+        g.pos = Vector3Add(g.pos, Vector3Scale(bestN, GRENADE_CONTACT_SKIN));
+        float vn = Vector3DotProduct(g.vel, bestN);
+        if(vn < 0.0f) {
+            Vector3 normalPart  = Vector3Scale(bestN, vn);
+            Vector3 tangentPart = Vector3Subtract(g.vel, normalPart);
+            g.vel = Vector3Subtract(Vector3Scale(tangentPart, friction),
+                                    Vector3Scale(normalPart, GRENADE_BOUNCE));
+        }
+        if(bestN.y > 0.7f) landed = true;
+        remaining *= (1.0f - bestT);
+    }
+
+    // Settle almost-stopped grenades on whatever they landed on to avoid jitter.
+    if(landed) {
+        float planarSpeed = sqrtf(g.vel.x * g.vel.x + g.vel.z * g.vel.z);
+        if(planarSpeed < GRENADE_STOP_SPEED && fabsf(g.vel.y) < 1.0f)
+            g.vel = {0, 0, 0};
+    }
+}
+
+// ─── Detonations ─────────────────────────────────────────────────────────────
+// Pawns are distance-culled first; the survivors' line-of-sight rays go out
+// as one packet, and effects are applied in pawn-id order.
+
+inline void DetonateFrag(const GrenadeEntity& g, World& world) {
+    Team ownerTeam = Team::NONE;
+    if(g.ownerID >= 0 && g.ownerID < MAX_PAWNS)
+        ownerTeam = world.pawns[g.ownerID].team;
+
+    std::array<RayQuery, MAX_PACKET_RAYS>  rays{};
+    std::array<int, MAX_PACKET_RAYS>       targets;
+    std::array<HitResult, MAX_PACKET_RAYS> hits;
+    int n = 0;
+    for(auto& pawn : world.pawns) {
+        if(!pawn.alive) continue;
+        if(!FRIENDLY_FIRE && ownerTeam != Team::NONE &&
+           pawn.team == ownerTeam && pawn.id != g.ownerID) {
+            continue;
+        }
+        Vector3 toPawn = Vector3Subtract(pawn.xform.pos, g.pos);
+        float d = Vector3Length(toPawn);
+        if(d > Tune().fragRadius) continue;
+        rays[n]    = { g.pos, Vector3Normalize(toPawn), d };
+        targets[n] = pawn.id;
+        n++;
+    }
+    RaycastSolidsPacket(rays.data(), n, hits.data(), world);
+
+    for(int r = 0; r < n; r++) {
+        // Line-of-sight for frag damage
+        float d = rays[r].maxDist;
+        bool blocked = hits[r].hit && hits[r].distance < d - 0.1f;
+        if(blocked) continue;
+
+        Pawn& pawn = world.pawns[targets[r]];
+        float falloff = 1.0f - (d / Tune().fragRadius);
+        int   dmg     = (int)(Tune().fragDamage * falloff);
+        pawn.hp = std::max(0, pawn.hp - dmg);
+        pawn.lastAttacker = g.ownerID;
+        if(pawn.hp <= 0) pawn.alive = false;
+        // Hit flash if player was hit
+        if(&pawn == &world.player())
+            world.hitIndicatorAlpha = 1.0f;
+    }
+}
+
+inline void DetonateStun(const GrenadeEntity& g, World& world) {
+    const float maxStunRange = Tune().fragRadius * 1.5f;
+
+    std::array<RayQuery, MAX_PACKET_RAYS>  rays{};
+    std::array<int, MAX_PACKET_RAYS>       targets;
+    std::array<HitResult, MAX_PACKET_RAYS> hits;
+    int n = 0;
+    for(auto& pawn : world.pawns) {
+        // world.stun is this screen's flash: other humans' eyes do not count
+        if(!pawn.alive || pawn.isBot || &pawn != &world.player()) continue;
+
+        Vector3 eye = pawn.eyePos();
+        Vector3 toFlash = Vector3Subtract(g.pos, eye);
+        float d = Vector3Length(toFlash);
+        if(d > maxStunRange || d < 0.01f) continue;
+        rays[n]    = { eye, Vector3Scale(toFlash, 1.0f / d), d };
+        targets[n] = pawn.id;
+        n++;
+    }
+    RaycastSolidsPacket(rays.data(), n, hits.data(), world);
+
+    for(int r = 0; r < n; r++) {
+        float d = rays[r].maxDist;
+        bool blocked = hits[r].hit && hits[r].distance < d - 0.1f;
+        if(blocked) continue;
+
+        const Pawn& pawn = world.pawns[targets[r]];
+        float facing = Vector3DotProduct(pawn.lookDir(), rays[r].direction);
+        float facingScale = 0.2f + 0.8f * std::max(0.0f, facing);
+        float distScale = 1.0f - (d / maxStunRange);
+        float stunScale = std::clamp(facingScale * distScale * 1.2f, 0.0f, 1.0f);
+        float stunTime = Tune().stunDurationSec * stunScale;
+
+        if(stunTime > world.stun.timeLeft) {
+            world.stun.timeLeft = stunTime;
+            world.stun.peak = std::max(0.2f, stunTime);
+        }
+    }
+}
 
 // ─── Per-frame update ─────────────────────────────────────────────────────────
 inline void UpdateUtility(World& world, float dt) {
 
     // ── Grenade flight ──────────────────────────────────────────────────────
-    for(auto& g : world.grenades) {
+    std::array<int, MAX_GRENADES> detonating;
+    int numDetonating = 0;
+    for(int gi = 0; gi < (int)world.grenades.size(); gi++) {
+        auto& g = world.grenades[gi];
         if(g.detonated) continue;
 
         g.fuseTimer -= dt;
-        float moveDist = Vector3Length(g.vel) * dt;
-        int subSteps = std::max(1, (int)ceilf(moveDist / 0.4f));
-        float stepDt = dt / (float)subSteps;
-
-        for(int step = 0; step < subSteps; step++) {
-            Vector3 prevPos = g.pos;
-
-            // Physics: sub-step integration avoids tunneling at high speed.
-            g.vel.y += GRENADE_GRAVITY * stepDt;
-            g.pos.x += g.vel.x * stepDt;
-            g.pos.y += g.vel.y * stepDt;
-            g.pos.z += g.vel.z * stepDt;
-
-            bool collided = false;
-
-            // Ground collision
-            if(g.pos.y < GRENADE_RADIUS) {
-                g.pos.y = GRENADE_RADIUS;
-                g.vel.y = -g.vel.y * GRENADE_BOUNCE;
-                g.vel.x *= 0.80f;
-                g.vel.z *= 0.80f;
-                collided = true;
-            }
+        StepGrenade(g, dt, world);
 
-            BoundingBox gBox = {
-                {g.pos.x - GRENADE_RADIUS, g.pos.y - GRENADE_RADIUS, g.pos.z - GRENADE_RADIUS},
-                {g.pos.x + GRENADE_RADIUS, g.pos.y + GRENADE_RADIUS, g.pos.z + GRENADE_RADIUS}
-            };
-
-            for(const auto& s : world.solids) {
-                if(!CheckCollisionBoxes(gBox, s.bounds)) continue;
-
-                float penLeft   = fabsf(gBox.max.x - s.bounds.min.x);
-                float penRight  = fabsf(s.bounds.max.x - gBox.min.x);
-                float penBack   = fabsf(gBox.max.z - s.bounds.min.z);
-                float penFront  = fabsf(s.bounds.max.z - gBox.min.z);
-                float penBottom = fabsf(gBox.max.y - s.bounds.min.y);
-                float penTop    = fabsf(s.bounds.max.y - gBox.min.y);
-
-                float minPenX = std::min(penLeft, penRight);
-                float minPenZ = std::min(penBack, penFront);
-                float minPenY = std::min(penBottom, penTop);
-
-                g.pos = prevPos;
-                if(minPenY <= minPenX && minPenY <= minPenZ) {
-                    g.vel.y = -g.vel.y * GRENADE_BOUNCE;
-                    g.vel.x *= 0.90f;
-                    g.vel.z *= 0.90f;
-                } else if(minPenX < minPenZ) {
-                    g.vel.x = -g.vel.x * GRENADE_BOUNCE;
-                    g.vel.z *= 0.85f;
-                } else {
-                    g.vel.z = -g.vel.z * GRENADE_BOUNCE;
-                    g.vel.x *= 0.85f;
-                }
-
-                collided = true;
-                break;
-            }
-
-            // Settle almost-stopped grenades on the floor to avoid jitter.
-            if(collided) {
-                float planarSpeed = sqrtf(g.vel.x * g.vel.x + g.vel.z * g.vel.z);
-                if(planarSpeed < GRENADE_STOP_SPEED && fabsf(g.vel.y) < 1.0f &&
-                   g.pos.y <= GRENADE_RADIUS + 0.02f) {
-                    g.vel = {0, 0, 0};
-                }
-            }
-        }
-
-        // Detonate on fuse expiry
-        if(g.fuseTimer <= 0) {
+        // Detonate on fuse expiry (resolved together below)
+        if(g.fuseTimer <= 0 && numDetonating < MAX_GRENADES) {
             g.detonated = true;
+            detonating[numDetonating++] = gi;
+        }
+    }
 
-            switch(g.type) {
-            // ── FRAG ─────────────────────────────────────────────────────
-            case UtilityID::FRAG: {
-                Team ownerTeam = Team::NONE;
-                if(g.ownerID >= 0 && g.ownerID < MAX_PAWNS)
-                    ownerTeam = world.pawns[g.ownerID].team;
-
-                for(auto& pawn : world.pawns) {
-                    if(!pawn.alive) continue;
-                    if(!FRIENDLY_FIRE && ownerTeam != Team::NONE &&
-                       pawn.team == ownerTeam && pawn.id != g.ownerID) {
-                        continue;
-                    }
-                    float d = Vector3Length(Vector3Subtract(pawn.xform.pos, g.pos));
-                    if(d > FRAG_RADIUS) continue;
-                    // Line-of-sight for frag damage
-                    HitResult hr = RaycastSolids(g.pos,
-                        Vector3Normalize(Vector3Subtract(pawn.xform.pos, g.pos)),
-                        d, world.solids);
-                    bool blocked = hr.hit && hr.distance < d - 0.1f;
-                    if(!blocked) {
-                        float falloff = 1.0f - (d / FRAG_RADIUS);
-                        int   dmg     = (int)(FRAG_DAMAGE * falloff);
-                        pawn.hp = std::max(0, pawn.hp - dmg);
-                        if(pawn.hp <= 0) pawn.alive = false;
-                        // Hit flash if player was hit
-                        if(&pawn == &world.player())
-                            world.hitIndicatorAlpha = 1.0f;
-                    }
-                }
-                break;
-            }
-            // ── SMOKE ────────────────────────────────────────────────────
-            case UtilityID::SMOKE: {
-                if((int)world.smokes.size() < MAX_SMOKES)
-                    world.smokes.push_back({ g.pos, SMOKE_RADIUS, SMOKE_DURATION_SEC });
-                break;
-            }
-            // ── STUN ─────────────────────────────────────────────────────
-            case UtilityID::STUN: {
-                for(auto& pawn : world.pawns) {
-                    if(!pawn.alive || pawn.isBot) continue;
-
-                    Vector3 eye = pawn.eyePos();
-                    Vector3 toFlash = Vector3Subtract(g.pos, eye);
-                    float d = Vector3Length(toFlash);
-                    float maxStunRange = FRAG_RADIUS * 1.5f;
-                    if(d > maxStunRange || d < 0.01f) continue;
-
-                    Vector3 dirToFlash = Vector3Scale(toFlash, 1.0f / d);
-                    HitResult hr = RaycastSolids(eye, dirToFlash, d, world.solids);
-                    bool blocked = hr.hit && hr.distance < d - 0.1f;
-                    if(blocked) continue;
-
-                    float facing = Vector3DotProduct(pawn.lookDir(), dirToFlash);
-                    float facingScale = 0.2f + 0.8f * std::max(0.0f, facing);
-                    float distScale = 1.0f - (d / maxStunRange);
-                    float stunScale = std::clamp(facingScale * distScale * 1.2f, 0.0f, 1.0f);
-                    float stunTime = STUN_DURATION_SEC * stunScale;
-
-                    if(stunTime > world.stun.timeLeft) {
-                        world.stun.timeLeft = stunTime;
-                        world.stun.peak = std::max(0.2f, stunTime);
-                    }
-                }
-                break;
-            }
+    // ── Detonations, in throw order ─────────────────────────────────────────
+    for(int k = 0; k < numDetonating; k++) {
+        const GrenadeEntity& g = world.grenades[detonating[k]];
+        switch(g.type) {
+        case UtilityID::FRAG:
+            DetonateFrag(g, world);
+            world.EmitSound(SoundID::FRAG_BLAST, g.pos);
+            break;
+        case UtilityID::STUN:
+            DetonateStun(g, world);
+            world.EmitSound(SoundID::STUN_BANG, g.pos);
+            break;
+        case UtilityID::SMOKE: {
+            world.EmitSound(SoundID::SMOKE_POP, g.pos);
+            if((int)world.smokes.size() < MAX_SMOKES) {
+                // No slot means no open cell near a grenade wedged in a
+                // solid: a smoke that blocks no sightline must not be drawn.
+                int slot = world.smokeGrid.Stamp(g.pos, Tune().smokeRadius,
+                                                     world.solids, world.solidGrid);
+                if(slot >= 0)
+                    world.smokes.push_back({ g.pos, Tune().smokeRadius, Tune().smokeDurationSec, slot });
             }
+            break;
+        }
         }
     }
 
@@ -174,7 +229,10 @@ inline void UpdateUtility(World& world, float dt) {
     );
 
     // ── Smoke decay ──────────────────────────────────────────────────────────
-    for(auto& s : world.smokes) s.lifeLeft -= dt;
+    for(auto& s : world.smokes) {
+        s.lifeLeft -= dt;
+        if(s.lifeLeft <= 0) world.smokeGrid.Clear(s.gridSlot);
+    }
     world.smokes.erase(
         std::remove_if(world.smokes.begin(), world.smokes.end(),
             [](const SmokeZone& s){ return s.lifeLeft <= 0; }),
@@ -185,7 +243,7 @@ inline void UpdateUtility(World& world, float dt) {
     if(world.stun.timeLeft > 0) {
         world.stun.timeLeft = std::max(0.0f, world.stun.timeLeft - dt);
         if(world.stun.timeLeft <= 0.0f)
-            world.stun.peak = STUN_DURATION_SEC;
+            world.stun.peak = Tune().stunDurationSec;
     }
 
     // ── Hit indicator decay ───────────────────────────────────────────────────
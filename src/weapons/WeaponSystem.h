@@ -4,7 +4,7 @@
 // ─────────────────────────────────────────────────────────────────────────────
 #include "../World.h"
 #include "../game/Physics.h"
-#include "../audio/AudioSystem.h"
+#include "../Tuning.h"
 
 struct AudioSystem;
 #include <algorithm>
@@ -14,7 +14,7 @@ struct AudioSystem;
 
 // ─── Recoil & Spread ─────────────────────────────────────────────────────────
 inline Vector3 ApplySpread(Vector3 dir, float inaccuracyRad,
-    int shotsFired, WeaponID weaponId, float speed) {
+    int shotsFired, WeaponID weaponId, float speed, SimRandom& rng) {
     const bool isShotgun = (weaponId == WeaponID::SHOTGUN);
     const bool lowSpeed = (speed < 0.25f);
 
@@ -25,10 +25,10 @@ inline Vector3 ApplySpread(Vector3 dir, float inaccuracyRad,
         if (Vector3Length(right) < 0.01f) right = { 1, 0, 0 };
         Vector3 up2 = Vector3CrossProduct(right, dir);
 
-        float theta = ((float)rand() / RAND_MAX) * 2.0f * PI;
-        float phi = ((float)rand() / RAND_MAX) * inaccuracyRad;
-        Vector3 offset = Vector3Add(Vector3Scale(right, cosf(theta) * sinf(phi)),
-            Vector3Scale(up2, sinf(theta) * sinf(phi)));
+        float theta = rng.Float() * 2.0f * PI;
+        float phi = rng.Float() * inaccuracyRad;
+        Vector3 offset = Vector3Add(Vector3Scale(right, SimCos(theta) * SimSin(phi)),
+            Vector3Scale(up2, SimSin(theta) * SimSin(phi)));
         return Vector3Normalize(Vector3Add(dir, offset));
     }
 
@@ -98,7 +98,7 @@ inline Vector3 ApplySpread(Vector3 dir, float inaccuracyRad,
     case WeaponID::SHOTGUN:
     default:
         patternPitch = step * 0.008f;
-        patternYaw = sinf(step * 0.5f) * 0.008f;
+        patternYaw = SimSin(step * 0.5f) * 0.008f;
         break;
     }
 
@@ -124,12 +124,12 @@ inline Vector3 ApplySpread(Vector3 dir, float inaccuracyRad,
         return patternDir;
     }
 
-        float theta = ((float)rand() / RAND_MAX) * 2.0f * PI;
-        float phi = ((float)rand() / RAND_MAX) * tinySpread;
+        float theta = rng.Float() * 2.0f * PI;
+        float phi = rng.Float() * tinySpread;
 
         Vector3 randOffset = Vector3Add(
-            Vector3Scale(right, cosf(theta) * sinf(phi)),
-            Vector3Scale(up2, sinf(theta) * sinf(phi)));
+            Vector3Scale(right, SimCos(theta) * SimSin(phi)),
+            Vector3Scale(up2, SimSin(theta) * SimSin(phi)));
 
         return Vector3Normalize(Vector3Add(patternDir, randOffset));
 }
@@ -153,7 +153,7 @@ inline float ComputeShotInaccuracy(const Pawn& shooter, bool isADS) {
         inaccuracy += 0.50f;
     }
     else if (speed > 1.0f) {
-        inaccuracy += (speed / PLAYER_SPEED) * 0.22f;
+        inaccuracy += (speed / Tune().playerSpeed) * 0.22f;
     }
     else if (shooter.isCrouching) {
         inaccuracy *= 0.2f;
@@ -211,12 +211,11 @@ inline ShotResult FireRay(Vector3 origin, Vector3 direction, float maxRange,
 }
 
 // ─── Full weapon fire (handles pellets, spread, cooldown, ammo) ───────────────
-inline void WeaponFire(Pawn& shooter, World& world, bool isADS,
-    AudioSystem* audio = nullptr) {
+inline void WeaponFire(Pawn& shooter, World& world, bool isADS) {
     WeaponState& ws = shooter.weapon;
     if (!ws.canFire()) return;
 
-    if (audio) audio->PlayShoot(ws.id);
+    world.EmitSound(ShotSound(ws.id), shooter.eyePos(), shooter.id);
 
     const WeaponStats& st = ws.stats();
     ws.ammoMag--;
@@ -235,13 +234,14 @@ inline void WeaponFire(Pawn& shooter, World& world, bool isADS,
 
     for (int p = 0; p < st.pellets; p++) {
         // Pass shotsFired for predictable spray mapping
-        Vector3 dir = ApplySpread(look, inaccuracy, ws.shotsFired - 1, ws.id, speed);
+        Vector3 dir = ApplySpread(look, inaccuracy, ws.shotsFired - 1, ws.id, speed, world.rng);
         ShotResult sr = FireRay(eye, dir, st.range, shooter.id, shooter.team, world);
 
         // Register hit
         if (sr.hitPawn) {
             Pawn& target = world.pawns[sr.hitPawnID];
             target.hp = std::max(0, target.hp - st.damage);
+            target.lastAttacker = shooter.id;
             if (target.hp <= 0) target.alive = false;
 
             // Hit flash for player
@@ -249,15 +249,15 @@ inline void WeaponFire(Pawn& shooter, World& world, bool isADS,
                 world.hitIndicatorAlpha = 1.0f;
         }
         else if (sr.hitGeom) {
-            if ((int)world.impacts.size() < MAX_IMPACTS)
+            if ((int)world.impacts.size() < world.maxImpacts)
                 world.impacts.push_back({ sr.endPoint, 3.0f });
         }
 
         // Bullet tracer visually starts from the gun tip, but mechanically fires from the eye
-        if ((int)world.tracers.size() < MAX_TRACERS) {
+        if ((int)world.tracers.size() < world.maxTracers) {
             Color tc = (shooter.id == world.playerID) ? Color{ 255, 240, 160, 220 }
             : Color{ 255, 140, 100, 200 };
-            world.tracers.push_back({ shooter.gunTip(), sr.endPoint, 0.06f, tc });
+            world.tracers.push_back({ shooter.gunTip(), sr.endPoint, 0.06f, tc, (int8_t)shooter.id });
         }
     }
 
@@ -291,6 +291,22 @@ inline void WeaponTick(WeaponState& ws, float dt) {
 }
 
 // ─── Throw utility ─────────────────────────────────────────────────────────────
+inline float UtilityFuseSec(UtilityID type) {
+    return (type == UtilityID::FRAG) ? Tune().fragFuseSec : 0.8f;
+}
+
+inline Vector3 UtilityThrowVelocity(const Pawn& thrower) {
+    Vector3 vel = Vector3Scale(thrower.lookDir(), 12.0f);
+    vel.y += 4.0f; // arc upward
+    return vel;
+}
+
+inline int UtilityCount(const Pawn& p, UtilityID type) {
+    return (type == UtilityID::FRAG) ? p.fragCount
+        : (type == UtilityID::SMOKE) ? p.smokeCount
+        : p.stunCount;
+}
+
 inline bool ThrowUtility(Pawn& thrower, UtilityID type, World& world) {
     int& count = (type == UtilityID::FRAG) ? thrower.fragCount
         : (type == UtilityID::SMOKE) ? thrower.smokeCount
@@ -298,10 +314,7 @@ inline bool ThrowUtility(Pawn& thrower, UtilityID type, World& world) {
     if (count <= 0 || (int)world.grenades.size() >= MAX_GRENADES) return false;
     count--;
 
-    float   fuse = (type == UtilityID::FRAG) ? FRAG_FUSE_SEC : 0.8f;
-    Vector3 vel = Vector3Scale(thrower.lookDir(), 12.0f);
-    vel.y += 4.0f; // arc upward
-
-    world.grenades.push_back({ type, thrower.eyePos(), vel, fuse, false, 0.0f, thrower.id });
+    world.grenades.push_back({ type, thrower.eyePos(), UtilityThrowVelocity(thrower),
+                               UtilityFuseSec(type), false, 0.0f, thrower.id });
     return true;
-}
\ No newline at end of file
+}
@@ -0,0 +1,256 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  lockstepsoak  –  Lockstep peers over simulated bad links, checked for sync
+//
+//  Runs --peers Worlds in one process, each with its own LockstepSession,
+//  in simulated time at SIM_TICK_HZ.  Each ordered pair of peers talks
+//  through its own LinkSimulator.  Every peer plays its own seat with
+//  wandering random input (move, turn, fire, the odd grenade); the other
+//  seats are bots simulated on every peer.  After the match the input
+//  stops, the peers drain to the same tick, and their WorldHashes are
+//  compared.
+//
+//  --desync-at T nudges one pawn on the last peer at tick T; the run then
+//  passes only if the hash exchange reports it within LOCKSTEP_HASH_EVERY
+//  ticks.  --mismatch starts the last peer with another seed; the run
+//  then passes only if every peer refuses to start and runs no tick.
+//
+//  Usage: lockstepsoak [--peers N] [--loss PCT] [--latency MS] [--jitter MS]
+//                      [--duplicate PCT] [--seconds S] [--seed N]
+//                      [--desync-at TICK] [--mismatch] file.map
+//  Exit status: 0 in sync (or the injected desync or mismatch was caught),
+//  1 out of sync or a desync or mismatch missed, 2 usage / unreadable map.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "Tuning.h"
+#include "World.h"
+#include "game/MapLoader.h"
+#include "game/MapOptimizer.h"
+#include "game/Physics.h"
+#include "game/PlayerCommand.h"
+#include "game/RoundManager.h"
+#include "game/WorldHash.h"
+#include "net/LinkSimulator.h"
+#include "net/Lockstep.h"
+#include <raylib.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+constexpr double SOAK_DRAIN_SEC = 10.0;   // after the input stops, for the last commands
+constexpr int    SOAK_MAX_SLOWDOWN = 4;   // give up once stalls stretch the match this much
+
+// Wandering input for one seat: a new move and turn rate every half second
+struct SoakInput {
+    SimRandom rng;
+    float     yaw = 0.0f, pitch = 0.0f, turn = 0.0f;
+    int8_t    forward = 0, side = 0;
+    uint16_t  held = 0;
+
+    PlayerCommand Next(uint32_t tick) {
+        if(tick % (SIM_TICK_HZ / 2) == 0) {
+            forward = (int8_t)((int)rng.Below(3) * 127 - 127);
+            side    = (int8_t)((int)rng.Below(3) * 127 - 127);
+            turn    = (rng.Float() - 0.5f) * 4.0f;
+            held    = 0;
+            if(rng.Below(3) == 0) held |= CMD_FIRE;
+            if(rng.Below(8) == 0) held |= CMD_CROUCH;
+            if(rng.Below(8) == 0) held |= CMD_JUMP;
+            if(rng.Below(20) == 0) held |= (uint16_t)(CMD_FRAG << rng.Below(3));
+        }
+        yaw  += turn * SIM_DT;
+        pitch = std::clamp(pitch + (rng.Float() - 0.5f) * 0.02f, -0.5f, 0.5f);
+        PlayerCommand cmd;
+        cmd.buttons = held;
+        cmd.yaw     = QuantizeYaw(yaw);
+        cmd.pitch   = QuantizePitch(pitch);
+        cmd.forward = forward;
+        cmd.side    = side;
+        return cmd;
+    }
+};
+
+struct SoakPeer {
+    World           world;
+    MapData         md;
+    LockstepSession session;
+    SoakInput       input;
+    uint32_t        submitted     = 0;   // local commands, one per frame unless stalled
+    uint64_t        stalledFrames = 0;
+};
+
+static void PrintLink(const char* name, const LinkStats& s) {
+    printf("  link %s: %llu sent, %llu dropped, %llu duplicated, %llu reordered\n", name,
+           (unsigned long long)s.sent, (unsigned long long)s.dropped,
+           (unsigned long long)s.duplicated, (unsigned long long)s.reordered);
+}
+
+int main(int argc, char** argv) {
+    SetTraceLogLevel(LOG_WARNING);
+
+    LinkConfig  link;
+    int         peerCount = 2;
+    double      seconds   = 60.0;
+    uint64_t    seed      = 1;
+    long        desyncAt  = -1;
+    bool        mismatch  = false;
+    const char* path      = nullptr;
+    for(int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if     (!strcmp(argv[i], "--peers")     && more) peerCount = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--loss")      && more) link.lossPct      = (float)atof(argv[++i]);
+        else if(!strcmp(argv[i], "--latency")   && more) link.latencyMs    = (float)atof(argv[++i]);
+        else if(!strcmp(argv[i], "--jitter")    && more) link.jitterMs     = (float)atof(argv[++i]);
+        else if(!strcmp(argv[i], "--duplicate") && more) link.duplicatePct = (float)atof(argv[++i]);
+        else if(!strcmp(argv[i], "--seconds")   && more) seconds  = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--seed")      && more) seed     = strtoull(argv[++i], nullptr, 10);
+        else if(!strcmp(argv[i], "--desync-at") && more) desyncAt = atol(argv[++i]);
+        else if(!strcmp(argv[i], "--mismatch"))          mismatch = true;
+        else if(argv[i][0] != '-')                       path     = argv[i];
+        else { path = nullptr; break; }
+    }
+    if(!path || seconds <= 0.0 || peerCount < 2 || peerCount > MAX_PAWNS) {
+        fprintf(stderr, "usage: %s [--peers N (2-%d)] [--loss PCT] [--latency MS] [--jitter MS] "
+                        "[--duplicate PCT] [--seconds S] [--seed N] [--desync-at TICK] [--mismatch] file.map\n",
+                argv[0], MAX_PAWNS);
+        return 2;
+    }
+
+    LoadTuning(TUNING_FILE);
+    const uint8_t seats = (uint8_t)((1u << peerCount) - 1);
+
+    // Sessions hold a NetChannel per seat: keep the peers on the heap
+    std::vector<std::unique_ptr<SoakPeer>> peers;
+    for(int p = 0; p < peerCount; p++) {
+        auto peer = std::make_unique<SoakPeer>();
+        World& world = peer->world;
+        try {
+            peer->md = LoadMap(path, world);
+        } catch(std::exception& e) {
+            fprintf(stderr, "%s: error: %s\n", path, e.what());
+            return 2;
+        }
+        if(peer->md.sectors) {
+            fprintf(stderr, "%s: error: streamed maps (over %d solids) are not played in lockstep\n", path, MAX_SOLIDS);
+            return 2;
+        }
+        OptimizeSolids(world.solids, path);
+        BuildMapAccel(world);
+        world.humanSeats = seats;
+        world.playerID   = p;
+        world.maxTracers = world.maxImpacts = 0;
+        uint64_t peerSeed = (mismatch && p == peerCount - 1) ? seed + 1 : seed;
+        StartLockstepMatch(world, peer->md, peerSeed);
+        peer->session.Start(p, seats, world, peerSeed, path);
+        peer->input.rng.Seed(seed * 131 + p);
+        peer->input.yaw = world.pawns[p].xform.yaw;
+        peers.push_back(std::move(peer));
+    }
+
+    // links[from * MAX_PAWNS + to]
+    std::vector<std::unique_ptr<LinkSimulator>> links(MAX_PAWNS * MAX_PAWNS);
+    for(int a = 0; a < peerCount; a++)
+        for(int b = 0; b < peerCount; b++)
+            if(a != b) links[a * MAX_PAWNS + b] = std::make_unique<LinkSimulator>(link, seed * 64 + a * 8 + b);
+
+    const uint32_t inputTicks = (uint32_t)(seconds * SIM_TICK_HZ);
+    const uint32_t endTick    = inputTicks * SOAK_MAX_SLOWDOWN + (uint32_t)(SOAK_DRAIN_SEC * SIM_TICK_HZ);
+    uint32_t frame = 0;
+    bool     injected = false;
+    uint8_t  packet[NET_MTU];
+    for(; frame < endTick; frame++) {
+        double now = (double)frame / SIM_TICK_HZ;
+        for(int p = 0; p < peerCount; p++) {
+            SoakPeer& peer = *peers[p];
+            for(int from = 0; from < peerCount; from++) {
+                if(from == p) continue;
+                LinkSimulator& l = *links[from * MAX_PAWNS + p];
+                while(int n = l.Receive(now, packet)) peer.session.Receive(now, from, packet, n);
+            }
+            // Input waits while the session is stalled, as in the game
+            bool typing = peer.submitted < inputTicks;
+            if(typing && peer.session.CanSubmit()) {
+                peer.session.SubmitLocal(peer.input.Next(peer.submitted));
+                peer.submitted++;
+            } else if(typing) {
+                peer.stalledFrames++;
+            }
+
+            while(peer.session.Ready()) {
+                if(p == peerCount - 1 && !injected && (long)peer.session.Tick() == desyncAt) {
+                    peer.world.pawns[0].xform.pos.x += 0.001f;
+                    injected = true;
+                }
+                peer.session.Step(peer.world, peer.md);
+            }
+            peer.session.Flush(now, [&](int to, const uint8_t* d, int n) {
+                links[p * MAX_PAWNS + to]->Send(now, d, n);
+            });
+        }
+        bool drained = true;
+        for(int p = 0; p < peerCount && drained; p++)
+            drained = peers[p]->submitted == inputTicks &&
+                      peers[p]->session.Tick() == peers[p]->session.InputTick();
+        bool refused = true;
+        for(int p = 0; p < peerCount && refused; p++) refused = peers[p]->session.Refused();
+        if(drained || (mismatch && refused)) break;
+    }
+
+    printf("lockstepsoak: %s, %d peers, loss %.1f%%, latency %.0f ms, jitter %.0f ms, duplicate %.1f%%\n",
+           path, peerCount, link.lossPct, link.latencyMs, link.jitterMs, link.duplicatePct);
+    const World& w0 = peers[0]->world;
+    double wallSec = frame / (double)SIM_TICK_HZ;
+    printf("  match: %.1f s of input took %.1f s, round %d, score %d-%d\n", inputTicks / (double)SIM_TICK_HZ,
+           wallSec, w0.roundNumber, w0.scoreAttack, w0.scoreDefend);
+    for(int a = 0; a < peerCount; a++)
+        for(int b = 0; b < peerCount; b++)
+            if(a != b) {
+                char name[8];
+                snprintf(name, sizeof(name), "%d->%d", a, b);
+                PrintLink(name, links[a * MAX_PAWNS + b]->Stats());
+            }
+
+    bool     inSync  = true;
+    uint64_t hash0   = WorldHash(w0);
+    bool     caught  = false;
+    for(int p = 0; p < peerCount; p++) {
+        SoakPeer&            peer = *peers[p];
+        const LockstepStats& st   = peer.session.Stats();
+        uint64_t hash  = WorldHash(peer.world);
+        uint64_t bytes = 0;
+        for(int s = 0; s < peerCount; s++)
+            if(s != p) bytes += peer.session.ChannelStats(s).bytesSent;
+        inSync &= hash == hash0 && peer.session.Tick() == peers[0]->session.Tick();
+        uint64_t frames = peer.submitted + peer.stalledFrames;
+        printf("  peer %d: tick %u, hash %016llx, %llu hashes compared, stalled %llu of %llu frames (%.1f%%), "
+               "%.1f commands per packet, up %.0f B/s",
+               p, peer.session.Tick(), (unsigned long long)hash, (unsigned long long)st.hashesCompared,
+               (unsigned long long)peer.stalledFrames, (unsigned long long)frames,
+               frames ? peer.stalledFrames * 100.0 / frames : 0.0,
+               (double)st.commandsSent / std::max<uint64_t>(1, (peerCount - 1) * (uint64_t)frame),
+               bytes / wallSec);
+        if(peer.session.Refused()) printf(", refused seat %d's hello", peer.session.RefusedSeat());
+        if(peer.session.Desynced()) {
+            printf(", desync at tick %u with seat %d", peer.session.DesyncTick(), peer.session.DesyncSeat());
+            caught |= desyncAt >= 0 && peer.session.DesyncTick() >= (uint32_t)desyncAt &&
+                      peer.session.DesyncTick() <= (uint32_t)desyncAt + LOCKSTEP_HASH_EVERY;
+        }
+        printf("\n");
+    }
+
+    if(mismatch) {
+        bool stopped = true;
+        for(auto& peer : peers) stopped &= peer->session.Refused() && peer->session.Tick() == 0;
+        printf("lockstepsoak: mismatched seed %s\n", stopped ? "refused" : "MISSED");
+        return stopped ? 0 : 1;
+    }
+    if(desyncAt >= 0) {
+        printf("lockstepsoak: injected desync at tick %ld %s\n", desyncAt, caught ? "caught" : "MISSED");
+        return caught ? 0 : 1;
+    }
+    bool reported = false;
+    for(auto& peer : peers) reported |= peer->session.Desynced();
+    printf("lockstepsoak: %s\n", inSync && !reported ? "in sync" : "OUT OF SYNC");
+    return inSync && !reported ? 0 : 1;
+}
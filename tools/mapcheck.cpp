@@ -0,0 +1,225 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  mapcheck  –  Headless lint for .map files
+//
+//  Loads each map through the same MapLoader / MapOptimizer / Physics code the
+//  game uses and reports, compiler-style (file:line: level: message):
+//    • parse diagnostics from LoadMap
+//    • spawns that SpawnCollides with the geometry (error if ResolveSafeSpawn
+//      cannot find a free spot either)
+//    • waypoint graph components not reachable from waypoint 0
+//    • EDGEs whose straight line passes through a solid (warning: bots slide
+//      along the blocker, but may stall on it)
+//    • solid count against MAX_SOLIDS (streamed or not)
+//    • estimated per-frame bot raycast cost
+//  Never opens a window, so it runs in CI.  Exit status: 0 clean (warnings
+//  allowed), 1 errors found, 2 usage / unreadable file.
+//
+//  Usage: mapcheck [--werror] file.map [file.map ...]
+// ─────────────────────────────────────────────────────────────────────────────
+#include "World.h"
+#include "game/MapLoader.h"
+#include "game/MapOptimizer.h"
+#include "game/Physics.h"
+#include "game/RoundManager.h"
+#include <raylib.h>
+#include <raymath.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+constexpr float EDGE_CHECK_HEIGHT  = 0.5f;   // above the waypoints, clears floor lips
+constexpr int   COST_SAMPLE_RAYS   = 20000;
+constexpr int   BOTS_PER_MATCH     = MAX_PAWNS - 1;   // one seat is the player
+
+struct Report {
+    std::string file;
+    int errors   = 0;
+    int warnings = 0;
+
+    void Emit(int line, bool error, const std::string& msg) {
+        if(line > 0) printf("%s:%d: %s: %s\n", file.c_str(), line, error ? "error" : "warning", msg.c_str());
+        else         printf("%s: %s: %s\n",    file.c_str(),       error ? "error" : "warning", msg.c_str());
+        (error ? errors : warnings)++;
+    }
+};
+
+// Every solid in the file; streamed maps only keep globals in world.solids.
+static std::vector<MapSolid> AllSolids(const World& world, const MapData& md) {
+    if(!md.sectors) return world.solids;
+    std::vector<MapSolid> all = md.sectors->globals;
+    std::ifstream f(md.sectors->path);
+    for(const auto& sec : md.sectors->sectors) {
+        if(sec.lines.empty()) continue;
+        std::vector<MapSolid> s = ReadSectorSolids(f, sec);
+        all.insert(all.end(), s.begin(), s.end());
+    }
+    return all;
+}
+
+// ─── Spawns ──────────────────────────────────────────────────────────────────
+static void CheckSpawns(Report& rep, const MapData& md, const std::vector<MapSolid>& solids) {
+    char msg[160];
+    Pawn probe;
+    for(const SpawnPoint& sp : md.spawns) {
+        // Same lift RoundManager applies before placing a pawn, plus a hair:
+        // resting exactly on a floor top is standing on it, not inside it.
+        Vector3 at = { sp.pos.x, sp.pos.y + 0.1f + 0.01f, sp.pos.z };
+        if(!SpawnCollides(probe, at, solids)) continue;
+        Vector3 safe = ResolveSafeSpawn(probe, at, solids);
+        bool stuck = SpawnCollides(probe, safe, solids);
+        snprintf(msg, sizeof(msg), "%s spawn at (%.2f, %.2f, %.2f) collides with geometry%s",
+                 sp.team == Team::ATTACK ? "ATTACK" : "DEFEND", sp.pos.x, sp.pos.y, sp.pos.z,
+                 stuck ? " and has no free spot nearby" : "; pawns will be nudged");
+        rep.Emit(0, stuck, msg);
+    }
+}
+
+// ─── Waypoint graph ──────────────────────────────────────────────────────────
+static void CheckWaypoints(Report& rep, const World& world, const MapData& md,
+                           const std::vector<MapSolid>& solids) {
+    const auto& wps = world.waypoints;
+    char msg[200];
+    if(wps.empty()) {
+        if(!md.isTestMap) rep.Emit(0, false, "no waypoints; bots will stand still");
+        return;
+    }
+
+    // Components by BFS, labelled in id order so component 0 holds waypoint 0
+    std::vector<int> comp(wps.size(), -1), queue;
+    int comps = 0;
+    for(size_t s = 0; s < wps.size(); s++) {
+        if(comp[s] >= 0) continue;
+        queue.assign(1, (int)s);
+        comp[s] = comps;
+        for(size_t q = 0; q < queue.size(); q++)
+            for(int n : wps[queue[q]].neighbours)
+                if(comp[n] < 0) { comp[n] = comps; queue.push_back(n); }
+        comps++;
+    }
+    for(int c = 1; c < comps; c++) {
+        std::string ids;
+        int count = 0;
+        for(size_t i = 0; i < wps.size(); i++) {
+            if(comp[i] != c) continue;
+            if(count < 8) ids += (count ? " " : "") + std::to_string(i);
+            count++;
+        }
+        if(count > 8) ids += " ...";
+        snprintf(msg, sizeof(msg), "%d waypoint%s unreachable from waypoint 0: %s",
+                 count, count == 1 ? "" : "s", ids.c_str());
+        rep.Emit(0, true, msg);
+    }
+
+    // Edges are stored both ways; check each once.
+    for(size_t a = 0; a < wps.size(); a++)
+        for(int b : wps[a].neighbours) {
+            if(b <= (int)a) continue;
+            Vector3 from = Vector3Add(wps[a].pos, { 0, EDGE_CHECK_HEIGHT, 0 });
+            Vector3 to   = Vector3Add(wps[b].pos, { 0, EDGE_CHECK_HEIGHT, 0 });
+            Vector3 d    = Vector3Subtract(to, from);
+            float   len  = Vector3Length(d);
+            if(len < 0.01f) continue;
+            HitResult hr = RaycastSolids(from, Vector3Scale(d, 1.0f / len), len, solids);
+            if(!hr.hit) continue;
+            snprintf(msg, sizeof(msg), "EDGE %d %d passes through a solid at (%.2f, %.2f, %.2f)",
+                     (int)a, b, hr.point.x, hr.point.y, hr.point.z);
+            rep.Emit(0, false, msg);
+        }
+}
+
+// ─── Solid budget and raycast cost ───────────────────────────────────────────
+static void CheckBudget(Report& rep, const World& world, const MapData& md,
+                        const std::vector<MapSolid>& solids) {
+    char msg[200];
+    int total = (int)solids.size();
+    if(md.sectors) {
+        snprintf(msg, sizeof(msg), "%d solids > MAX_SOLIDS (%d): streamed in %dx%d sectors, %d global",
+                 total, MAX_SOLIDS, md.sectors->nx, md.sectors->nz, (int)md.sectors->globals.size());
+        rep.Emit(0, false, msg);
+    }
+    printf("%s: solids %d / %d (%.0f%%)%s\n", rep.file.c_str(), total, MAX_SOLIDS,
+           100.0f * total / MAX_SOLIDS, md.sectors ? ", streamed" : "");
+
+    // RaycastSolids tests every resident box, so its cost depends on the
+    // resident count, not on where the boxes are; streamed maps hold at most
+    // MAX_SOLIDS at a time.
+    std::vector<MapSolid> resident(solids.begin(), solids.begin() + std::min(total, MAX_SOLIDS));
+    std::vector<std::pair<Vector3, Vector3>> lines;
+    const auto& wps = world.waypoints;
+    for(size_t a = 0; a < wps.size(); a++)
+        for(size_t b = a + 1; b < wps.size(); b++) {
+            Vector3 ea = Vector3Add(wps[a].pos, { 0, PLAYER_HEIGHT, 0 });
+            Vector3 eb = Vector3Add(wps[b].pos, { 0, PLAYER_HEIGHT * 0.6f, 0 });
+            if(Vector3Distance(ea, eb) <= BOT_VISION_RANGE) lines.push_back({ ea, eb });
+        }
+    if(lines.empty()) lines.push_back({ { 0, PLAYER_HEIGHT, 0 }, { BOT_VISION_RANGE, PLAYER_HEIGHT, 0 } });
+
+    int hits = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(int i = 0; i < COST_SAMPLE_RAYS; i++) {
+        const auto& l = lines[i % lines.size()];
+        Vector3 d   = Vector3Subtract(l.second, l.first);
+        float   len = std::max(Vector3Length(d), 0.01f);
+        hits += RaycastSolids(l.first, Vector3Scale(d, 1.0f / len), len, resident).hit;
+    }
+    double nsPerRay = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - t0).count() / COST_SAMPLE_RAYS;
+
+    // Each bot: one sight-line check per frame while engaged, plus a vision
+    // sweep over the enemy team BOT_RAYCAST_HZ times a second.
+    double raysPerFrame = BOTS_PER_MATCH * (1.0 + TEAM_SIZE * BOT_RAYCAST_HZ / TARGET_FPS);
+    double usPerFrame   = raysPerFrame * nsPerRay / 1000.0;
+    double budgetUs     = 1e6 / TARGET_FPS;
+    printf("%s: raycast %.0f ns/ray over %d solids, ~%.1f rays/frame -> %.1f us/frame "
+           "(%.2f%% of %d fps budget, %d%% sightlines blocked)\n",
+           rep.file.c_str(), nsPerRay, (int)resident.size(), raysPerFrame, usPerFrame,
+           100.0 * usPerFrame / budgetUs, TARGET_FPS, 100 * hits / COST_SAMPLE_RAYS);
+}
+
+static int CheckMap(const std::string& path, bool werror) {
+    Report rep;
+    rep.file = path;
+
+    World   world;
+    MapData md;
+    try {
+        md = LoadMap(path, world);
+    } catch(std::exception& e) {
+        printf("%s: error: %s\n", path.c_str(), e.what());
+        return 2;
+    }
+    for(const MapDiagnostic& d : md.diagnostics) rep.Emit(d.line, d.error, d.message);
+
+    std::vector<MapSolid> solids = AllSolids(world, md);
+    OptimizeSolids(solids, nullptr);   // what the game collides against
+
+    CheckSpawns(rep, md, solids);
+    CheckWaypoints(rep, world, md, solids);
+    CheckBudget(rep, world, md, solids);
+
+    printf("%s: %d error%s, %d warning%s\n", path.c_str(),
+           rep.errors, rep.errors == 1 ? "" : "s", rep.warnings, rep.warnings == 1 ? "" : "s");
+    return (rep.errors || (werror && rep.warnings)) ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    SetTraceLogLevel(LOG_NONE);   // diagnostics are printed by the report
+
+    bool werror = false;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; i++) {
+        if(!strcmp(argv[i], "--werror")) werror = true;
+        else                             files.push_back(argv[i]);
+    }
+    if(files.empty()) {
+        fprintf(stderr, "usage: %s [--werror] file.map [file.map ...]\n", argv[0]);
+        return 2;
+    }
+
+    int status = 0;
+    for(const std::string& f : files) status = std::max(status, CheckMap(f, werror));
+    return status;
+}
@@ -0,0 +1,142 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  matchserver  –  Headless host for many concurrent bot matches
+//
+//  Loads one map the way MapLoadJob does, then keeps --matches matches of
+//  bots running on a MatchHost with --workers threads, starting a new one
+//  whenever one ends.  Once a second it prints the tick rate achieved
+//  against the rate asked for, late and dropped ticks, how much work was
+//  stolen, and how busy each worker was.  With --viewers N the first N
+//  pawns of each match also get snapshots built as if a client watched
+//  through them, and the bytes per client per second are printed.
+//  Never opens a window.
+//
+//  Usage: matchserver [--matches N] [--workers N] [--tick-hz N]
+//                     [--viewers N] [--seconds S] [--seed N] file.map
+//  --seconds 0 runs until interrupted.  Exit status: 0 no ticks dropped,
+//  1 ticks dropped, 2 usage / unreadable or streamed map.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "Tuning.h"
+#include "World.h"
+#include "game/MapLoader.h"
+#include "game/MapOptimizer.h"
+#include "game/Physics.h"
+#include "server/MatchHost.h"
+#include <raylib.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::atomic<bool> g_interrupted{ false };
+
+int main(int argc, char** argv) {
+    SetTraceLogLevel(LOG_WARNING);
+
+    int matches = 50, workers = (int)std::thread::hardware_concurrency(), tickHz = SIM_TICK_HZ;
+    int viewers = 0;
+    double seconds = 30.0;
+    uint64_t seed = 1;
+    const char* path = nullptr;
+    for(int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if     (!strcmp(argv[i], "--matches") && more) matches = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--workers") && more) workers = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--tick-hz") && more) tickHz  = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--viewers") && more) viewers = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--seconds") && more) seconds = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--seed")    && more) seed    = strtoull(argv[++i], nullptr, 10);
+        else if(argv[i][0] != '-')                     path    = argv[i];
+        else { path = nullptr; break; }
+    }
+    if(!path || matches < 1) {
+        fprintf(stderr, "usage: %s [--matches N] [--workers N] [--tick-hz N] [--viewers N] [--seconds S] "
+                        "[--seed N] file.map\n", argv[0]);
+        return 2;
+    }
+    workers = std::max(1, workers);
+    tickHz  = std::clamp(tickHz, MATCH_MIN_TICK_HZ, MATCH_MAX_TICK_HZ);
+
+    LoadTuning(TUNING_FILE);   // once, before any worker reads it
+
+    World   map;
+    MapData md;
+    try {
+        md = LoadMap(path, map);
+    } catch(std::exception& e) {
+        fprintf(stderr, "%s: error: %s\n", path, e.what());
+        return 2;
+    }
+    if(md.sectors) {
+        fprintf(stderr, "%s: error: streamed maps (over %d solids) are not hosted\n", path, MAX_SOLIDS);
+        return 2;
+    }
+    OptimizeSolids(map.solids, path);
+    BuildMapAccel(map);
+
+    signal(SIGINT,  [](int) { g_interrupted.store(true); });
+    signal(SIGTERM, [](int) { g_interrupted.store(true); });
+
+    MatchHost host;
+    host.Start(workers);
+    MatchConfig cfg;
+    cfg.tickHz = tickHz;
+    cfg.snapshotSeats = (uint8_t)((1u << std::clamp(viewers, 0, MAX_PAWNS)) - 1);
+    for(int i = 0; i < matches; i++) {
+        cfg.seed = seed++;
+        host.Add(map, md, cfg);
+    }
+    printf("matchserver: %s, %d matches at %d Hz on %d workers\n", path, matches, tickHz, workers);
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now(), last = start;
+    std::vector<MatchSummary> finished;
+    uint64_t totalDropped = 0, totalFinished = 0;
+    while(!g_interrupted.load()) {
+        std::this_thread::sleep_until(last + std::chrono::seconds(1));
+        Clock::time_point now = Clock::now();
+        double interval = std::chrono::duration<double>(now - last).count();
+        last = now;
+
+        finished.clear();
+        host.TakeFinished(finished);
+        for(const MatchSummary& s : finished) {
+            printf("  match %d over: %d-%d after %d rounds, %u ticks\n",
+                   s.id, s.scoreAttack, s.scoreDefend, s.rounds, s.ticks);
+            cfg.seed = seed++;
+            host.Add(map, md, cfg);   // keep the count up
+        }
+        totalFinished += finished.size();
+
+        MatchHostStats st = host.TakeStats();
+        totalDropped += st.dropped;
+        double want = (double)host.Active() * tickHz;
+        double busy = 0.0;
+        char perWorker[256] = "";
+        int  n = 0;
+        for(double b : st.busySec) {
+            busy += b;
+            if(n < (int)sizeof(perWorker))
+                n += snprintf(perWorker + n, sizeof(perWorker) - n, " %.0f", b / interval * 100.0);
+        }
+        printf("%d matches, %.0f ticks/s of %.0f, late %.2f%%, dropped %llu, stolen %.1f%%, "
+               "busy %.0f%% [%s ]\n",
+               host.Active(), st.ticks / interval, want,
+               st.ticks ? st.late * 100.0 / st.ticks : 0.0, (unsigned long long)st.dropped,
+               st.ticks ? st.stolen * 100.0 / st.ticks : 0.0,
+               busy / (interval * st.busySec.size()) * 100.0, perWorker);
+        if(st.snapshotClientSec > 0.0)
+            printf("  snapshots %.0f B/client/s, largest %u B\n", st.BytesPerClientSec(), st.snapshotLargest);
+        fflush(stdout);
+
+        if(seconds > 0.0 && std::chrono::duration<double>(now - start).count() >= seconds) break;
+    }
+    host.Stop();
+    printf("matchserver: %llu matches finished, %llu ticks dropped\n",
+           (unsigned long long)totalFinished, (unsigned long long)totalDropped);
+    return totalDropped ? 1 : 0;
+}
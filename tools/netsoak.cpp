@@ -0,0 +1,273 @@
+// ─────────────────────────────────────────────────────────────────────────────
+//  netsoak  –  NetChannel over a simulated bad link, checked end to end
+//
+//  Runs one bot match at SIM_TICK_HZ in simulated time, so a minute of
+//  play takes well under a second.  A server NetChannel sends seat 0 its
+//  snapshot every tick (unreliable) plus the hello and every
+//  MatchEventWatcher event (reliable), and with --blob a payload of that
+//  many bytes every 5 s so fragmentation is exercised.  --burst N queues
+//  N blobs back to back instead, so a lost piece of the first holds up
+//  more than a window of pieces behind it.  A client channel
+//  answers every tick with a 16-byte PlayerCommand.  Both directions go
+//  through a LinkSimulator; with --udp each datagram the simulator
+//  releases also crosses a real loopback UdpSocket pair.
+//
+//  The client checks that every reliable message arrives byte-identical
+//  and in send order, and reports reliable latency next to the longest
+//  gap between snapshots, which a lost reliable piece must not widen.
+//
+//  Usage: netsoak [--loss PCT] [--latency MS] [--jitter MS] [--duplicate PCT]
+//                 [--seconds S] [--blob BYTES] [--burst N] [--seed N] [--udp]
+//                 file.map
+//  Exit status: 0 everything arrived in order, 1 a reliable message was
+//  lost, reordered or corrupted, 2 usage / unreadable map / no socket.
+// ─────────────────────────────────────────────────────────────────────────────
+#include "Tuning.h"
+#include "World.h"
+#include "game/MapLoader.h"
+#include "game/MapOptimizer.h"
+#include "game/Physics.h"
+#include "game/PlayerCommand.h"
+#include "game/RoundManager.h"
+#include "net/LinkSimulator.h"
+#include "net/MatchEvents.h"
+#include "net/NetChannel.h"
+#include "net/UdpSocket.h"
+#include "server/Relevancy.h"
+#include "server/Snapshot.h"
+#include <raylib.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+constexpr double SOAK_DRAIN_SEC = 5.0;   // after the match, for the last resends
+constexpr double SOAK_BLOB_SEC  = 5.0;
+
+enum class SoakMessage { HELLO, EVENT, BLOB };
+
+struct SentMessage {
+    std::vector<uint8_t> bytes;
+    double               queued = 0.0;
+    SoakMessage          kind   = SoakMessage::EVENT;
+};
+
+static float Percentile(std::vector<float> v, float p) {
+    if(v.empty()) return 0.0f;
+    size_t k = std::min(v.size() - 1, (size_t)(p * (v.size() - 1) + 0.5f));
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+static void PrintLink(const char* name, const LinkStats& s) {
+    printf("  link %s: %llu sent, %llu dropped, %llu duplicated, %llu reordered\n", name,
+           (unsigned long long)s.sent, (unsigned long long)s.dropped,
+           (unsigned long long)s.duplicated, (unsigned long long)s.reordered);
+}
+
+int main(int argc, char** argv) {
+    SetTraceLogLevel(LOG_WARNING);
+
+    LinkConfig link;
+    double     seconds = 60.0;
+    int        blob    = 6000;
+    int        burst   = 1;
+    uint64_t   seed    = 1;
+    bool       udp     = false;
+    const char* path   = nullptr;
+    for(int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if     (!strcmp(argv[i], "--loss")      && more) link.lossPct      = (float)atof(argv[++i]);
+        else if(!strcmp(argv[i], "--latency")   && more) link.latencyMs    = (float)atof(argv[++i]);
+        else if(!strcmp(argv[i], "--jitter")    && more) link.jitterMs     = (float)atof(argv[++i]);
+        else if(!strcmp(argv[i], "--duplicate") && more) link.duplicatePct = (float)atof(argv[++i]);
+        else if(!strcmp(argv[i], "--seconds")   && more) seconds = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--blob")      && more) blob    = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--burst")     && more) burst   = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "--seed")      && more) seed    = strtoull(argv[++i], nullptr, 10);
+        else if(!strcmp(argv[i], "--udp"))               udp     = true;
+        else if(argv[i][0] != '-')                       path    = argv[i];
+        else { path = nullptr; break; }
+    }
+    if(!path || seconds <= 0.0 || blob < 0 || blob > NET_MAX_MESSAGE || burst < 1) {
+        fprintf(stderr, "usage: %s [--loss PCT] [--latency MS] [--jitter MS] [--duplicate PCT] "
+                        "[--seconds S] [--blob BYTES (max %d)] [--burst N] [--seed N] [--udp] file.map\n",
+                argv[0], NET_MAX_MESSAGE);
+        return 2;
+    }
+
+    LoadTuning(TUNING_FILE);
+    World   world;
+    MapData md;
+    try {
+        md = LoadMap(path, world);
+    } catch(std::exception& e) {
+        fprintf(stderr, "%s: error: %s\n", path, e.what());
+        return 2;
+    }
+    if(md.sectors) {
+        fprintf(stderr, "%s: error: streamed maps (over %d solids) are not hosted\n", path, MAX_SOLIDS);
+        return 2;
+    }
+    OptimizeSolids(world.solids, path);
+    BuildMapAccel(world);
+    world.humanSeats = 0;
+    world.maxTracers = world.maxImpacts = 0;
+    world.rng.Seed(seed);
+    ResetRound(world, md);
+
+    UdpSocket  serverSock, clientSock;
+    UdpAddress serverAddr, clientAddr;
+    if(udp) {
+        if(!serverSock.Open(0, true) || !clientSock.Open(0, true)) {
+            fprintf(stderr, "netsoak: cannot open loopback UDP sockets\n");
+            return 2;
+        }
+        serverAddr = UdpAddress::Loopback(serverSock.Port());
+        clientAddr = UdpAddress::Loopback(clientSock.Port());
+    }
+
+    // NetChannel holds its windows inline: keep the pair off the stack
+    static NetChannel server, client;
+    LinkSimulator down(link, seed * 2 + 1), up(link, seed * 2 + 2);
+    MatchEventWatcher watcher;
+    watcher.Reset(world);
+    ClientInterest interest;
+    interest.Reset(0, world);
+    SimRandom blobRng;
+    blobRng.Seed(seed);
+
+    std::vector<SentMessage> sent;          // every reliable message, in queue order
+    std::deque<size_t>       waiting;       // indices refused by a full window
+    size_t                   delivered = 0, mismatched = 0;
+    std::vector<float>       eventMs, blobMs, snapshotAgeMs;
+    uint64_t snapshotsSent = 0, snapshotsRead = 0, commandsRead = 0;
+    uint32_t lastSnapTick = 0;
+    double   lastSnapTime = 0.0, longestGap = 0.0, nextBlob = SOAK_BLOB_SEC;
+    static uint8_t snapBytes[SNAPSHOT_MAX_BYTES], message[NET_MAX_MESSAGE];
+    static Snapshot snap;
+
+    auto queue = [&](const uint8_t* data, int size, double now, SoakMessage kind) {
+        sent.push_back({ std::vector<uint8_t>(data, data + size), now, kind });
+        waiting.push_back(sent.size() - 1);
+    };
+    {
+        int n = WriteHello(message, SIM_TICK_HZ, world, path);
+        queue(message, n, 0.0, SoakMessage::HELLO);
+    }
+
+    // Datagrams the simulator lets through, optionally via the real sockets
+    uint8_t packet[NET_MTU];
+    auto carry = [&](LinkSimulator& l, UdpSocket& from, UdpSocket& to, const UdpAddress& toAddr,
+                     double now, auto&& receive) {
+        while(int n = l.Receive(now, packet)) {
+            if(!udp) { receive(packet, n); continue; }
+            from.Send(toAddr, packet, n);
+            UdpAddress src;
+            while(int m = to.Receive(packet, NET_MTU, src)) receive(packet, m);
+        }
+    };
+
+    const uint32_t matchTicks = (uint32_t)(seconds * SIM_TICK_HZ);
+    const uint32_t endTick    = matchTicks + (uint32_t)(SOAK_DRAIN_SEC * SIM_TICK_HZ);
+    uint32_t tick = 0;
+    for(; tick < endTick; tick++) {
+        double now     = (double)tick / SIM_TICK_HZ;
+        bool   playing = tick < matchTicks && world.roundState != RoundState::MATCH_OVER;
+
+        // ── Server ──
+        int snapSize = 0;
+        if(playing) {
+            StepWorld(world, md, tick, SIM_DT);
+            watcher.Poll(world, tick, [&](const uint8_t* d, int n) { queue(d, n, now, SoakMessage::EVENT); });
+            if(blob > 0 && now >= nextBlob) {
+                nextBlob += SOAK_BLOB_SEC;
+                for(int b = 0; b < burst; b++) {
+                    for(int i = 0; i < blob; i++) message[i] = (uint8_t)blobRng.Below(256);
+                    queue(message, blob, now, SoakMessage::BLOB);
+                }
+            }
+            UpdateInterest(interest, 0, world, SIM_DT);
+            snapSize = WriteSnapshot(world, tick, 0, interest, snapBytes);
+            snapshotsSent++;
+        }
+        while(!waiting.empty()) {
+            const SentMessage& m = sent[waiting.front()];
+            if(!server.SendReliable(m.bytes.data(), (int)m.bytes.size())) break;
+            waiting.pop_front();
+        }
+        server.Flush(now, snapSize ? snapBytes : nullptr, snapSize,
+                     [&](const uint8_t* d, int n) { down.Send(now, d, n); });
+
+        // ── Client ──
+        carry(down, serverSock, clientSock, clientAddr, now, [&](const uint8_t* d, int n) {
+            client.Receive(now, d, n, [&](const uint8_t* s, int len) {
+                if(!ReadSnapshot(s, len, snap) || (snapshotsRead && snap.tick <= lastSnapTick)) return;
+                if(snapshotsRead) longestGap = std::max(longestGap, now - lastSnapTime);
+                snapshotAgeMs.push_back((float)((now - (double)snap.tick / SIM_TICK_HZ) * 1000.0));
+                lastSnapTick = snap.tick;
+                lastSnapTime = now;
+                snapshotsRead++;
+            });
+        });
+        for(int n; (n = client.PopReliable(message)) >= 0; delivered++) {
+            bool same = delivered < sent.size() && (size_t)n == sent[delivered].bytes.size() &&
+                        !memcmp(message, sent[delivered].bytes.data(), n);
+            if(!same) {
+                mismatched++;
+                continue;
+            }
+            float ms = (float)((now - sent[delivered].queued) * 1000.0);
+            (sent[delivered].kind == SoakMessage::BLOB ? blobMs : eventMs).push_back(ms);
+            MatchHello h;
+            MatchEvent e;
+            if(sent[delivered].kind == SoakMessage::HELLO)
+                mismatched += !ReadHello(message, n, h) || h.mapHash != MapHash(world);
+            else if(sent[delivered].kind == SoakMessage::EVENT)
+                mismatched += !ReadMatchEvent(message, n, e);
+        }
+        PlayerCommand cmd{};
+        cmd.tick = tick;
+        client.Flush(now, (const uint8_t*)&cmd, (int)sizeof(cmd),
+                     [&](const uint8_t* d, int n) { up.Send(now, d, n); });
+
+        // ── Server hears the client ──
+        carry(up, clientSock, serverSock, serverAddr, now, [&](const uint8_t* d, int n) {
+            server.Receive(now, d, n, [&](const uint8_t*, int) { commandsRead++; });
+        });
+
+        if(!playing && waiting.empty() && server.PendingReliable() == 0 && delivered == sent.size()) break;
+    }
+
+    const NetChannelStats& ss = server.Stats();
+    const NetChannelStats& cs = client.Stats();
+    double playSec = std::min((double)tick, (double)matchTicks) / SIM_TICK_HZ;
+    printf("netsoak: %s, loss %.1f%%, latency %.0f ms, jitter %.0f ms, duplicate %.1f%%%s\n", path,
+           link.lossPct, link.latencyMs, link.jitterMs, link.duplicatePct, udp ? ", over UDP" : "");
+    printf("  match: %.1f s, round %d, score %d-%d\n", playSec, world.roundNumber,
+           world.scoreAttack, world.scoreDefend);
+    PrintLink("down", down.Stats());
+    PrintLink("up", up.Stats());
+    printf("  reliable: %zu queued, %zu delivered in order, %zu wrong; %llu pieces, %llu resent\n",
+           sent.size(), delivered, mismatched,
+           (unsigned long long)ss.piecesSent, (unsigned long long)ss.piecesResent);
+    printf("  event latency: median %.0f ms, p95 %.0f ms, max %.0f ms (%zu)\n", Percentile(eventMs, 0.5f),
+           Percentile(eventMs, 0.95f), Percentile(eventMs, 1.0f), eventMs.size());
+    if(!blobMs.empty())
+        printf("  %d-byte blob latency: median %.0f ms, max %.0f ms (%zu)\n", blob, Percentile(blobMs, 0.5f),
+               Percentile(blobMs, 1.0f), blobMs.size());
+    printf("  snapshots: %llu of %llu fresh (%.1f%%; lost or overtaken are skipped), age median %.0f ms, p95 %.0f ms, longest gap %.0f ms\n",
+           (unsigned long long)snapshotsRead, (unsigned long long)snapshotsSent,
+           snapshotsSent ? snapshotsRead * 100.0 / snapshotsSent : 0.0,
+           Percentile(snapshotAgeMs, 0.5f), Percentile(snapshotAgeMs, 0.95f), longestGap * 1000.0);
+    printf("  commands: %llu read; rtt server %.0f ms, client %.0f ms\n", (unsigned long long)commandsRead,
+           server.RttMs(), client.RttMs());
+    printf("  bandwidth: down %.0f B/s, up %.0f B/s; bad packets %llu\n", ss.bytesSent / playSec,
+           cs.bytesSent / playSec, (unsigned long long)(ss.badPackets + cs.badPackets));
+
+    bool ok = mismatched == 0 && delivered == sent.size();
+    if(!ok) printf("netsoak: FAILED\n");
+    return ok ? 0 : 1;
+}